@@ -178,7 +178,7 @@ main(int argc, char * argv[])
   //  matrix. The values defining this range can be set by invoking the methods
   //  \code{SetChemoAttractantHighThreshold} and
   //  \code{SetChemoAttractantLowThreshold). These to methods are static and
-  //  set the values to be used by all the cells.
+  //  set the values to be used by all the cells created by the calling thread.
   //
   //  \index{itk::bio::Cell!SetChemoAttractantLowThreshold}
   //  \index{itk::bio::Cell!SetChemoAttractantHighThreshold}
@@ -208,13 +208,13 @@ main(int argc, char * argv[])
   //  Software Guide : BeginLatex
   //
   //  The CellularAggregate will update the life cycle of all the cells in an
-  //  iterative way.  The User must select how many iterations to run.
-  //  CellularAlgorithms can in principle run forever. It is up to the User to
-  //  define an stopping criterion. One of the simplest options is to set a
-  //  limit to the number of iterations, by invoking the AdvanceTimeStep()
-  //  method inside a for loop.
+  //  iterative way.  CellularAlgorithms can in principle run forever. It is up
+  //  to the User to define the stopping criteria passed to the Run() method.
+  //  Here the simulation stops after a maximum number of iterations, or as
+  //  soon as the number of cells has not changed for 100 iterations, which
+  //  happens when the colony has filled the structure.
   //
-  //  \index{itk::bio::CellularAggregate!SetEgg}
+  //  \index{itk::bio::CellularAggregate!Run}
   //
   //  Software Guide : EndLatex
 
@@ -223,12 +223,19 @@ main(int argc, char * argv[])
 
   std::cout << "numberOfIterations " << numberOfIterations << std::endl;
 
-  for (unsigned int i = 0; i < numberOfIterations; i++)
-  {
-    cellularAggregate->AdvanceTimeStep();
-  }
+  // The cells that have stopped growing outside of the structure are
+  // skipped until a growing cell comes next to them.
+  cellularAggregate->UseActiveSetOn();
+
+  CellularAggregateType::StoppingCriteria stoppingCriteria;
+  stoppingCriteria.m_MaximumNumberOfIterations = numberOfIterations;
+
+  cellularAggregate->Run(stoppingCriteria);
   // Software Guide : EndCodeSnippet
 
+  std::cout << "Stopped after " << cellularAggregate->GetIteration() << " iterations: ";
+  std::cout << cellularAggregate->GetStopConditionDescription() << std::endl;
+
 
   std::cout << " Final number of Cells = " << cellularAggregate->GetNumberOfCells() << std::endl;
 
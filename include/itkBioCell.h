@@ -33,19 +33,27 @@ namespace bio
  * The basic behavior of a cell is related to the
  * cell cycle. Geometrical concepts like size and shape
  * are also managed by this abstract cell.
+ *
+ * The forces applied to the cell have coordinates of type TCoordinate,
+ * the type of the coordinates of the aggregate that holds it.
  * \ingroup ITKBioCell
  */
 
-template <unsigned int NSpaceDimension = 3>
+template <unsigned int NSpaceDimension = 3, typename TCoordinate = double>
 class ITK_TEMPLATE_EXPORT Cell : public CellBase
 {
 public:
   using Superclass = CellBase;
 
-  using VectorType = itk::Vector<double, NSpaceDimension>;
-  using PointType = itk::Point<double, NSpaceDimension>;
+  /** Type of the coordinates of the positions and of the forces. */
+  using CoordinateType = TCoordinate;
+
+  using VectorType = itk::Vector<TCoordinate, NSpaceDimension>;
+  using PointType = itk::Point<TCoordinate, NSpaceDimension>;
 
   friend class CellularAggregateBase; // need to give access to the constructor.
+  friend class CellularAggregate<NSpaceDimension, TCoordinate>;
+  friend class CompactCellularAggregate<NSpaceDimension, TCoordinate>;
 
 public:
   ~Cell() override;
@@ -91,6 +99,12 @@ public:
   static Cell *
   CreateEgg();
 
+  /** Create a cell of the first generation that keeps the identifier
+   *  given by the constructor, so that many of them can seed the same
+   *  aggregate. */
+  static Cell *
+  CreateSeed();
+
   static unsigned int
   GetDimension()
   {
@@ -100,7 +114,30 @@ public:
 protected:
   Cell(); // Users should create a cell with the CreateEgg() method
 
+  /** Create a daughter of the same type as this cell. Called twice by
+   *  Mitosis(). */
+  virtual Cell *
+  CreateDaughter() const;
+
+  /** Prepare a cell without parent to start a colony: draw its latencies
+   *  and create its genome. */
+  void
+  StartColony();
+
+  /** Execute one step of the cell cycle: read the environment, update the
+   *  state of the cycle and execute its action. The hooks are called on
+   *  \a hooks, which is the cell itself in AdvanceTimeStep(), so that the
+   *  calls are virtual, and an object calling the hooks of a species
+   *  without virtual calls in SpeciesCell. */
+  template <typename THooks>
+  void
+  RunCellCycle(THooks & hooks);
+
 public:
+  /** Force accumulated on the cell during the last time step of a
+   *  CellularAggregate. The cells of a CompactCellularAggregate do not
+   *  hold their force, which stays null: read it from
+   *  CompactCellularAggregate::GetCellMechanics() instead. */
   virtual const VectorType &
   GetForce() const;
 
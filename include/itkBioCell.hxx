@@ -30,8 +30,8 @@ namespace bio
 /**
  *    Constructor Lonely Cell
  */
-template <unsigned int NSpaceDimension>
-Cell<NSpaceDimension>::Cell()
+template <unsigned int NSpaceDimension, typename TCoordinate>
+Cell<NSpaceDimension, TCoordinate>::Cell()
 
 {
   m_Force.Fill(0.0f);
@@ -42,8 +42,8 @@ Cell<NSpaceDimension>::Cell()
 /**
  *    Destructor
  */
-template <unsigned int NSpaceDimension>
-Cell<NSpaceDimension>::~Cell()
+template <unsigned int NSpaceDimension, typename TCoordinate>
+Cell<NSpaceDimension, TCoordinate>::~Cell()
 {
   // Genomes are released in the destructor of the superclass.
 }
@@ -52,13 +52,13 @@ Cell<NSpaceDimension>::~Cell()
  *    Cell Division
  */
 
-template <unsigned int NSpaceDimension>
+template <unsigned int NSpaceDimension, typename TCoordinate>
 void
-Cell<NSpaceDimension>::Mitosis()
+Cell<NSpaceDimension, TCoordinate>::Mitosis()
 {
   // Create the two daughters.
-  auto * siblingA = new Cell;
-  auto * siblingB = new Cell;
+  Cell * siblingA = this->CreateDaughter();
+  Cell * siblingB = this->CreateDaughter();
 
   // Broad compensation for Volume distribution among daugthers.
   // The type of root should depend on the Dimension...
@@ -86,9 +86,28 @@ Cell<NSpaceDimension>::Mitosis()
   m_Genome = nullptr;
   m_GenomeCopy = nullptr;
 
-  // Register both daughter cells with the CellularAggregate.
   CellularAggregateBase * aggregate = this->GetCellularAggregate();
-  aggregate->Add(siblingA, siblingB, perturbationLength);
+
+  // Draw the latencies from the generator of the aggregate, so that
+  // the sequence of divisions can be reproduced from a checkpoint.
+  const auto growthLatency = static_cast<double>(m_Parameters->m_GrowthMaximumLatencyTime);
+  const auto divisionLatency = static_cast<double>(m_Parameters->m_DivisionMaximumLatencyTime);
+  siblingA->m_GrowthLatencyTime = static_cast<SizeValueType>(aggregate->GetUniformVariate(0, growthLatency));
+  siblingA->m_DivisionLatencyTime = static_cast<SizeValueType>(aggregate->GetUniformVariate(0, divisionLatency));
+  siblingB->m_GrowthLatencyTime = static_cast<SizeValueType>(aggregate->GetUniformVariate(0, growthLatency));
+  siblingB->m_DivisionLatencyTime = static_cast<SizeValueType>(aggregate->GetUniformVariate(0, divisionLatency));
+
+  // Register both daughter cells with the CellularAggregate.
+  if (aggregate->GetUseInPlaceMitosis())
+  {
+    // The first daughter takes over the slot of this cell in the aggregate.
+    siblingA->m_SelfIdentifier = m_SelfIdentifier;
+    aggregate->Divide(this, siblingA, siblingB, perturbationLength);
+  }
+  else
+  {
+    aggregate->Add(siblingA, siblingB, perturbationLength);
+  }
 
   // Mark this cell for being removed from the Aggregate and deleted.
   this->MarkForRemoval();
@@ -100,30 +119,66 @@ Cell<NSpaceDimension>::Mitosis()
  *    intended to be overloaded in any class
  *    deriving from Cell.
  */
-template <unsigned int NSpaceDimension>
-Cell<NSpaceDimension> *
-Cell<NSpaceDimension>::CreateEgg()
+template <unsigned int NSpaceDimension, typename TCoordinate>
+Cell<NSpaceDimension, TCoordinate> *
+Cell<NSpaceDimension, TCoordinate>::CreateEgg()
 {
   auto * cell = new Cell;
 
-  cell->m_ParentIdentifier = 0;
   cell->m_SelfIdentifier = 1;
-  cell->m_Generation = 0;
+  cell->StartColony();
+
+  return cell;
+}
 
-  cell->m_Genome = new GenomeType;
+/**
+ *    Create a New Seed Cell
+ */
+template <unsigned int NSpaceDimension, typename TCoordinate>
+Cell<NSpaceDimension, TCoordinate> *
+Cell<NSpaceDimension, TCoordinate>::CreateSeed()
+{
+  auto * cell = new Cell;
 
-  cell->ComputeGeneNetwork();
-  cell->SecreteProducts();
+  cell->StartColony();
 
   return cell;
 }
 
+/**
+ *    Create a daughter cell for Mitosis
+ */
+template <unsigned int NSpaceDimension, typename TCoordinate>
+Cell<NSpaceDimension, TCoordinate> *
+Cell<NSpaceDimension, TCoordinate>::CreateDaughter() const
+{
+  return new Cell;
+}
+
+/**
+ *    Prepare a cell without parent
+ */
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+Cell<NSpaceDimension, TCoordinate>::StartColony()
+{
+  m_ParentIdentifier = 0;
+  m_Generation = 0;
+
+  this->DrawLatencyTimes();
+
+  m_Genome = new GenomeType;
+
+  this->ComputeGeneNetwork();
+  this->SecreteProducts();
+}
+
 /**
  *    Clear the cumulator for applied forces
  */
-template <unsigned int NSpaceDimension>
+template <unsigned int NSpaceDimension, typename TCoordinate>
 void
-Cell<NSpaceDimension>::ClearForce()
+Cell<NSpaceDimension, TCoordinate>::ClearForce()
 {
   m_Force.Fill(0.0f);
   m_Pressure = 0.0f;
@@ -132,9 +187,9 @@ Cell<NSpaceDimension>::ClearForce()
 /**
  *    Return the cumulated force
  */
-template <unsigned int NSpaceDimension>
-const typename Cell<NSpaceDimension>::VectorType &
-Cell<NSpaceDimension>::GetForce() const
+template <unsigned int NSpaceDimension, typename TCoordinate>
+const typename Cell<NSpaceDimension, TCoordinate>::VectorType &
+Cell<NSpaceDimension, TCoordinate>::GetForce() const
 {
   return m_Force;
 }
@@ -142,9 +197,9 @@ Cell<NSpaceDimension>::GetForce() const
 /**
  *    Return a pointer to the Cellular Aggregate
  */
-template <unsigned int NSpaceDimension>
+template <unsigned int NSpaceDimension, typename TCoordinate>
 CellularAggregateBase *
-Cell<NSpaceDimension>::GetCellularAggregate()
+Cell<NSpaceDimension, TCoordinate>::GetCellularAggregate()
 {
   return m_Aggregate;
 }
@@ -152,9 +207,9 @@ Cell<NSpaceDimension>::GetCellularAggregate()
 /**
  *    Return a const pointer to the Cellular Aggregate
  */
-template <unsigned int NSpaceDimension>
+template <unsigned int NSpaceDimension, typename TCoordinate>
 const CellularAggregateBase *
-Cell<NSpaceDimension>::GetCellularAggregate() const
+Cell<NSpaceDimension, TCoordinate>::GetCellularAggregate() const
 {
   return m_Aggregate;
 }
@@ -162,9 +217,9 @@ Cell<NSpaceDimension>::GetCellularAggregate() const
 /**
  *   Set Cellular Aggregate
  */
-template <unsigned int NSpaceDimension>
+template <unsigned int NSpaceDimension, typename TCoordinate>
 void
-Cell<NSpaceDimension>::SetCellularAggregate(CellularAggregateBase * cells)
+Cell<NSpaceDimension, TCoordinate>::SetCellularAggregate(CellularAggregateBase * cells)
 {
   m_Aggregate = cells;
 }
@@ -172,11 +227,11 @@ Cell<NSpaceDimension>::SetCellularAggregate(CellularAggregateBase * cells)
 /**
  *    Add a force to the cumulator
  */
-template <unsigned int NSpaceDimension>
+template <unsigned int NSpaceDimension, typename TCoordinate>
 void
-Cell<NSpaceDimension>::AddForce(const VectorType & force)
+Cell<NSpaceDimension, TCoordinate>::AddForce(const VectorType & force)
 {
-  if (m_ChemoAttractantLevel > ChemoAttractantLowThreshold && m_ChemoAttractantLevel < ChemoAttractantHighThreshold)
+  if (!this->IgnoresForces())
   {
     double factor = 1.0 / std::pow(m_Radius, (double)(NSpaceDimension));
     m_Force += force;
@@ -192,9 +247,9 @@ Cell<NSpaceDimension>::AddForce(const VectorType & force)
  *    Programmed Cell Death
  *    This is the cellular equivalent of suicide.
  */
-template <unsigned int NSpaceDimension>
+template <unsigned int NSpaceDimension, typename TCoordinate>
 void
-Cell<NSpaceDimension>::Apoptosis()
+Cell<NSpaceDimension, TCoordinate>::Apoptosis()
 {
   // This call will release the Genomes
   this->Superclass::Apoptosis();
@@ -215,26 +270,38 @@ Cell<NSpaceDimension>::Apoptosis()
  *    The position will be updated according to
  *    applied forces
  */
-template <unsigned int NSpaceDimension>
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+Cell<NSpaceDimension, TCoordinate>::AdvanceTimeStep()
+{
+  this->RunCellCycle(*this);
+}
+
+/**
+ *    Execute one step of the cell cycle, calling the hooks on the given
+ *    object: the cell itself, or the hooks of a species.
+ */
+template <unsigned int NSpaceDimension, typename TCoordinate>
+template <typename THooks>
 void
-Cell<NSpaceDimension>::AdvanceTimeStep()
+Cell<NSpaceDimension, TCoordinate>::RunCellCycle(THooks & hooks)
 {
   // get input from the environment
-  this->ReceptorsReading();
+  hooks.ReceptorsReading();
 
   // update the level of expression of all the
   // genes in the gene network
-  this->ComputeGeneNetwork();
+  hooks.ComputeGeneNetwork();
 
   // this method produces the effects of gene
   // activation and protein synthesis. It is
   // mostly used for secreting proteins already
   // synthetized in the ComputeGeneNetwork method.
-  this->SecreteProducts();
+  hooks.SecreteProducts();
 
   // If this happens, it is an
   // emergency situation: Do it first.
-  if (this->CheckPointApoptosis())
+  if (hooks.CheckPointApoptosis())
   {
     m_CycleState = Apop;
   }
@@ -247,7 +314,7 @@ Cell<NSpaceDimension>::AdvanceTimeStep()
     case Gap1:
     {
       // Gap 1 : growing
-      if (this->CheckPointDNAReplication())
+      if (hooks.CheckPointDNAReplication())
       {
         m_CycleState = S;
       }
@@ -257,7 +324,7 @@ Cell<NSpaceDimension>::AdvanceTimeStep()
       m_CycleState = Gap2;
       break;
     case Gap2:
-      if (this->CheckPointMitosis())
+      if (hooks.CheckPointMitosis())
       {
         m_CycleState = M;
       }
@@ -278,25 +345,25 @@ Cell<NSpaceDimension>::AdvanceTimeStep()
       // This is a terminal action. The implementation of the cell
       // is destroyed after division. Our abstraction assumes that
       // the cell disapears and two new cell are created.
-      this->Mitosis();
+      hooks.Mitosis();
       break;
     case Gap1:
       // Eat and grow
-      this->NutrientsIntake();
-      this->EnergyIntake();
-      this->Grow();
+      hooks.NutrientsIntake();
+      hooks.EnergyIntake();
+      hooks.Grow();
       break;
     case Gap0:
-      this->NutrientsIntake();
-      this->EnergyIntake();
+      hooks.NutrientsIntake();
+      hooks.EnergyIntake();
       break;
     case S:
-      this->DNAReplication();
+      hooks.DNAReplication();
       break;
     case Gap2:
       break;
     case Apop:
-      this->Apoptosis();
+      hooks.Apoptosis();
       break;
   }
 }
@@ -304,15 +371,15 @@ Cell<NSpaceDimension>::AdvanceTimeStep()
 /**
  *    Reading substrate using receptors
  */
-template <unsigned int NSpaceDimension>
+template <unsigned int NSpaceDimension, typename TCoordinate>
 void
-Cell<NSpaceDimension>::ReceptorsReading()
+Cell<NSpaceDimension, TCoordinate>::ReceptorsReading()
 {
   m_Genome->SetExpressionLevel(Pressurin, m_Pressure);
 
   float substrate0 = m_Aggregate->GetSubstrateValue(m_SelfIdentifier, 0);
 
-  m_ChemoAttractantLevel = substrate0;
+  this->SetChemoAttractantLevel(substrate0);
 }
 } // end namespace bio
 } // end namespace itk
@@ -25,10 +25,18 @@
 #include "itkBioGenome.h"
 #include "BioCellExport.h"
 
+#include <cstdint>
+#include <memory>
+
 namespace itk
 {
 namespace bio
 {
+template <unsigned int NSpaceDimension, typename TCoordinate>
+class ITK_TEMPLATE_EXPORT CellularAggregate;
+template <unsigned int NSpaceDimension, typename TCoordinate>
+class ITK_TEMPLATE_EXPORT CompactCellularAggregate;
+
 /** \class CellBase
  * \brief Non-templated Base class from which the templated Cell classes will be derived.
  *
@@ -43,6 +51,13 @@ public:
   using GenomeType = itk::bio::Genome;
   using GeneIdType = GenomeType::GeneIdType;
 
+  /** Color of the cell for visualization. It is computed when requested
+   *  from the level of chemo attractant read by the cell, using the
+   *  well nourished, hopeful and starving colors of the parameters.
+   *  The color is no longer stored in the cell: the subclasses that colored
+   *  their cells from the expression of the pigment genes, or by setting
+   *  the color in SecreteProducts(), lose that behavior and must override
+   *  GetColor() to keep it. */
   virtual ColorType
   GetColor() const;
 
@@ -65,6 +80,93 @@ public:
     Apop
   };
 
+  CellCycleState
+  GetCycleState() const;
+
+  /** Bits of the chemo attractant mask, classifying the chemo attractant
+   *  level of the cell against the thresholds. */
+  enum ChemoAttractantMaskBits : std::uint8_t
+  {
+    AboveLowThreshold = 1,
+    BelowHighThreshold = 2,
+    AboveHighThreshold = 4,
+    PermissiveChemoAttractant = AboveLowThreshold | BelowHighThreshold
+  };
+
+  /** Return the chemo attractant mask of the cell, classifying its level
+   *  against the thresholds of its parameters. */
+  std::uint8_t
+  GetChemoAttractantMask() const;
+
+  /** Return true when the chemo attractant level is out of the range in
+   *  which the cell reacts to the forces applied by its neighbors. */
+  virtual bool
+  IgnoresForces() const;
+
+  /** Return true when advancing the cell cycle of the cell only accumulates
+   *  nutrients and energy and counts down its latencies: the cell is in
+   *  Gap1, ignores forces, and either has reached its maximum radius or
+   *  waits for its growth latency. */
+  virtual bool
+  IsQuiescent() const;
+
+  /** Number of time steps during which a quiescent cell remains quiescent,
+   *  or NumericTraits<SizeValueType>::max() if it only depends on its
+   *  environment. */
+  virtual SizeValueType
+  GetQuiescenceDuration() const;
+
+  /** Parameters shared by the cells. Each thread has its own set of
+   *  parameters: the static setters modify the parameters of the calling
+   *  thread, and a cell keeps using the parameters of the thread that
+   *  created it. Independent aggregates can therefore be simulated
+   *  concurrently with different parameters. The default values differ
+   *  from those set by Initialize(), which uses a generation limit of 40,
+   *  latencies of 100 and the colors of the nourishment states. */
+  struct Parameters
+  {
+    ColorType m_DefaultColor{}; // not used, see SetDefaultColor()
+
+    double m_DefaultRadius{ 1.0 };          // microns
+    double m_GrowthRadiusIncrement{ 0.01 }; // microns
+    double m_GrowthRadiusLimit{ 2.0 };      // microns
+
+    SizeValueType m_MaximumGenerationLimit{ 30 }; // 30th generation
+    SizeValueType m_GrowthMaximumLatencyTime{ 50 };
+    SizeValueType m_DivisionMaximumLatencyTime{ 50 };
+
+    double m_NutrientSelfRepairLevel{ 0.0 };
+    double m_EnergySelfRepairLevel{ 0.0 };
+
+    double m_DefaultEnergyIntake{ 1.0 };
+    double m_DefaultNutrientsIntake{ 1.0 };
+
+    double m_ChemoAttractantLowThreshold{ 200.0 };
+    double m_ChemoAttractantHighThreshold{ 255.0 };
+
+    ColorType m_WellNourishedColor{};
+    ColorType m_HopefullColor{};
+    ColorType m_StarvingColor{};
+  };
+
+  /** Get/Set all the parameters of the calling thread at once. */
+  static const Parameters &
+  GetParameters();
+
+  static void
+  SetParameters(const Parameters & parameters);
+
+  /** Return the parameters used by the cell, those of the thread that
+   *  created it. The aggregates read the parameters of their cells rather
+   *  than those of the calling thread. */
+  const Parameters &
+  GetCellParameters() const;
+
+  // The aggregate saves and restores the internal state of its cells
+  // when writing and reading checkpoints.
+  template <unsigned int NSpaceDimension, typename TCoordinate>
+  friend class CellularAggregate;
+
 protected:
   CellBase();
   virtual ~CellBase();
@@ -102,11 +204,40 @@ protected:
   virtual bool
   CheckPointApoptosis();
 
+  /** Apply at once the effect of a number of time steps during which the
+   *  cell stayed quiescent. */
+  virtual void
+  AdvanceQuiescentTimeSteps(SizeValueType numberOfSteps);
+
   void
   MarkForRemoval();
 
+  /** Set the chemo attractant level read from the substrate. */
+  void
+  SetChemoAttractantLevel(double level);
+
+  /** Draw the growth and division latencies of a cell that starts a
+   *  colony. The daughters of a mitosis draw them from the aggregate. */
+  void
+  DrawLatencyTimes();
+
+  /** Classify a chemo attractant level against the thresholds. */
+  static std::uint8_t
+  ComputeChemoAttractantMask(double level, const Parameters & parameters);
+
+  /** Parameters of a thread, with the state derived from them. */
+  struct SharedParameters : public Parameters
+  {
+    // Number of cells created. The first cell is numbered as 1.
+    SizeValueType m_Counter{ 0 };
+  };
+
+  using SharedParametersPointer = std::shared_ptr<SharedParameters>;
+
+  static const SharedParametersPointer &
+  GetThreadParameters();
+
   // Static Members
-  static ColorType DefaultColor;
 
   static GeneIdType BlueGene; // Pigment genes
   static GeneIdType RedGene;
@@ -116,31 +247,11 @@ protected:
   static GeneIdType Pressurin; // signal from micro-tubules subject to
                                // stress
 
-  static SizeValueType MaximumGenerationLimit;
-  static SizeValueType GrowthMaximumLatencyTime;
-  static SizeValueType DivisionMaximumLatencyTime;
-
-  static double EnergySelfRepairLevel;
-  static double NutrientSelfRepairLevel;
-
-  static double DefaultEnergyIntake;
-  static double DefaultNutrientsIntake;
-
-  static SizeValueType Counter;
-
-  static ColorType WellNourishedColor;
-  static ColorType HopefullColor;
-  static ColorType StarvingColor;
-
-  static double ChemoAttractantLowThreshold;
-  static double ChemoAttractantHighThreshold;
-
   GenomeType * m_Genome;
   GenomeType * m_GenomeCopy;
 
-  static double DefaultRadius;
-  static double GrowthRadiusLimit;
-  static double GrowthRadiusIncrement;
+  // Parameters of the thread that created the cell.
+  SharedParametersPointer m_Parameters;
 
 public:
   virtual bool
@@ -149,6 +260,9 @@ public:
   static void
   SetDefaultRadius(double);
 
+  static double
+  GetDefaultRadius();
+
   static void
   SetGrowthRadiusLimit(double);
 
@@ -161,6 +275,8 @@ public:
   static void
   SetNutrientSelfRepairLevel(double);
 
+  /** \deprecated The default color is not used since GetColor() computes
+   *  the color from the chemo attractant level. */
   static void
   SetDefaultColor(const ColorType & color);
 
@@ -186,6 +302,7 @@ public:
   static SizeValueType
   GetDivisionMaximumLatencyTime();
 
+  /** Reset the counter of the cells created by the calling thread. */
   static void
   ResetCounter();
 
@@ -195,8 +312,6 @@ public:
 protected:
   double m_Pressure;
 
-  ColorType m_Color;
-
   double m_Radius;
   double m_EnergyReserveLevel;
   double m_NutrientsReserveLevel;
@@ -21,11 +21,21 @@
 
 #include "itkDefaultDynamicMeshTraits.h"
 #include "itkMesh.h"
+#include "itkMultiThreaderBase.h"
 #include "itkImage.h"
+#include "itkImageRegionIteratorWithIndex.h"
 #include "itkBioCell.h"
+#include "itkBioCellularAggregateStatistics.h"
+#include "itkBioInlineNeighborList.h"
+#include "itkBioNeighborGraph.h"
+#include "itkBioTimerWheel.h"
+#include "itkBioTraceRecorder.h"
 #include "itkPolygonCell.h"
 
+#include <cstdint>
 #include <iostream>
+#include <map>
+#include <string>
 #include <vector>
 
 namespace itk
@@ -38,9 +48,17 @@ namespace bio
  *
  * This class represents an aggregation of bio::Cell objects.
  *
+ * TCoordinate is the type of the coordinates of the positions of the
+ * cells, of the forces between them and of the copies of their radii
+ * used by the neighbor search and the force passes. Single precision is
+ * well below the tolerances of a segmentation, and halves the memory
+ * traffic of these passes. The state of the cells themselves, including
+ * their radius, and the checkpoints stay in double precision, so that a
+ * checkpoint can be read by an aggregate of either precision.
+ *
  * \ingroup ITKBioCell
  */
-template <unsigned int NSpaceDimension = 3>
+template <unsigned int NSpaceDimension = 3, typename TCoordinate = double>
 class ITK_TEMPLATE_EXPORT CellularAggregate : public CellularAggregateBase
 {
 public:
@@ -61,16 +79,17 @@ public:
   static constexpr unsigned int SpaceDimension = NSpaceDimension;
 
   /*** Type to be used for data associated with each point in the mesh. */
-  using BioCellType = Cell<NSpaceDimension>;
+  using BioCellType = Cell<NSpaceDimension, TCoordinate>;
   using PointPixelType = BioCellType *;
   using CellPixelType = double;
+  using CoordinateType = TCoordinate;
 
   /** Mesh Traits */
   using MeshTraits = DefaultDynamicMeshTraits<PointPixelType,  // PixelType
                                               NSpaceDimension, // Points Dimension
                                               NSpaceDimension, // Max.Topological Dimension
-                                              double,          // Type for coordinates
-                                              double,          // Type for interpolation
+                                              TCoordinate,     // Type for coordinates
+                                              TCoordinate,     // Type for interpolation
                                               CellPixelType    // Type for values in the cells
                                               >;
 
@@ -100,6 +119,45 @@ public:
   using VoronoiRegionType = PolygonCell<CellInterfaceType>;
   using VoronoiRegionAutoPointer = typename VoronoiRegionType::SelfAutoPointer;
 
+  /** Conditions that can stop Run(). */
+  enum class StopConditionEnum : std::uint8_t
+  {
+    MaximumNumberOfIterations,
+    StableCellCount,
+    StableBoundingVolume,
+    SmallDisplacement,
+    WallClockBudget
+  };
+
+  /** Criteria that stop Run(). A criterion with a zero value is disabled,
+   *  and the run stops as soon as one of the enabled criteria is met. */
+  struct StoppingCriteria
+  {
+    /** Maximum number of iterations of the run. */
+    SizeValueType m_MaximumNumberOfIterations{ 0 };
+
+    /** Number of consecutive iterations without change of the number of
+     *  cells. The iterations are only counted once the number of cells has
+     *  changed during the run, so that the first cell cycle of a colony
+     *  grown from an egg does not stop it: combine this criterion with
+     *  another one for colonies that may never divide nor die. */
+    SizeValueType m_CellCountStableIterations{ 0 };
+
+    /** Number of consecutive iterations in which the volume of the bounding
+     *  box of the cells changed by less than BoundingVolumeTolerance (relative). */
+    SizeValueType m_BoundingVolumeStableIterations{ 0 };
+    double        m_BoundingVolumeTolerance{ 1e-3 };
+
+    /** The run stops when no cell moved by more than this distance during an iteration. */
+    double m_DisplacementTolerance{ 0.0 };
+
+    /** Wall clock budget of the run, in seconds. */
+    double m_WallClockBudget{ 0.0 };
+
+    /** A ProgressEvent is invoked every ProgressStride iterations. */
+    SizeValueType m_ProgressStride{ 0 };
+  };
+
   /** Convenient type alias. */
   using ImagePixelType = float;
   using SubstrateType = Image<ImagePixelType, NSpaceDimension>;
@@ -107,6 +165,33 @@ public:
   using SubstrateValueType = ImagePixelType;
   using SubstratesVector = std::vector<SubstratePointer>;
 
+  /** Fixed size record holding the state of one cell in a checkpoint.
+   *  Records are stored contiguously in the checkpoint file, with all
+   *  the fields aligned on 8 bytes, so that the cell section of a
+   *  checkpoint can be read in bulk or memory-mapped. */
+  struct CheckpointCellRecord
+  {
+    std::uint64_t m_SelfIdentifier;
+    std::uint64_t m_ParentIdentifier;
+    std::uint64_t m_Generation;
+    std::uint64_t m_GrowthLatencyTime;
+    std::uint64_t m_DivisionLatencyTime;
+    double        m_Position[NSpaceDimension];
+    double        m_Force[NSpaceDimension];
+    double        m_Radius;
+    double        m_Pressure;
+    double        m_EnergyReserveLevel;
+    double        m_NutrientsReserveLevel;
+    double        m_ChemoAttractantLevel;
+    float         m_Color[3];
+    std::uint32_t m_CycleState;
+    std::uint8_t  m_MarkedForRemoval;
+    std::uint8_t  m_ScheduleApoptosis;
+    std::uint8_t  m_HasGenome;
+    std::uint8_t  m_HasGenomeCopy;
+    std::uint8_t  m_Padding[4];
+  };
+
 public:
   unsigned int
   GetNumberOfCells() const;
@@ -123,14 +208,243 @@ public:
   void
   SetGrowthRadiusIncrement(double value);
 
-  itkGetModifiableObjectMacro(Mesh, MeshType);
+  /** Mesh of the aggregate: the points are the positions of the cells,
+   *  the point data are the cells and the cells of the mesh are the Voronoi
+   *  regions listing the neighbors of each cell. The Voronoi regions are
+   *  built from the neighbor graph when the mesh is requested. */
+  MeshType *
+  GetModifiableMesh();
+  const MeshType *
+  GetMesh() const;
+
+  /** Positions of the cells, indexed by cell identifier. */
+  const PointsContainer *
+  GetPoints() const;
+
+  /** Cells of the aggregate, indexed by cell identifier. */
+  const PointDataContainer *
+  GetPointData() const;
+
+  /** Copy the identifiers, positions, radii, colors and cycle states of
+   *  the cells into contiguous arrays owned by the aggregate, in the order
+   *  of the identifiers. The positions are stored as SpaceDimension
+   *  coordinates per cell and the colors as three components per cell.
+   *  The arrays keep their address from one update to the next as long as
+   *  the number of cells does not exceed their capacity. Otherwise, the
+   *  next update reallocates them, which invalidates the pointers returned
+   *  by the array getters, as does the destruction of the aggregate. */
+  void
+  UpdateCellArrays();
+
+  /** Number of cells in the arrays of the last UpdateCellArrays(). */
+  SizeValueType
+  GetCellArraysLength() const
+  {
+    return static_cast<SizeValueType>(m_CellArrayIdentifiers.size());
+  }
+
+  const IdentifierType *
+  GetCellIdentifierArray() const
+  {
+    return m_CellArrayIdentifiers.data();
+  }
+
+  const double *
+  GetCellPositionArray() const
+  {
+    return m_CellArrayPositions.data();
+  }
+
+  const double *
+  GetCellRadiusArray() const
+  {
+    return m_CellArrayRadii.data();
+  }
+
+  const float *
+  GetCellColorArray() const
+  {
+    return m_CellArrayColors.data();
+  }
+
+  /** Values of CellBase::CellCycleState. */
+  const std::uint8_t *
+  GetCellCycleStateArray() const
+  {
+    return m_CellArrayCycleStates.data();
+  }
+
+  /** Neighbor lists of the cells, rebuilt by the periodic neighbor search
+   *  and updated when cells are added or removed. */
+  const NeighborGraph &
+  GetNeighborGraph() const
+  {
+    return m_NeighborGraph;
+  }
 
+  /** Number of time steps executed so far. */
+  itkGetConstMacro(Iteration, SizeValueType);
+
+  /** Advance the simulation by one step. At the end of the step a
+   *  CellularAggregateIterationEvent carrying the statistics of the
+   *  iteration is invoked. */
   virtual void
   AdvanceTimeStep();
 
+  /** Advance the simulation by the given number of steps. */
+  void
+  AdvanceTimeSteps(SizeValueType numberOfSteps);
+
+  /** Timings and counters of the last completed iteration. */
+  const CellularAggregateStatistics &
+  GetLastIterationStatistics() const
+  {
+    return m_LastIterationStatistics;
+  }
+
+  /** Timings and counters accumulated since the last ResetStatistics(). */
+  const CellularAggregateStatistics &
+  GetAccumulatedStatistics() const
+  {
+    return m_AccumulatedStatistics;
+  }
+
+  void
+  ResetStatistics();
+
+  /** Advance the simulation until one of the stopping criteria is met. A
+   *  StartEvent and an EndEvent are invoked at the beginning and at the end
+   *  of the run, and a ProgressEvent every ProgressStride iterations. An
+   *  exception is thrown if no criterion is enabled. */
+  StopConditionEnum
+  Run(const StoppingCriteria & criteria);
+
+  /** Condition that stopped the last Run(). */
+  itkGetConstMacro(StopCondition, StopConditionEnum);
+
+  std::string
+  GetStopConditionDescription() const;
+
+  /** Fraction of the last Run() that has been completed, estimated from the
+   *  maximum number of iterations and the wall clock budget. */
+  itkGetConstMacro(Progress, float);
+
+  /** Largest displacement of a cell during the last iteration. */
+  itkGetConstMacro(MaximumDisplacement, double);
+
+  /** Volume of the axis-aligned bounding box of the cell positions. */
+  double
+  ComputeBoundingVolume() const;
+
+  /** Set to the given value the pixels of the mask whose center is inside
+   *  a cell. The mask must be allocated, and its other pixels are left
+   *  unchanged, so that several aggregates can be drawn in the same mask. */
+  template <typename TMaskImage>
+  void
+  RasterizeCells(TMaskImage * mask, typename TMaskImage::PixelType value) const;
+
+  /** When UseActiveSet is on, the quiescent cells whose neighbors all
+   *  ignore forces are put to sleep, and skipped by the force, position
+   *  and cell cycle passes. A sleeping cell is woken up when a neighbor is
+   *  added or removed next to it, when a cell that reacts to forces
+   *  enters its neighborhood, or when its growth latency expires, and then
+   *  catches up with the skipped time steps. The simulation gives the same
+   *  result with or without the active set. Off by default. */
+  void
+  SetUseActiveSet(bool useActiveSet);
+  itkGetConstMacro(UseActiveSet, bool);
+  itkBooleanMacro(UseActiveSet);
+
+  SizeValueType
+  GetNumberOfSleepingCells() const;
+
+  /** Wake up all the sleeping cells. This must be called when the
+   *  substrates or the parameters of the cells are modified during a
+   *  simulation with the active set. */
+  void
+  WakeUpAllCells();
+
+  /** Every SpatialReorderingInterval iterations the storage of the cells is
+   *  rebuilt along a Morton curve, see ReorderCellStorage(). Zero disables
+   *  the reordering (default). */
+  itkSetMacro(SpatialReorderingInterval, SizeValueType);
+  itkGetConstMacro(SpatialReorderingInterval, SizeValueType);
+
+  /** Rebuild the points, point data and Voronoi regions containers of the
+   *  mesh, allocating their elements in the Morton (Z-order) order of the
+   *  cell positions, so that the elements of neighboring cells are close in
+   *  memory. The identifiers of the cells and the order in which the
+   *  containers are traversed do not change, and neither does the result of
+   *  the simulation. */
+  void
+  ReorderCellStorage();
+
+  /** When NumberOfTiles is larger than one, space is partitioned in slabs
+   *  along the axis in which the colony is the longest. Each slab is a tile
+   *  that owns the cells whose center it contains, and the neighbor search,
+   *  the forces and the positions of the cells of a tile are computed by a
+   *  worker thread of the MultiThreader. A tile reads the ghost cells of
+   *  the neighboring tiles that are within the range of the neighbor
+   *  search, and the forces exchanged across a boundary are applied by the
+   *  tile that owns the cell, in the order of the sequential pass. The
+   *  cells are assigned to the tiles at each time step, so that the cells
+   *  that moved or were born across a boundary migrate to their new tile.
+   *  The cell cycles are still advanced in order of identifier, because
+   *  the daughters draw their latencies and positions from the random
+   *  generator of the aggregate. The simulation gives the same result
+   *  whatever the number of tiles. One (default) disables the
+   *  decomposition. */
+  void
+  SetNumberOfTiles(unsigned int numberOfTiles);
+  itkGetConstMacro(NumberOfTiles, unsigned int);
+
+  /** Every TileRebalancingInterval iterations the boundaries of the tiles
+   *  are moved so that all the tiles own the same number of cells. Zero
+   *  only balances the tiles when the decomposition starts. */
+  itkSetMacro(TileRebalancingInterval, SizeValueType);
+  itkGetConstMacro(TileRebalancingInterval, SizeValueType);
+
+  /** Axis along which space is partitioned, and positions of the
+   *  boundaries between consecutive tiles along this axis. */
+  itkGetConstMacro(TileAxis, unsigned int);
+
+  const std::vector<double> &
+  GetTileBoundaries() const
+  {
+    return m_TileBoundaries;
+  }
+
+  /** Multithreader executing the tiles. */
+  itkGetModifiableObjectMacro(MultiThreader, MultiThreaderBase);
+
   virtual void
   SetEgg(BioCellType * cell, const PointType & position);
 
+  using SeedPositionsContainer = std::vector<PointType>;
+
+  /** Replace the cells of the aggregate by seed cells at the given
+   *  positions, created with BioCellType::CreateSeed(). The cells, their
+   *  positions and the neighbor graph are built in a single pass, without
+   *  going through Add(), so that a simulation can start with a large
+   *  population. The neighbor graph is the one ComputeClosestPoints()
+   *  would build. */
+  void
+  SetSeeds(const SeedPositionsContainer & positions);
+
+  /** Fill the region of the label image that has the given label with
+   *  seed cells on a packed lattice, see SetSeeds(). The rows of the
+   *  lattice are staggered by half the spacing, which makes a hexagonal
+   *  lattice in 2D. A zero spacing places touching cells of the default
+   *  radius. */
+  template <typename TLabelImage>
+  void
+  SetSeeds(const TLabelImage * labels, typename TLabelImage::PixelType label, double spacing = 0.0);
+
+  /** Positions of a packed lattice with the given spacing filling the box
+   *  between the lower and upper corners. */
+  static SeedPositionsContainer
+  ComputeSeedLattice(const PointType & lower, const PointType & upper, double spacing);
+
   virtual void
   Add(CellBase * cell);
 
@@ -143,12 +457,37 @@ public:
   void
   Remove(CellBase * cell) override;
 
+  void
+  Divide(CellBase * mother, CellBase * daughterA, CellBase * daughterB, double perturbationLength) override;
+
+  /** Return a new Voronoi region listing the neighbors of the cell. The
+   *  region is a copy: modifying it does not change the neighbor graph. */
   virtual void
   GetVoronoi(IdentifierType cellId, VoronoiRegionAutoPointer &) const;
 
   void
   DumpContent(std::ostream & os) const;
 
+  /** Write a binary checkpoint of the aggregate. The checkpoint contains
+   *  the positions and the complete state of the cells (including their
+   *  genomes), the neighbor lists, the iteration count, the cell counter
+   *  and the state of the random number generator. The substrates are not
+   *  included and must be added again before resuming the simulation. */
+  void
+  WriteCheckpoint(const std::string & fileName) const;
+
+  void
+  WriteCheckpoint(std::ostream & os) const;
+
+  /** Replace the content of the aggregate with the one of a checkpoint.
+   *  Continuing the simulation from there reproduces the original run,
+   *  provided that the same substrates and cell parameters are used. */
+  void
+  ReadCheckpoint(const std::string & fileName);
+
+  void
+  ReadCheckpoint(std::istream & is);
+
   virtual void
   AddSubstrate(SubstrateType * substrate);
 
@@ -158,9 +497,22 @@ public:
   SubstrateValueType
   GetSubstrateValue(IdentifierType cellId, unsigned int substrateId) const override;
 
+  /** Delete all the cells and reset the counter of cell identifiers. */
   virtual void
   KillAll();
 
+  /** Remove all the cells and bring the aggregate back to iteration zero
+   *  for a new simulation. The substrates and the parameters are kept, and
+   *  so is the memory of the neighbor graph and of the wake-up timers. The
+   *  random generator is not reseeded, and the counter of cell identifiers
+   *  is not reset because other aggregates may be using it. */
+  void
+  Reset();
+
+  /** Reset() the aggregate and replace its substrates. */
+  void
+  Reinitialize(const SubstratesVector & substrates);
+
 protected:
   CellularAggregate();
   ~CellularAggregate() override;
@@ -177,15 +529,228 @@ protected:
   virtual void
   ComputeClosestPoints();
 
+  /** Advance the cell cycle of every cell, adding the daughters of the
+   *  cells that divide and removing the cells that die. */
+  virtual void
+  AdvanceCellCycles();
+
   virtual void
   ClearForces();
 
+  /** Release all the cells and their Voronoi regions, leaving the aggregate empty. */
+  void
+  ClearCells();
+
+  /** Wake up a sleeping cell. Nothing is done if the cell is not asleep. */
+  void
+  WakeUp(IdentifierType cellId);
+
+  /** Put the cell to sleep if it is quiescent and all its neighbors ignore forces. */
+  void
+  TryToSleep(IdentifierType cellId, BioCellType * cell);
+
+  /** Bring the state of the sleeping cells up to date, without waking them up. */
+  void
+  SynchronizeSleepingCells() const;
+
+  /** Number of time steps skipped by a cell asleep since sleepIteration. */
+  SizeValueType
+  GetNumberOfSkippedSteps(IdentifierType cellId, SizeValueType sleepIteration) const;
+
+  /** Cells that are not asleep, sorted by identifier like the mesh containers. */
+  using ActiveCellsContainer = std::map<IdentifierType, BioCellType *>;
+
+  /** Last iteration in which the cell cycle of a sleeping cell was
+   *  advanced, and iteration at which its timer wakes it up. */
+  struct SleepingCell
+  {
+    SizeValueType m_SleepIteration;
+    SizeValueType m_WakeUpIteration;
+  };
+
+  using SleepingCellsContainer = std::map<IdentifierType, SleepingCell>;
+
+  /** Random displacement of the given length separating two daughters. */
+  VectorType
+  ComputeDivisionPerturbation(double perturbationLength);
+
+  /** Rebuild the Voronoi regions of the mesh if the neighbor graph has
+   *  changed since they were last built. */
+  void
+  UpdateVoronoiRegions() const;
+
+  /** Wake up the cells whose quiescence ends in the current iteration. */
+  void
+  WakeUpExpiredCells();
+
+  /** Interleave the bits of the coordinates of the point, quantized in a
+   *  grid with the given origin and number of cells per unit length. */
+  static std::uint64_t
+  ComputeMortonCode(const PointType & point, const PointType & origin, double scale);
+
+  /** Fill the checkpoint record of a cell at the given position. */
+  static void
+  FillCheckpointRecord(IdentifierType         cellId,
+                       const BioCellType *    cell,
+                       const PointType &      position,
+                       CheckpointCellRecord & record);
+
+  /** Write the genomes of a cell, which follow the records in a checkpoint. */
+  static void
+  WriteCheckpointGenomes(const BioCellType * cell, std::ostream & os);
+
+  /** Create a cell with the state saved in a checkpoint record, reading
+   *  its genomes from the stream. The cell gets a new identifier. */
+  static BioCellType *
+  CreateCellFromCheckpointRecord(const CheckpointCellRecord & record, std::istream & is);
+
+  /** Read a section of a checkpoint holding the given number of elements.
+   *  The section is read by blocks, so that a corrupted number of elements
+   *  fails at the end of the stream instead of allocating the memory it
+   *  claims. Return false if the stream ends before the section. */
+  template <typename TElement>
+  static bool
+  ReadCheckpointSection(std::istream & is, std::uint64_t numberOfElements, std::vector<TElement> & elements);
+
+  /** Insert a cell that has no parent in the aggregate at the given
+   *  position, with an empty neighbor list. */
+  void
+  InsertCell(BioCellType * cell, const PointType & position);
+
+  /** Wake up the sleeping cells that have a neighbor reacting to forces. */
+  void
+  WakeUpDisturbedCells();
+
+  /** Cell owned by a tile, with a copy of its position and radius. */
+  struct TileCell
+  {
+    IdentifierType m_Identifier;
+    BioCellType *  m_Cell;
+    PointType      m_Position;
+    CoordinateType m_Radius;
+    bool           m_Active;
+  };
+
+  /** Force applied by the pass of the source cell to the target cell. */
+  struct ForceContribution
+  {
+    IdentifierType m_Target;
+    IdentifierType m_Source;
+    BioCellType *  m_TargetCell;
+    VectorType     m_Force;
+  };
+
+  /** Tile of the domain decomposition, with the buffers of its worker. */
+  struct Tile
+  {
+    double                      m_Lower;
+    double                      m_Upper;
+    std::vector<TileCell>       m_Cells;
+    std::vector<IdentifierType> m_PreviousCells;
+
+    // Owned and ghost cells, sorted by identifier, and neighbor lists of
+    // the owned cells found by the neighbor search.
+    std::vector<const TileCell *> m_Candidates;
+    std::vector<SizeValueType>    m_RowOffsets;
+    std::vector<IdentifierType>   m_RowNeighbors;
+
+    // Forces to apply to the cells of each tile.
+    std::vector<std::vector<ForceContribution>> m_Contributions;
+    std::vector<ForceContribution>              m_IncomingContributions;
+
+    double                      m_MaximumDisplacement;
+    CellularAggregateStatistics m_Statistics;
+  };
+
+  /** Assign the cells to the tiles if they changed since the last
+   *  assignment, balancing the tiles when needed. */
+  void
+  UpdateTiles();
+
+  /** Place the boundaries of the tiles at the quantiles of the positions
+   *  of the cells along the longest axis of the colony. */
+  void
+  BalanceTiles();
+
+  /** Index of the tile that contains the point. */
+  unsigned int
+  ComputeTileIndex(const PointType & point) const;
+
+  /** Passes of AdvanceTimeStep() executed by the tiles. */
+  void
+  ComputeClosestPointsInTiles();
+
+  void
+  ComputeForcesInTiles();
+
+  void
+  UpdatePositionsInTiles();
+
 private:
+  /** Header at the beginning of a checkpoint file. */
+  struct CheckpointHeader
+  {
+    char          m_Signature[8];
+    std::uint32_t m_Version;
+    std::uint32_t m_SpaceDimension;
+    std::uint32_t m_RecordSize;
+    std::uint32_t m_ByteOrderMark;
+    std::uint64_t m_NumberOfCells;
+    std::uint64_t m_NumberOfNeighbors;
+    std::uint64_t m_Iteration;
+    std::uint64_t m_ClosestPointComputationInterval;
+    std::uint64_t m_CellCounter;
+    std::uint64_t m_RandomGeneratorStateLength;
+    double        m_FrictionForce;
+  };
+
   MeshPointer      m_Mesh;
   SubstratesVector m_Substrates;
   double           m_FrictionForce;
   SizeValueType    m_Iteration;
   SizeValueType    m_ClosestPointComputationInterval;
+
+  NeighborGraph         m_NeighborGraph;
+  mutable SizeValueType m_VoronoiRegionsTimeStamp{ 0 };
+
+  bool                           m_UseActiveSet{ false };
+  ActiveCellsContainer           m_ActiveCells;
+  mutable SleepingCellsContainer m_SleepingCells;
+  TimerWheel                     m_WakeUpTimers;
+
+  SizeValueType m_SpatialReorderingInterval{ 0 };
+
+  // Identifier of the cell whose cycle is being advanced in the current
+  // iteration. Zero before the cell cycle pass, and the maximum identifier
+  // after it.
+  IdentifierType m_CellCycleCursor{ 0 };
+
+  double            m_MaximumDisplacement{ 0.0 };
+  StopConditionEnum m_StopCondition{ StopConditionEnum::MaximumNumberOfIterations };
+  float             m_Progress{ 0.0f };
+
+  // Arrays filled by UpdateCellArrays().
+  std::vector<IdentifierType> m_CellArrayIdentifiers;
+  std::vector<double>         m_CellArrayPositions;
+  std::vector<double>         m_CellArrayRadii;
+  std::vector<float>          m_CellArrayColors;
+  std::vector<std::uint8_t>   m_CellArrayCycleStates;
+
+  // Domain decomposition. The tiles are valid until the cells are moved,
+  // added or removed.
+  unsigned int               m_NumberOfTiles{ 1 };
+  SizeValueType              m_TileRebalancingInterval{ 100 };
+  SizeValueType              m_TileBalanceIteration{ 0 };
+  unsigned int               m_TileAxis{ 0 };
+  std::vector<double>        m_TileBoundaries;
+  std::vector<Tile>          m_Tiles;
+  bool                       m_TilesValid{ false };
+  MultiThreaderBase::Pointer m_MultiThreader;
+
+  // The current statistics are updated from const methods such as GetSubstrateValue().
+  mutable CellularAggregateStatistics m_CurrentStatistics;
+  CellularAggregateStatistics         m_LastIterationStatistics;
+  CellularAggregateStatistics         m_AccumulatedStatistics;
 };
 } // end namespace bio
 } // end namespace itk
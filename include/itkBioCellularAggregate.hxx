@@ -19,20 +19,21 @@
 #ifndef itkBioCellularAggregate_hxx
 #define itkBioCellularAggregate_hxx
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <sstream>
 
 namespace itk
 {
 namespace bio
 {
-template <unsigned int NSpaceDimension>
-CellularAggregate<NSpaceDimension>::CellularAggregate()
+template <unsigned int NSpaceDimension, typename TCoordinate>
+CellularAggregate<NSpaceDimension, TCoordinate>::CellularAggregate()
 {
-  typename BioCellType::ColorType color;
-  color.SetRed(1.0);
-  color.SetGreen(1.0);
-  color.SetBlue(1.0);
-  BioCellType::SetDefaultColor(color);
-
   m_Mesh = MeshType::New();
 
   m_Mesh->SetCellsAllocationMethod(MeshEnums::MeshClassCellsAllocationMethod::CellsAllocatedDynamicallyCellByCell);
@@ -44,47 +45,53 @@ CellularAggregate<NSpaceDimension>::CellularAggregate()
   m_ClosestPointComputationInterval = 5;
 
   m_FrictionForce = 1.0f;
+
+  m_MultiThreader = MultiThreaderBase::New();
 }
 
-template <unsigned int NSpaceDimension>
-CellularAggregate<NSpaceDimension>::~CellularAggregate()
+template <unsigned int NSpaceDimension, typename TCoordinate>
+CellularAggregate<NSpaceDimension, TCoordinate>::~CellularAggregate()
 {
   this->KillAll();
 }
 
-template <unsigned int NSpaceDimension>
+template <unsigned int NSpaceDimension, typename TCoordinate>
 unsigned int
-CellularAggregate<NSpaceDimension>::GetNumberOfCells() const
+CellularAggregate<NSpaceDimension, TCoordinate>::GetNumberOfCells() const
 {
   return m_Mesh->GetPointData()->Size();
 }
 
-template <unsigned int NSpaceDimension>
+template <unsigned int NSpaceDimension, typename TCoordinate>
 void
-CellularAggregate<NSpaceDimension>::SetGrowthRadiusLimit(double value)
+CellularAggregate<NSpaceDimension, TCoordinate>::SetGrowthRadiusLimit(double value)
 {
   BioCellType::SetGrowthRadiusLimit(value);
+  this->WakeUpAllCells();
 }
 
-template <unsigned int NSpaceDimension>
+template <unsigned int NSpaceDimension, typename TCoordinate>
 void
-CellularAggregate<NSpaceDimension>::SetGrowthRadiusIncrement(double value)
+CellularAggregate<NSpaceDimension, TCoordinate>::SetGrowthRadiusIncrement(double value)
 {
   BioCellType::SetGrowthRadiusIncrement(value);
+  this->WakeUpAllCells();
 }
 
-template <unsigned int NSpaceDimension>
+template <unsigned int NSpaceDimension, typename TCoordinate>
 void
-CellularAggregate<NSpaceDimension>::PrintSelf(std::ostream & os, itk::Indent indent) const
+CellularAggregate<NSpaceDimension, TCoordinate>::PrintSelf(std::ostream & os, itk::Indent indent) const
 {
   Superclass::PrintSelf(os, indent);
 
   os << "Cellular aggregate " << m_Mesh << std::endl;
+  os << indent << "NumberOfTiles: " << m_NumberOfTiles << std::endl;
+  os << indent << "TileRebalancingInterval: " << m_TileRebalancingInterval << std::endl;
 }
 
-template <unsigned int NSpaceDimension>
+template <unsigned int NSpaceDimension, typename TCoordinate>
 void
-CellularAggregate<NSpaceDimension>::Remove(CellBase * cellbase)
+CellularAggregate<NSpaceDimension, TCoordinate>::Remove(CellBase * cellbase)
 {
   auto * cell = dynamic_cast<BioCellType *>(cellbase);
 
@@ -96,72 +103,44 @@ CellularAggregate<NSpaceDimension>::Remove(CellBase * cellbase)
     throw exception;
   }
 
+  itkBioCellPhaseTimerMacro(m_CurrentStatistics, CellularAggregateStatistics::Deaths);
+  itkBioCellCounterMacro(m_CurrentStatistics, m_Deaths, 1);
+
   IdentifierType id = cell->GetSelfIdentifier();
 
-  typename MeshType::CellAutoPointer region;
-  bool                               regionExist = m_Mesh->GetCell(id, region);
-  if (regionExist)
+  if (!m_NeighborGraph.HasRow(id))
   {
-    auto * realRegion = dynamic_cast<VoronoiRegionType *>(region.GetPointer());
+    itkExceptionMacro(" Region " << id << " doesn't exist ");
+  }
 
-    if (!realRegion)
-    {
-      itkExceptionMacro("CellularAggregate::Remove() couldn't dynamic_cast region ");
-    }
-    else
+  // Notify all the neighbors that this cell is going away. Removing
+  // neighbors does not move the rows of the graph.
+  const IdentifierType * neighborEnd = m_NeighborGraph.End(id);
+  for (const IdentifierType * neighbor = m_NeighborGraph.Begin(id); neighbor != neighborEnd; ++neighbor)
+  {
+    const IdentifierType neighborId = *neighbor;
+    if (m_NeighborGraph.HasRow(neighborId))
     {
-      //
-      // Notify all the neighbors that this cell is going away
-      //
-      typename VoronoiRegionType::PointIdIterator neighbor = realRegion->PointIdsBegin();
-      typename VoronoiRegionType::PointIdIterator end = realRegion->PointIdsEnd();
-      while (neighbor != end)
-      {
-        const IdentifierType               neighborId = (*neighbor);
-        typename MeshType::CellAutoPointer cellPointer;
-        bool                               neighborVoronoiExist = m_Mesh->GetCell(neighborId, cellPointer);
-        if (neighborVoronoiExist)
-        {
-          auto * vregion = dynamic_cast<VoronoiRegionType *>(cellPointer.GetPointer());
-          if (!vregion)
-          {
-            std::cerr << "CellularAggregate::Add() Failed to find a region" << std::endl;
-          }
-          else
-          {
-            vregion->RemovePointId(id);
-          }
-        }
-        neighbor++;
-      }
-
-      // We can now remove the entry from the list of cells in the Mesh
-      m_Mesh->GetCells()->DeleteIndex(id);
-
-      // and then release the memory used by the VoronoiRegion
-      delete realRegion;
+      m_NeighborGraph.RemoveNeighbor(neighborId, id);
+      this->WakeUp(neighborId);
     }
   }
-  else
-  {
-    itkExceptionMacro(" Region " << id << " doesn't exist ");
-  }
+  m_NeighborGraph.RemoveRow(id);
 
   m_Mesh->GetPoints()->DeleteIndex(id);
   m_Mesh->GetPointData()->DeleteIndex(id);
+  m_ActiveCells.erase(id);
+  m_SleepingCells.erase(id);
 
   // Finally we can delete the BioCell;
   delete cell;
 }
 
-template <unsigned int NSpaceDimension>
+template <unsigned int NSpaceDimension, typename TCoordinate>
 void
-CellularAggregate<NSpaceDimension>::GetVoronoi(IdentifierType cellId, VoronoiRegionAutoPointer & voronoiPointer) const
+CellularAggregate<NSpaceDimension, TCoordinate>::GetVoronoi(IdentifierType cellId, VoronoiRegionAutoPointer & voronoiPointer) const
 {
-  typename MeshType::CellAutoPointer cellPointer;
-
-  bool voronoiExists = m_Mesh->GetCell(cellId, cellPointer);
-  if (!voronoiExists)
+  if (!m_NeighborGraph.HasRow(cellId))
   {
     itk::ExceptionObject exception;
     exception.SetDescription("voronoi region does not exist in the container");
@@ -169,28 +148,329 @@ CellularAggregate<NSpaceDimension>::GetVoronoi(IdentifierType cellId, VoronoiReg
     throw exception;
   }
 
-  auto * region = dynamic_cast<VoronoiRegionType *>(cellPointer.GetPointer());
+  auto * region = new VoronoiRegionType;
+  region->SetPointIds(m_NeighborGraph.Begin(cellId), m_NeighborGraph.End(cellId));
+  voronoiPointer.TakeOwnership(region);
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+auto
+CellularAggregate<NSpaceDimension, TCoordinate>::GetModifiableMesh() -> MeshType *
+{
+  this->UpdateVoronoiRegions();
+  return m_Mesh.GetPointer();
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+auto
+CellularAggregate<NSpaceDimension, TCoordinate>::GetMesh() const -> const MeshType *
+{
+  this->UpdateVoronoiRegions();
+  return m_Mesh.GetPointer();
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+auto
+CellularAggregate<NSpaceDimension, TCoordinate>::GetPoints() const -> const PointsContainer *
+{
+  return m_Mesh->GetPoints();
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+auto
+CellularAggregate<NSpaceDimension, TCoordinate>::GetPointData() const -> const PointDataContainer *
+{
+  return m_Mesh->GetPointData();
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+CellularAggregate<NSpaceDimension, TCoordinate>::UpdateVoronoiRegions() const
+{
+  if (m_VoronoiRegionsTimeStamp == m_NeighborGraph.GetTimeStamp())
+  {
+    return;
+  }
+
+  VoronoiIterator region = m_Mesh->GetCells()->Begin();
+  VoronoiIterator regionEnd = m_Mesh->GetCells()->End();
+  while (region != regionEnd)
+  {
+    delete (region.Value());
+    ++region;
+  }
+  m_Mesh->GetCells()->Initialize();
 
-  voronoiPointer.TakeNoOwnership(region);
-  if (cellPointer.IsOwner())
+  for (const IdentifierType cellId : m_NeighborGraph.GetRowIdentifiers())
   {
-    voronoiPointer.TakeOwnership();
-    cellPointer.ReleaseOwnership();
+    auto * voronoiRegion = new VoronoiRegionType;
+    voronoiRegion->SetPointIds(m_NeighborGraph.Begin(cellId), m_NeighborGraph.End(cellId));
+
+    CellAutoPointer regionPointer;
+    regionPointer.TakeOwnership(voronoiRegion);
+    m_Mesh->SetCell(cellId, regionPointer);
   }
+
+  m_VoronoiRegionsTimeStamp = m_NeighborGraph.GetTimeStamp();
 }
 
-template <unsigned int NSpaceDimension>
+template <unsigned int NSpaceDimension, typename TCoordinate>
 void
-CellularAggregate<NSpaceDimension>::SetEgg(BioCellType * cell, const PointType & position)
+CellularAggregate<NSpaceDimension, TCoordinate>::SetEgg(BioCellType * cell, const PointType & position)
 {
   VectorType perturbation = position.GetVectorFromOrigin();
 
   this->Add(cell, perturbation);
 }
 
-template <unsigned int NSpaceDimension>
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+CellularAggregate<NSpaceDimension, TCoordinate>::SetSeeds(const SeedPositionsContainer & positions)
+{
+  this->ClearCells();
+
+  const SizeValueType numberOfCells = positions.size();
+  if (numberOfCells == 0)
+  {
+    return;
+  }
+
+  // The seeds are created in order, so their identifiers increase with
+  // their index in the list of positions.
+  std::vector<BioCellType *>  cells(numberOfCells);
+  std::vector<CoordinateType> limitDistances(numberOfCells);
+  CoordinateType              maximumLimitDistance = 0.0;
+  for (SizeValueType index = 0; index < numberOfCells; ++index)
+  {
+    BioCellType * cell = BioCellType::CreateSeed();
+    cell->SetCellularAggregate(this);
+    cells[index] = cell;
+
+    const IdentifierType cellId = cell->GetSelfIdentifier();
+    m_Mesh->SetPoint(cellId, positions[index]);
+    m_Mesh->SetPointData(cellId, cell);
+    m_ActiveCells.emplace_hint(m_ActiveCells.end(), cellId, cell);
+
+    const CoordinateType radius = cell->GetRadius();
+    limitDistances[index] = radius * 4;
+    maximumLimitDistance = std::max(maximumLimitDistance, limitDistances[index]);
+  }
+
+  // Hash the seeds in a grid of buckets as large as the neighborhoods, so
+  // that the neighbors of a seed are found in the adjacent buckets.
+  PointType lower = positions[0];
+  for (const PointType & position : positions)
+  {
+    for (unsigned int d = 0; d < NSpaceDimension; ++d)
+    {
+      lower[d] = std::min(lower[d], position[d]);
+    }
+  }
+
+  using BucketIndexType = Index<NSpaceDimension>;
+  std::vector<BucketIndexType> buckets(numberOfCells);
+  BucketIndexType              gridSize;
+  gridSize.Fill(1);
+  for (SizeValueType index = 0; index < numberOfCells; ++index)
+  {
+    for (unsigned int d = 0; d < NSpaceDimension; ++d)
+    {
+      buckets[index][d] = static_cast<IndexValueType>((positions[index][d] - lower[d]) / maximumLimitDistance);
+      gridSize[d] = std::max(gridSize[d], buckets[index][d] + 2);
+    }
+  }
+
+  const auto linearBucket = [&gridSize](const BucketIndexType & bucket) {
+    std::uint64_t key = 0;
+    for (unsigned int d = NSpaceDimension; d > 0; --d)
+    {
+      key = key * static_cast<std::uint64_t>(gridSize[d - 1]) + static_cast<std::uint64_t>(bucket[d - 1]);
+    }
+    return key;
+  };
+
+  std::vector<std::pair<std::uint64_t, SizeValueType>> sortedSeeds(numberOfCells);
+  for (SizeValueType index = 0; index < numberOfCells; ++index)
+  {
+    sortedSeeds[index] = std::make_pair(linearBucket(buckets[index]), index);
+  }
+  std::sort(sortedSeeds.begin(), sortedSeeds.end());
+
+  SizeValueType numberOfAdjacentBuckets = 1;
+  for (unsigned int d = 0; d < NSpaceDimension; ++d)
+  {
+    numberOfAdjacentBuckets *= 3;
+  }
+
+  m_NeighborGraph.Reserve(numberOfCells, numberOfCells * 16);
+  std::vector<SizeValueType> neighbors;
+  for (SizeValueType index = 0; index < numberOfCells; ++index)
+  {
+    neighbors.clear();
+    for (SizeValueType adjacent = 0; adjacent < numberOfAdjacentBuckets; ++adjacent)
+    {
+      BucketIndexType bucket = buckets[index];
+      SizeValueType   offsets = adjacent;
+      bool            insideGrid = true;
+      for (unsigned int d = 0; d < NSpaceDimension; ++d)
+      {
+        bucket[d] += static_cast<IndexValueType>(offsets % 3) - 1;
+        offsets /= 3;
+        insideGrid = insideGrid && bucket[d] >= 0;
+      }
+      if (!insideGrid)
+      {
+        continue;
+      }
+
+      const std::uint64_t key = linearBucket(bucket);
+      auto                seed = std::lower_bound(
+        sortedSeeds.begin(), sortedSeeds.end(), std::make_pair(key, SizeValueType{ 0 }));
+      for (; seed != sortedSeeds.end() && seed->first == key; ++seed)
+      {
+        const SizeValueType other = seed->second;
+        if (other == index)
+        {
+          continue;
+        }
+
+        typename BioCellType::VectorType relativePosition = positions[index] - positions[other];
+        if (relativePosition.GetNorm() < limitDistances[index])
+        {
+          neighbors.push_back(other);
+        }
+      }
+    }
+
+    // Same order as ComputeClosestPoints(): increasing identifiers.
+    std::sort(neighbors.begin(), neighbors.end());
+    m_NeighborGraph.BeginRow(cells[index]->GetSelfIdentifier());
+    for (const SizeValueType other : neighbors)
+    {
+      m_NeighborGraph.PushBack(cells[other]->GetSelfIdentifier());
+    }
+  }
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+template <typename TLabelImage>
+void
+CellularAggregate<NSpaceDimension, TCoordinate>::SetSeeds(const TLabelImage *               labels,
+                                             typename TLabelImage::PixelType label,
+                                             double                            spacing)
+{
+  static_assert(TLabelImage::ImageDimension == NSpaceDimension, "The label image must have the space dimension");
+
+  if (labels == nullptr)
+  {
+    itkExceptionMacro(<< "The label image is null");
+  }
+  if (!(spacing > 0.0))
+  {
+    spacing = 2.0 * BioCellType::GetDefaultRadius();
+  }
+
+  // Bounding box of the label image in physical space.
+  const typename TLabelImage::RegionType region = labels->GetBufferedRegion();
+  PointType                              lower;
+  PointType                              upper;
+  lower.Fill(NumericTraits<CoordinateType>::max());
+  upper.Fill(NumericTraits<CoordinateType>::NonpositiveMin());
+  for (unsigned int corner = 0; corner < (1u << NSpaceDimension); ++corner)
+  {
+    typename TLabelImage::IndexType index = region.GetIndex();
+    for (unsigned int d = 0; d < NSpaceDimension; ++d)
+    {
+      if (corner & (1u << d))
+      {
+        index[d] += static_cast<IndexValueType>(region.GetSize(d)) - 1;
+      }
+    }
+
+    PointType point;
+    labels->TransformIndexToPhysicalPoint(index, point);
+    for (unsigned int d = 0; d < NSpaceDimension; ++d)
+    {
+      lower[d] = std::min(lower[d], point[d]);
+      upper[d] = std::max(upper[d], point[d]);
+    }
+  }
+
+  SeedPositionsContainer positions;
+  for (const PointType & position : Self::ComputeSeedLattice(lower, upper, spacing))
+  {
+    typename TLabelImage::IndexType index;
+    if (labels->TransformPhysicalPointToIndex(position, index) && labels->GetPixel(index) == label)
+    {
+      positions.push_back(position);
+    }
+  }
+
+  this->SetSeeds(positions);
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+auto
+CellularAggregate<NSpaceDimension, TCoordinate>::ComputeSeedLattice(const PointType & lower, const PointType & upper, double spacing)
+  -> SeedPositionsContainer
+{
+  SeedPositionsContainer positions;
+  if (!(spacing > 0.0))
+  {
+    return positions;
+  }
+
+  // The rows along the first axis are shifted by half a spacing every
+  // other row, and packed closer along the other axes.
+  const double rowSpacing = spacing * std::sqrt(3.0) / 2.0;
+
+  Index<NSpaceDimension> size;
+  for (unsigned int d = 0; d < NSpaceDimension; ++d)
+  {
+    const double step = (d == 0) ? spacing : rowSpacing;
+    size[d] = (upper[d] < lower[d]) ? 0 : static_cast<IndexValueType>(std::floor((upper[d] - lower[d]) / step)) + 1;
+    if (size[d] == 0)
+    {
+      return positions;
+    }
+  }
+
+  Index<NSpaceDimension> index;
+  index.Fill(0);
+  while (index[NSpaceDimension - 1] < size[NSpaceDimension - 1])
+  {
+    IndexValueType rowParity = 0;
+    for (unsigned int d = 1; d < NSpaceDimension; ++d)
+    {
+      rowParity += index[d];
+    }
+
+    PointType position;
+    position[0] = lower[0] + spacing * (static_cast<double>(index[0]) + 0.5 * static_cast<double>(rowParity % 2));
+    for (unsigned int d = 1; d < NSpaceDimension; ++d)
+    {
+      position[d] = lower[d] + rowSpacing * static_cast<double>(index[d]);
+    }
+    if (position[0] <= upper[0])
+    {
+      positions.push_back(position);
+    }
+
+    for (unsigned int d = 0; d < NSpaceDimension; ++d)
+    {
+      if (++index[d] < size[d] || d == NSpaceDimension - 1)
+      {
+        break;
+      }
+      index[d] = 0;
+    }
+  }
+  return positions;
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
 void
-CellularAggregate<NSpaceDimension>::Add(CellBase * cell)
+CellularAggregate<NSpaceDimension, TCoordinate>::Add(CellBase * cell)
 {
   VectorType perturbation;
 
@@ -198,15 +478,93 @@ CellularAggregate<NSpaceDimension>::Add(CellBase * cell)
   this->Add(cell, perturbation);
 }
 
-template <unsigned int NSpaceDimension>
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+CellularAggregate<NSpaceDimension, TCoordinate>::Add(CellBase * cellA, CellBase * cellB, double perturbationLength)
+{
+  itkBioCellPhaseTimerMacro(m_CurrentStatistics, CellularAggregateStatistics::Births);
+  itkBioCellCounterMacro(m_CurrentStatistics, m_Births, 2);
+
+  const VectorType perturbationVector = this->ComputeDivisionPerturbation(perturbationLength);
+
+  this->Add(cellA, perturbationVector);
+  this->Add(cellB, -perturbationVector);
+
+  const IdentifierType cellAId = cellA->GetSelfIdentifier();
+  const IdentifierType cellBId = cellB->GetSelfIdentifier();
+
+  m_NeighborGraph.AddNeighbor(cellAId, cellBId);
+  m_NeighborGraph.AddNeighbor(cellBId, cellAId);
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
 void
-CellularAggregate<NSpaceDimension>::Add(CellBase * cellA, CellBase * cellB, double perturbationLength)
+CellularAggregate<NSpaceDimension, TCoordinate>::Divide(CellBase * mother,
+                                           CellBase * daughterA,
+                                           CellBase * daughterB,
+                                           double     perturbationLength)
+{
+  itkBioCellPhaseTimerMacro(m_CurrentStatistics, CellularAggregateStatistics::Births);
+  itkBioCellCounterMacro(m_CurrentStatistics, m_Births, 2);
+
+  // The mother leaves the aggregate, as in the default division.
+  itkBioCellCounterMacro(m_CurrentStatistics, m_Deaths, 1);
+
+  auto * cellA = dynamic_cast<BioCellType *>(daughterA);
+  auto * cellB = dynamic_cast<BioCellType *>(daughterB);
+  if (mother == nullptr || cellA == nullptr || cellB == nullptr)
+  {
+    itkExceptionMacro(<< "dynamic_cast failed.");
+  }
+
+  const IdentifierType motherId = mother->GetSelfIdentifier();
+  const IdentifierType cellBId = cellB->GetSelfIdentifier();
+
+  PointType position;
+  if (cellA->GetSelfIdentifier() != motherId || !m_Mesh->GetPoint(motherId, &position))
+  {
+    itkExceptionMacro(<< "The first daughter must take over the identifier of the mother " << motherId);
+  }
+
+  const VectorType perturbationVector = this->ComputeDivisionPerturbation(perturbationLength);
+
+  // The first daughter replaces the mother in its slot and keeps its row
+  // of the neighbor graph. The mother is deleted by AdvanceCellCycles().
+  m_Mesh->SetPoint(motherId, position + perturbationVector);
+  m_Mesh->SetPointData(motherId, cellA);
+  m_ActiveCells[motherId] = cellA;
+  cellA->SetCellularAggregate(this);
+
+  m_NeighborGraph.CopyRow(cellBId, motherId);
+  m_Mesh->SetPoint(cellBId, position - perturbationVector);
+  m_Mesh->SetPointData(cellBId, cellB);
+  m_ActiveCells[cellBId] = cellB;
+  cellB->SetCellularAggregate(this);
+
+  // The neighbors of the mother already list the first daughter, so they
+  // are notified once, of the second daughter only.
+  const InlineNeighborList<> neighbors(m_NeighborGraph.Begin(motherId), m_NeighborGraph.End(motherId));
+  for (const IdentifierType neighborId : neighbors)
+  {
+    if (m_NeighborGraph.AddNeighbor(neighborId, cellBId))
+    {
+      this->WakeUp(neighborId);
+    }
+  }
+
+  m_NeighborGraph.AddNeighbor(motherId, cellBId);
+  m_NeighborGraph.AddNeighbor(cellBId, motherId);
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+auto
+CellularAggregate<NSpaceDimension, TCoordinate>::ComputeDivisionPerturbation(double perturbationLength) -> VectorType
 {
   // Create a perturbation for separating the daugther cells
-  typename BioCellType::VectorType perturbationVector;
+  VectorType perturbationVector;
   for (unsigned int d = 0; d < NSpaceDimension; d++)
   {
-    perturbationVector[d] = vnl_sample_uniform(-1.0f, 1.0f);
+    perturbationVector[d] = this->GetUniformVariate(-1.0, 1.0);
   }
 
   const double norm = perturbationVector.GetNorm();
@@ -219,26 +577,12 @@ CellularAggregate<NSpaceDimension>::Add(CellBase * cellA, CellBase * cellB, doub
     // this event should rarely happen... very rarely
     perturbationVector[0] = perturbationLength;
   }
-
-  this->Add(cellA, perturbationVector);
-  this->Add(cellB, -perturbationVector);
-
-  const IdentifierType cellAId = cellA->GetSelfIdentifier();
-  const IdentifierType cellBId = cellB->GetSelfIdentifier();
-
-  VoronoiRegionAutoPointer cellAptr;
-  VoronoiRegionAutoPointer cellBptr;
-
-  this->GetVoronoi(cellAId, cellAptr);
-  this->GetVoronoi(cellBId, cellBptr);
-
-  cellAptr->AddPointId(cellBId);
-  cellBptr->AddPointId(cellAId);
+  return perturbationVector;
 }
 
-template <unsigned int NSpaceDimension>
+template <unsigned int NSpaceDimension, typename TCoordinate>
 void
-CellularAggregate<NSpaceDimension>::Add(CellBase * cellBase, const VectorType & perturbation)
+CellularAggregate<NSpaceDimension, TCoordinate>::Add(CellBase * cellBase, const VectorType & perturbation)
 {
   auto * cell = dynamic_cast<BioCellType *>(cellBase);
   if (cell == nullptr)
@@ -248,15 +592,14 @@ CellularAggregate<NSpaceDimension>::Add(CellBase * cellBase, const VectorType &
   IdentifierType newcellId = cell->GetSelfIdentifier();
   IdentifierType newcellparentId = cell->GetParentIdentifier();
 
-  PointType       position;
-  CellAutoPointer selfVoronoi;
+  PointType position;
 
   // If the cell does not have a parent
   // from which receive a position
   if (!newcellparentId)
   {
     position.Fill(0.0);
-    selfVoronoi.TakeOwnership(new VoronoiRegionType);
+    m_NeighborGraph.BeginRow(newcellId);
   }
   else
   {
@@ -269,264 +612,1414 @@ CellularAggregate<NSpaceDimension>::Add(CellBase * cellBase, const VectorType &
       throw exception;
     }
 
-    VoronoiRegionAutoPointer parentVoronoi;
-    this->GetVoronoi(newcellparentId, parentVoronoi);
-    parentVoronoi->MakeCopy(selfVoronoi);
+    m_NeighborGraph.CopyRow(newcellId, newcellparentId);
   }
 
   position += perturbation;
 
-  m_Mesh->SetCell(newcellId, selfVoronoi);
   m_Mesh->SetPoint(newcellId, position);
   m_Mesh->SetPointData(newcellId, cell);
+  m_ActiveCells[newcellId] = cell;
 
   cell->SetCellularAggregate(this);
 
-  // Add this new cell as neighbor to cells in its neighborhood
-
-  typename VoronoiRegionType::PointIdIterator neighbor = selfVoronoi->PointIdsBegin();
-  typename VoronoiRegionType::PointIdIterator end = selfVoronoi->PointIdsEnd();
-
-  while (neighbor != end)
+  // Add this new cell as neighbor to cells in its neighborhood. Adding
+  // neighbors may move the rows of the graph, so the row is copied first,
+  // on the stack for the usual size of a neighborhood.
+  const InlineNeighborList<> neighbors(m_NeighborGraph.Begin(newcellId), m_NeighborGraph.End(newcellId));
+  for (const IdentifierType neighborId : neighbors)
   {
-    const IdentifierType               neighborId = (*neighbor);
-    typename MeshType::CellAutoPointer cellPointer;
-    bool                               neighborVoronoiExist = m_Mesh->GetCell(neighborId, cellPointer);
-    if (neighborVoronoiExist)
+    if (m_NeighborGraph.AddNeighbor(neighborId, newcellId))
     {
-      auto * region = dynamic_cast<VoronoiRegionType *>(cellPointer.GetPointer());
-
-      if (!region)
-      {
-        std::cerr << "CellularAggregate::Add() Failed to find a region" << std::endl;
-      }
-      else
-      {
-        region->AddPointId(newcellId);
-      }
+      this->WakeUp(neighborId);
     }
-    neighbor++;
   }
 }
 
-template <unsigned int NSpaceDimension>
+template <unsigned int NSpaceDimension, typename TCoordinate>
 void
-CellularAggregate<NSpaceDimension>::AdvanceTimeStep()
+CellularAggregate<NSpaceDimension, TCoordinate>::AdvanceTimeStep()
 {
+  itkBioCellTraceSpanMacro("AdvanceTimeStep", "BioCell");
+
+  m_CurrentStatistics.Reset();
+
+  // The cells may have been modified since the last time step.
+  m_TilesValid = false;
+
   if (m_Iteration % m_ClosestPointComputationInterval == 0)
   {
+    itkBioCellTraceSpanMacro("NeighborSearch", "BioCell");
+    itkBioCellPhaseTimerMacro(m_CurrentStatistics, CellularAggregateStatistics::NeighborSearch);
     this->ComputeClosestPoints();
   }
 
-  this->ComputeForces();
-  this->UpdatePositions();
-
-  CellsIterator begin = m_Mesh->GetPointData()->Begin();
-  CellsIterator end = m_Mesh->GetPointData()->End();
-
-  CellsIterator cell = begin;
-
-  while (cell != end)
+  if (m_SpatialReorderingInterval > 0 && m_Iteration % m_SpatialReorderingInterval == 0)
   {
-    BioCellType * theCell = cell.Value();
-    theCell->AdvanceTimeStep();
-    ++cell;
-    if (theCell->MarkedForRemoval())
-    {
-      this->Remove(theCell);
-    }
+    itkBioCellTraceSpanMacro("SpatialReordering", "BioCell");
+    itkBioCellPhaseTimerMacro(m_CurrentStatistics, CellularAggregateStatistics::NeighborSearch);
+    this->ReorderCellStorage();
   }
 
-  this->InvokeEvent(IterationEvent());
-
-  m_Iteration++;
-}
+  {
+    itkBioCellTraceSpanMacro("Forces", "BioCell");
+    itkBioCellPhaseTimerMacro(m_CurrentStatistics, CellularAggregateStatistics::Forces);
+    this->ComputeForces();
+  }
 
-template <unsigned int NSpaceDimension>
-void
-CellularAggregate<NSpaceDimension>::KillAll()
-{
-  if (!m_Mesh)
   {
-    return;
+    itkBioCellTraceSpanMacro("Positions", "BioCell");
+    itkBioCellPhaseTimerMacro(m_CurrentStatistics, CellularAggregateStatistics::Positions);
+    this->UpdatePositions();
   }
 
-  CellsIterator cell = m_Mesh->GetPointData()->Begin();
-  CellsIterator end = m_Mesh->GetPointData()->End();
+  this->AdvanceCellCycles();
+
+  m_CurrentStatistics.m_NumberOfIterations = 1;
+  m_CurrentStatistics.m_NumberOfCells = m_Mesh->GetNumberOfPoints();
+  m_CurrentStatistics.m_NumberOfSleepingCells = m_SleepingCells.size();
+  m_LastIterationStatistics = m_CurrentStatistics;
+  m_AccumulatedStatistics += m_CurrentStatistics;
 
-  while (cell != end)
   {
-    delete (cell.Value());
-    ++cell;
+    itkBioCellTraceSpanMacro("IterationEvent", "BioCell");
+    this->InvokeEvent(CellularAggregateIterationEvent(&m_LastIterationStatistics));
   }
 
-  BioCellType::ResetCounter();
+  m_Iteration++;
+  m_CellCycleCursor = 0;
 }
 
-template <unsigned int NSpaceDimension>
+template <unsigned int NSpaceDimension, typename TCoordinate>
 void
-CellularAggregate<NSpaceDimension>::ClearForces()
+CellularAggregate<NSpaceDimension, TCoordinate>::AdvanceTimeSteps(SizeValueType numberOfSteps)
 {
-  CellsIterator cell = m_Mesh->GetPointData()->Begin();
-  CellsIterator end = m_Mesh->GetPointData()->End();
-
-  while (cell != end)
+  for (SizeValueType step = 0; step < numberOfSteps; ++step)
   {
-    cell.Value()->ClearForce();
-    ++cell;
+    this->AdvanceTimeStep();
   }
 }
 
-template <unsigned int NSpaceDimension>
+template <unsigned int NSpaceDimension, typename TCoordinate>
 void
-CellularAggregate<NSpaceDimension>::UpdatePositions()
+CellularAggregate<NSpaceDimension, TCoordinate>::AdvanceCellCycles()
 {
-  CellsConstIterator cellIt = m_Mesh->GetPointData()->Begin();
-  CellsConstIterator end = m_Mesh->GetPointData()->End();
+  itkBioCellTraceSpanMacro("CellCycle", "BioCell");
+  itkBioCellPhaseTimerMacro(m_CurrentStatistics, CellularAggregateStatistics::CellCycle);
 
-  PointType position;
+  this->WakeUpExpiredCells();
 
-  position.Fill(0);
+  // Cells are added and removed by the pass.
+  m_TilesValid = false;
 
-  while (cellIt != end)
+  // The daughters added during the pass have larger identifiers than
+  // their mother, so their cycle is also advanced in this pass.
+  auto cell = m_ActiveCells.begin();
+  while (cell != m_ActiveCells.end())
   {
-    BioCellType *  cell = cellIt.Value();
-    IdentifierType cellId = cell->GetSelfIdentifier();
-    m_Mesh->GetPoint(cellId, &position);
-    const VectorType force = cell->GetForce();
-    if (force.GetNorm() > m_FrictionForce)
+    const IdentifierType cellId = cell->first;
+    BioCellType *        theCell = cell->second;
+
+    m_CellCycleCursor = cellId;
+    theCell->AdvanceTimeStep();
+
+    // A cell that died by apoptosis has already been removed.
+    const auto current = m_ActiveCells.find(cellId);
+    if (current != m_ActiveCells.end())
     {
-      position += force / 50.0;
+      if (current->second != theCell)
+      {
+        // The cell divided in place. Its first daughter now holds the
+        // identifier, and starts its cycle in this pass like the second one.
+        delete theCell;
+        cell = current;
+        continue;
+      }
+      if (theCell->MarkedForRemoval())
+      {
+        this->Remove(theCell);
+      }
+      else if (m_UseActiveSet)
+      {
+        this->TryToSleep(cellId, theCell);
+      }
     }
-    m_Mesh->SetPoint(cellId, position);
-    cellIt++;
+    cell = m_ActiveCells.upper_bound(cellId);
   }
+
+  m_CellCycleCursor = NumericTraits<IdentifierType>::max();
 }
 
-template <unsigned int NSpaceDimension>
+template <unsigned int NSpaceDimension, typename TCoordinate>
 void
-CellularAggregate<NSpaceDimension>::ComputeForces()
+CellularAggregate<NSpaceDimension, TCoordinate>::ReorderCellStorage()
 {
-  // Clear all the force accumulators
+  if (m_Mesh->GetNumberOfPoints() < 2)
+  {
+    return;
+  }
+
+  PointsConstIterator pointIt = m_Mesh->GetPoints()->Begin();
+  PointsConstIterator pointEnd = m_Mesh->GetPoints()->End();
+
+  PointType lower = pointIt.Value();
+  PointType upper = pointIt.Value();
+  for (; pointIt != pointEnd; ++pointIt)
+  {
+    const PointType & position = pointIt.Value();
+    for (unsigned int d = 0; d < NSpaceDimension; ++d)
+    {
+      lower[d] = std::min(lower[d], position[d]);
+      upper[d] = std::max(upper[d], position[d]);
+    }
+  }
+
+  double extent = 0.0;
+  for (unsigned int d = 0; d < NSpaceDimension; ++d)
+  {
+    extent = std::max(extent, static_cast<double>(upper[d] - lower[d]));
+  }
+
+  constexpr unsigned int bitsPerCoordinate = std::min(64U / NSpaceDimension, 32U);
+  const double           scale = (extent > 0.0) ? (std::ldexp(1.0, bitsPerCoordinate) - 1.0) / extent : 0.0;
+
+  std::vector<std::pair<std::uint64_t, IdentifierType>> curve;
+  curve.reserve(m_Mesh->GetNumberOfPoints());
+  for (pointIt = m_Mesh->GetPoints()->Begin(); pointIt != pointEnd; ++pointIt)
+  {
+    curve.emplace_back(ComputeMortonCode(pointIt.Value(), lower, scale), pointIt.Index());
+  }
+  std::sort(curve.begin(), curve.end());
+
+  // The new containers are filled before the old ones are released, so that
+  // their elements are allocated in the order of the curve.
+  auto                        points = PointsContainer::New();
+  auto                        pointData = PointDataContainer::New();
+  ActiveCellsContainer        activeCells;
+  std::vector<IdentifierType> order;
+  order.reserve(curve.size());
+
+  for (const auto & element : curve)
+  {
+    const IdentifierType cellId = element.second;
+    order.push_back(cellId);
+
+    PointType position;
+    m_Mesh->GetPoint(cellId, &position);
+    points->InsertElement(cellId, position);
+
+    BioCellType * cell = nullptr;
+    m_Mesh->GetPointData(cellId, &cell);
+    pointData->InsertElement(cellId, cell);
+
+    if (m_ActiveCells.count(cellId))
+    {
+      activeCells.emplace(cellId, cell);
+    }
+  }
+
+  m_Mesh->SetPoints(points);
+  m_Mesh->SetPointData(pointData);
+  m_ActiveCells.swap(activeCells);
+  m_NeighborGraph.Compact(order);
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+std::uint64_t
+CellularAggregate<NSpaceDimension, TCoordinate>::ComputeMortonCode(const PointType & point, const PointType & origin, double scale)
+{
+  constexpr unsigned int bitsPerCoordinate = std::min(64U / NSpaceDimension, 32U);
+
+  std::uint64_t coordinates[NSpaceDimension];
+  for (unsigned int d = 0; d < NSpaceDimension; ++d)
+  {
+    coordinates[d] = static_cast<std::uint64_t>((point[d] - origin[d]) * scale);
+  }
+
+  std::uint64_t code = 0;
+  for (unsigned int bit = 0; bit < bitsPerCoordinate; ++bit)
+  {
+    for (unsigned int d = 0; d < NSpaceDimension; ++d)
+    {
+      code |= ((coordinates[d] >> bit) & 1U) << (bit * NSpaceDimension + d);
+    }
+  }
+  return code;
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+CellularAggregate<NSpaceDimension, TCoordinate>::SetUseActiveSet(bool useActiveSet)
+{
+  if (m_UseActiveSet != useActiveSet)
+  {
+    m_UseActiveSet = useActiveSet;
+    this->WakeUpAllCells();
+    this->Modified();
+  }
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+SizeValueType
+CellularAggregate<NSpaceDimension, TCoordinate>::GetNumberOfSleepingCells() const
+{
+  return m_SleepingCells.size();
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+CellularAggregate<NSpaceDimension, TCoordinate>::WakeUpAllCells()
+{
+  while (!m_SleepingCells.empty())
+  {
+    this->WakeUp(m_SleepingCells.begin()->first);
+  }
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+CellularAggregate<NSpaceDimension, TCoordinate>::WakeUp(IdentifierType cellId)
+{
+  auto sleeping = m_SleepingCells.find(cellId);
+  if (sleeping == m_SleepingCells.end())
+  {
+    return;
+  }
+
+  BioCellType * cell = nullptr;
+  m_Mesh->GetPointData(cellId, &cell);
+  cell->AdvanceQuiescentTimeSteps(this->GetNumberOfSkippedSteps(cellId, sleeping->second.m_SleepIteration));
+
+  m_SleepingCells.erase(sleeping);
+  m_ActiveCells[cellId] = cell;
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+CellularAggregate<NSpaceDimension, TCoordinate>::TryToSleep(IdentifierType cellId, BioCellType * cell)
+{
+  if (!cell->IsQuiescent())
+  {
+    return;
+  }
+
+  // The forces that the cell applies to its neighbors would be lost if
+  // one of them reacted to forces.
+  NeighborGraph::ConstIterator neighbor = m_NeighborGraph.Begin(cellId);
+  NeighborGraph::ConstIterator end = m_NeighborGraph.End(cellId);
+  while (neighbor != end)
+  {
+    BioCellType * neighborCell = nullptr;
+    if (m_Mesh->GetPointData(*neighbor, &neighborCell) && !neighborCell->IgnoresForces())
+    {
+      return;
+    }
+    ++neighbor;
+  }
+
+  // The cell starts growing again once its growth latency has expired.
+  const SizeValueType duration = cell->GetQuiescenceDuration();
+
+  SleepingCell sleepingCell{ m_Iteration, NumericTraits<SizeValueType>::max() };
+  if (duration < NumericTraits<SizeValueType>::max() - m_Iteration)
+  {
+    sleepingCell.m_WakeUpIteration = m_Iteration + duration + 1;
+    m_WakeUpTimers.Schedule(cellId, sleepingCell.m_WakeUpIteration);
+  }
+
+  m_ActiveCells.erase(cellId);
+  m_SleepingCells[cellId] = sleepingCell;
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+CellularAggregate<NSpaceDimension, TCoordinate>::WakeUpExpiredCells()
+{
+  std::vector<IdentifierType> expiredCells;
+  m_WakeUpTimers.Expire(m_Iteration, expiredCells);
+
+  for (const IdentifierType cellId : expiredCells)
+  {
+    // Ignore the timers of the cells that were woken up earlier.
+    auto sleeping = m_SleepingCells.find(cellId);
+    if (sleeping != m_SleepingCells.end() && sleeping->second.m_WakeUpIteration <= m_Iteration)
+    {
+      this->WakeUp(cellId);
+    }
+  }
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+CellularAggregate<NSpaceDimension, TCoordinate>::UpdateCellArrays()
+{
+  // The radii and the colors of the sleeping cells are brought up to date.
+  this->SynchronizeSleepingCells();
+
+  const SizeValueType numberOfCells = m_Mesh->GetNumberOfPoints();
+  m_CellArrayIdentifiers.resize(numberOfCells);
+  m_CellArrayPositions.resize(numberOfCells * SpaceDimension);
+  m_CellArrayRadii.resize(numberOfCells);
+  m_CellArrayColors.resize(numberOfCells * 3);
+  m_CellArrayCycleStates.resize(numberOfCells);
+
+  SizeValueType      index = 0;
+  CellsConstIterator cellIt = m_Mesh->GetPointData()->Begin();
+  for (PointsConstIterator pointIt = m_Mesh->GetPoints()->Begin(); pointIt != m_Mesh->GetPoints()->End();
+       ++pointIt, ++cellIt, ++index)
+  {
+    const BioCellType *                   cell = cellIt.Value();
+    const PointType &                     position = pointIt.Value();
+    const typename BioCellType::ColorType color = cell->GetColor();
+
+    m_CellArrayIdentifiers[index] = pointIt.Index();
+    for (unsigned int d = 0; d < SpaceDimension; ++d)
+    {
+      m_CellArrayPositions[index * SpaceDimension + d] = position[d];
+    }
+    m_CellArrayRadii[index] = cell->GetRadius();
+    for (unsigned int c = 0; c < 3; ++c)
+    {
+      m_CellArrayColors[index * 3 + c] = color[c];
+    }
+    m_CellArrayCycleStates[index] = static_cast<std::uint8_t>(cell->GetCycleState());
+  }
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+CellularAggregate<NSpaceDimension, TCoordinate>::SynchronizeSleepingCells() const
+{
+  for (auto & sleeping : m_SleepingCells)
+  {
+    BioCellType * cell = nullptr;
+    m_Mesh->GetPointData(sleeping.first, &cell);
+
+    const SizeValueType skippedSteps = this->GetNumberOfSkippedSteps(sleeping.first, sleeping.second.m_SleepIteration);
+    cell->AdvanceQuiescentTimeSteps(skippedSteps);
+    sleeping.second.m_SleepIteration += skippedSteps;
+  }
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+SizeValueType
+CellularAggregate<NSpaceDimension, TCoordinate>::GetNumberOfSkippedSteps(IdentifierType cellId, SizeValueType sleepIteration) const
+{
+  // Last iteration in which the cycle of the cell would have been advanced.
+  const SizeValueType lastIteration = (cellId <= m_CellCycleCursor) ? m_Iteration : m_Iteration - 1;
+
+  return lastIteration - sleepIteration;
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+auto
+CellularAggregate<NSpaceDimension, TCoordinate>::Run(const StoppingCriteria & criteria) -> StopConditionEnum
+{
+  if (criteria.m_MaximumNumberOfIterations == 0 && criteria.m_CellCountStableIterations == 0 &&
+      criteria.m_BoundingVolumeStableIterations == 0 && criteria.m_DisplacementTolerance <= 0.0 &&
+      criteria.m_WallClockBudget <= 0.0)
+  {
+    itkExceptionMacro("At least one stopping criterion must be enabled");
+  }
+
+  using ClockType = std::chrono::steady_clock;
+  const ClockType::time_point start = ClockType::now();
+
+  SizeValueType iterations = 0;
+  SizeValueType stableCellCountIterations = 0;
+  SizeValueType stableVolumeIterations = 0;
+  SizeValueType numberOfCells = this->GetNumberOfCells();
+  bool          cellCountChanged = false;
+  double        volume = (criteria.m_BoundingVolumeStableIterations > 0) ? this->ComputeBoundingVolume() : 0.0;
+
+  m_Progress = 0.0f;
+  this->InvokeEvent(StartEvent());
+
+  while (true)
+  {
+    this->AdvanceTimeStep();
+    ++iterations;
+
+    const double elapsed = std::chrono::duration<double>(ClockType::now() - start).count();
+
+    if (criteria.m_CellCountStableIterations > 0)
+    {
+      // The count is only stable once it has changed: before, the cells
+      // are still growing towards their first division.
+      const SizeValueType currentNumberOfCells = this->GetNumberOfCells();
+      cellCountChanged = cellCountChanged || (currentNumberOfCells != numberOfCells);
+      stableCellCountIterations = (currentNumberOfCells == numberOfCells) ? stableCellCountIterations + 1 : 0;
+      numberOfCells = currentNumberOfCells;
+      if (cellCountChanged && stableCellCountIterations >= criteria.m_CellCountStableIterations)
+      {
+        m_StopCondition = StopConditionEnum::StableCellCount;
+        break;
+      }
+    }
+
+    if (criteria.m_BoundingVolumeStableIterations > 0)
+    {
+      const double currentVolume = this->ComputeBoundingVolume();
+      const double change = itk::Math::abs(currentVolume - volume);
+      stableVolumeIterations = (change <= criteria.m_BoundingVolumeTolerance * std::max(volume, currentVolume))
+                                 ? stableVolumeIterations + 1
+                                 : 0;
+      volume = currentVolume;
+      if (stableVolumeIterations >= criteria.m_BoundingVolumeStableIterations)
+      {
+        m_StopCondition = StopConditionEnum::StableBoundingVolume;
+        break;
+      }
+    }
+
+    if (criteria.m_DisplacementTolerance > 0.0 && m_MaximumDisplacement < criteria.m_DisplacementTolerance)
+    {
+      m_StopCondition = StopConditionEnum::SmallDisplacement;
+      break;
+    }
+
+    if (criteria.m_MaximumNumberOfIterations > 0 && iterations >= criteria.m_MaximumNumberOfIterations)
+    {
+      m_StopCondition = StopConditionEnum::MaximumNumberOfIterations;
+      break;
+    }
+
+    if (criteria.m_WallClockBudget > 0.0 && elapsed >= criteria.m_WallClockBudget)
+    {
+      m_StopCondition = StopConditionEnum::WallClockBudget;
+      break;
+    }
+
+    if (criteria.m_ProgressStride > 0 && iterations % criteria.m_ProgressStride == 0)
+    {
+      double progress = 0.0;
+      if (criteria.m_MaximumNumberOfIterations > 0)
+      {
+        progress = static_cast<double>(iterations) / criteria.m_MaximumNumberOfIterations;
+      }
+      if (criteria.m_WallClockBudget > 0.0)
+      {
+        progress = std::max(progress, elapsed / criteria.m_WallClockBudget);
+      }
+      m_Progress = static_cast<float>(std::min(progress, 1.0));
+      this->InvokeEvent(ProgressEvent());
+    }
+  }
+
+  m_Progress = 1.0f;
+  this->InvokeEvent(EndEvent());
+
+  return m_StopCondition;
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+std::string
+CellularAggregate<NSpaceDimension, TCoordinate>::GetStopConditionDescription() const
+{
+  switch (m_StopCondition)
+  {
+    case StopConditionEnum::MaximumNumberOfIterations:
+      return "Maximum number of iterations reached";
+    case StopConditionEnum::StableCellCount:
+      return "Number of cells stable";
+    case StopConditionEnum::StableBoundingVolume:
+      return "Bounding volume of the cells stable";
+    case StopConditionEnum::SmallDisplacement:
+      return "Displacement of the cells below tolerance";
+    case StopConditionEnum::WallClockBudget:
+      return "Wall clock budget exhausted";
+  }
+  return "Unknown stop condition";
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+double
+CellularAggregate<NSpaceDimension, TCoordinate>::ComputeBoundingVolume() const
+{
+  PointsConstIterator point = m_Mesh->GetPoints()->Begin();
+  PointsConstIterator end = m_Mesh->GetPoints()->End();
+
+  if (point == end)
+  {
+    return 0.0;
+  }
+
+  PointType lower = point.Value();
+  PointType upper = point.Value();
+  while (point != end)
+  {
+    const PointType & position = point.Value();
+    for (unsigned int d = 0; d < NSpaceDimension; ++d)
+    {
+      lower[d] = std::min(lower[d], position[d]);
+      upper[d] = std::max(upper[d], position[d]);
+    }
+    ++point;
+  }
+
+  double volume = 1.0;
+  for (unsigned int d = 0; d < NSpaceDimension; ++d)
+  {
+    volume *= upper[d] - lower[d];
+  }
+  return volume;
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+template <typename TMaskImage>
+void
+CellularAggregate<NSpaceDimension, TCoordinate>::RasterizeCells(TMaskImage * mask, typename TMaskImage::PixelType value) const
+{
+  static_assert(TMaskImage::ImageDimension == NSpaceDimension, "The mask must have the space dimension");
+
+  if (mask == nullptr)
+  {
+    itkExceptionMacro(<< "The mask is null");
+  }
+
+  using MaskIndexType = typename TMaskImage::IndexType;
+  using MaskRegionType = typename TMaskImage::RegionType;
+
+  const MaskRegionType region = mask->GetBufferedRegion();
+
+  CellsConstIterator  cell = this->GetPointData()->Begin();
+  PointsConstIterator point = m_Mesh->GetPoints()->Begin();
+  PointsConstIterator end = m_Mesh->GetPoints()->End();
+  for (; point != end; ++point, ++cell)
+  {
+    const PointType & center = point.Value();
+    const double      radius = cell.Value()->GetRadius();
+
+    // Pixels of the mask covered by the bounding box of the cell.
+    MaskIndexType lower;
+    MaskIndexType upper;
+    lower.Fill(NumericTraits<IndexValueType>::max());
+    upper.Fill(NumericTraits<IndexValueType>::NonpositiveMin());
+    for (unsigned int corner = 0; corner < (1u << NSpaceDimension); ++corner)
+    {
+      PointType cornerPoint = center;
+      for (unsigned int d = 0; d < NSpaceDimension; ++d)
+      {
+        cornerPoint[d] += (corner & (1u << d)) ? radius : -radius;
+      }
+
+      MaskIndexType index;
+      mask->TransformPhysicalPointToIndex(cornerPoint, index);
+      for (unsigned int d = 0; d < NSpaceDimension; ++d)
+      {
+        lower[d] = std::min(lower[d], index[d]);
+        upper[d] = std::max(upper[d], index[d]);
+      }
+    }
+
+    MaskRegionType box;
+    bool           overlaps = true;
+    for (unsigned int d = 0; d < NSpaceDimension; ++d)
+    {
+      const IndexValueType first = std::max(lower[d], region.GetIndex(d));
+      const IndexValueType last =
+        std::min(upper[d], region.GetIndex(d) + static_cast<IndexValueType>(region.GetSize(d)) - 1);
+      if (first > last)
+      {
+        overlaps = false;
+        break;
+      }
+      box.SetIndex(d, first);
+      box.SetSize(d, static_cast<SizeValueType>(last - first + 1));
+    }
+    if (!overlaps)
+    {
+      continue;
+    }
+
+    const double                             squaredRadius = radius * radius;
+    ImageRegionIteratorWithIndex<TMaskImage> it(mask, box);
+    for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+    {
+      PointType pixelCenter;
+      mask->TransformIndexToPhysicalPoint(it.GetIndex(), pixelCenter);
+      if (center.SquaredEuclideanDistanceTo(pixelCenter) <= squaredRadius)
+      {
+        it.Set(value);
+      }
+    }
+  }
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+CellularAggregate<NSpaceDimension, TCoordinate>::ResetStatistics()
+{
+  m_LastIterationStatistics.Reset();
+  m_AccumulatedStatistics.Reset();
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+CellularAggregate<NSpaceDimension, TCoordinate>::KillAll()
+{
+  if (!m_Mesh)
+  {
+    return;
+  }
+
+  this->ClearCells();
+
+  BioCellType::ResetCounter();
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+CellularAggregate<NSpaceDimension, TCoordinate>::Reset()
+{
+  this->ClearCells();
+
+  m_Iteration = 0;
+  m_CellCycleCursor = 0;
+  m_MaximumDisplacement = 0.0;
+  m_StopCondition = StopConditionEnum::MaximumNumberOfIterations;
+  m_Progress = 0.0f;
+
+  m_CurrentStatistics.Reset();
+  m_LastIterationStatistics.Reset();
+  m_AccumulatedStatistics.Reset();
+
+  this->Modified();
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+CellularAggregate<NSpaceDimension, TCoordinate>::Reinitialize(const SubstratesVector & substrates)
+{
+  this->Reset();
+  m_Substrates = substrates;
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+CellularAggregate<NSpaceDimension, TCoordinate>::ClearCells()
+{
+  CellsIterator cell = m_Mesh->GetPointData()->Begin();
+  CellsIterator end = m_Mesh->GetPointData()->End();
+
+  while (cell != end)
+  {
+    delete (cell.Value());
+    ++cell;
+  }
+
+  VoronoiIterator region = m_Mesh->GetCells()->Begin();
+  VoronoiIterator regionEnd = m_Mesh->GetCells()->End();
+
+  while (region != regionEnd)
+  {
+    delete (region.Value());
+    ++region;
+  }
+
+  m_Mesh->GetPoints()->Initialize();
+  m_Mesh->GetPointData()->Initialize();
+  m_Mesh->GetCells()->Initialize();
+  m_NeighborGraph.Clear();
+
+  m_ActiveCells.clear();
+  m_SleepingCells.clear();
+  m_WakeUpTimers.Clear();
+
+  m_Tiles.clear();
+  m_TileBoundaries.clear();
+  m_TilesValid = false;
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+CellularAggregate<NSpaceDimension, TCoordinate>::ClearForces()
+{
+  // The sleeping cells ignore forces, their accumulator stays null.
+  for (const auto & cell : m_ActiveCells)
+  {
+    cell.second->ClearForce();
+  }
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+CellularAggregate<NSpaceDimension, TCoordinate>::UpdatePositions()
+{
+  if (m_NumberOfTiles > 1)
+  {
+    this->UpdatePositionsInTiles();
+    return;
+  }
+
+  PointType position;
+
+  position.Fill(0);
+
+  m_MaximumDisplacement = 0.0;
+
+  for (const auto & activeCell : m_ActiveCells)
+  {
+    BioCellType *  cell = activeCell.second;
+    IdentifierType cellId = activeCell.first;
+    m_Mesh->GetPoint(cellId, &position);
+    const VectorType force = cell->GetForce();
+    const double     forceNorm = force.GetNorm();
+    if (forceNorm > m_FrictionForce)
+    {
+      position += force / 50.0;
+      m_MaximumDisplacement = std::max(m_MaximumDisplacement, forceNorm / 50.0);
+    }
+    m_Mesh->SetPoint(cellId, position);
+  }
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+CellularAggregate<NSpaceDimension, TCoordinate>::ComputeForces()
+{
+  if (m_NumberOfTiles > 1)
+  {
+    this->ComputeForcesInTiles();
+    return;
+  }
+
+  // Clear all the force accumulators
   this->ClearForces();
 
-  CellsConstIterator cell1It = m_Mesh->GetPointData()->Begin();
-  CellsConstIterator end = m_Mesh->GetPointData()->End();
+  // compute forces. The neighbors of a sleeping cell ignore forces, so
+  // the sleeping cells have nothing to contribute.
+  for (const auto & activeCell : m_ActiveCells)
+  {
+    const IdentifierType cell1Id = activeCell.first;
+
+    BioCellType * cell1 = activeCell.second;
+
+    PointType position1;
+    position1.Fill(0);
+    m_Mesh->GetPoint(cell1Id, &position1);
+
+    const CoordinateType rA = cell1->GetRadius();
+    const double         growthRadiusLimit = cell1->GetCellParameters().m_GrowthRadiusLimit;
+
+    // The pairs of cells that both ignore forces are skipped, which skips
+    // most of the pairs inside the regions where the chemo attractant is
+    // out of the permissive range.
+    const bool cell1IgnoresForces = cell1->IgnoresForces();
+
+    NeighborGraph::ConstIterator neighbor = m_NeighborGraph.Begin(cell1Id);
+    NeighborGraph::ConstIterator vend = m_NeighborGraph.End(cell1Id);
+
+    while (neighbor != vend)
+    {
+      const IdentifierType cell2Id = (*neighbor);
+
+      BioCellType * cell2 = nullptr;
+      PointType     position2;
+
+      if (!m_Mesh->GetPointData(cell2Id, &cell2))
+      {
+        neighbor++; // if the neigbor has been removed, skip it
+        continue;
+      }
+
+      if (cell1IgnoresForces && cell2->IgnoresForces())
+      {
+        neighbor++;
+        continue;
+      }
+      m_Mesh->GetPoint(cell2Id, &position2);
+
+      const CoordinateType rB = cell2->GetRadius();
+
+      typename BioCellType::VectorType relativePosition = position1 - position2;
+
+      const CoordinateType distance = relativePosition.GetNorm();
+
+      if (distance < rA + rB)
+      {
+        itkBioCellCounterMacro(m_CurrentStatistics, m_PairInteractions, 1);
+      }
+
+      if (distance < (rA + rB) / 2.0)
+      {
+        const CoordinateType             factor = 2.0 * growthRadiusLimit / distance;
+        typename BioCellType::VectorType force = relativePosition * factor;
+        cell1->AddForce(force);
+        cell2->AddForce(-force);
+      }
+      else if (distance < rA + rB)
+      {
+        typename BioCellType::VectorType force = relativePosition;
+        cell1->AddForce(force);
+        cell2->AddForce(-force);
+      }
+
+      neighbor++;
+    }
+  }
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+CellularAggregate<NSpaceDimension, TCoordinate>::ComputeClosestPoints()
+{
+  if (m_NumberOfTiles > 1)
+  {
+    this->ComputeClosestPointsInTiles();
+    return;
+  }
+
+  PointsConstIterator beginPoints = m_Mesh->GetPoints()->Begin();
+  PointsConstIterator endPoints = m_Mesh->GetPoints()->End();
+
+  PointsConstIterator point1It = beginPoints;
+
+  // The graph is rebuilt in bulk, in increasing order of identifier, reusing
+  // the memory of the previous graph.
+  m_NeighborGraph.Clear();
+  m_NeighborGraph.Reserve(m_Mesh->GetNumberOfPoints(), m_NeighborGraph.GetStorageSize());
+
+  while (point1It != endPoints)
+  {
+    PointType position1 = point1It.Value();
+
+    PointsConstIterator point2It = beginPoints;
+
+    BioCellType * cell1 = nullptr;
+
+    IdentifierType cell1Id = point1It.Index();
+    m_Mesh->GetPointData(cell1Id, &cell1);
+    const CoordinateType radius = cell1->GetRadius();
+    const CoordinateType limitDistance = radius * 4;
+
+    m_NeighborGraph.BeginRow(cell1Id);
+
+    while (point2It != endPoints)
+    {
+      if (point2It == point1It)
+      {
+        point2It++;
+        continue;
+      }
+
+      const PointType & position2 = point2It.Value();
+
+      typename BioCellType::VectorType relativePosition = position1 - position2;
+
+      const CoordinateType distance = relativePosition.GetNorm();
+      if (distance < limitDistance)
+      {
+        m_NeighborGraph.PushBack(point2It.Index());
+      }
+      point2It++;
+    }
+
+    itkBioCellCounterMacro(m_CurrentStatistics, m_NeighborListsRebuilt, 1);
+    itkBioCellCounterMacro(m_CurrentStatistics, m_NeighborListEntries, m_NeighborGraph.GetNumberOfNeighbors(cell1Id));
+
+    point1It++;
+  }
+
+  this->WakeUpDisturbedCells();
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+CellularAggregate<NSpaceDimension, TCoordinate>::WakeUpDisturbedCells()
+{
+  // The new lists may bring sleeping cells in contact with cells that react
+  // to forces.
+  std::vector<IdentifierType> awakenedCells;
+  for (const auto & sleeping : m_SleepingCells)
+  {
+    NeighborGraph::ConstIterator neighbor = m_NeighborGraph.Begin(sleeping.first);
+    NeighborGraph::ConstIterator end = m_NeighborGraph.End(sleeping.first);
+    while (neighbor != end)
+    {
+      BioCellType * neighborCell = nullptr;
+      if (m_Mesh->GetPointData(*neighbor, &neighborCell) && !neighborCell->IgnoresForces())
+      {
+        awakenedCells.push_back(sleeping.first);
+        break;
+      }
+      ++neighbor;
+    }
+  }
+  for (const IdentifierType cellId : awakenedCells)
+  {
+    this->WakeUp(cellId);
+  }
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+CellularAggregate<NSpaceDimension, TCoordinate>::SetNumberOfTiles(unsigned int numberOfTiles)
+{
+  numberOfTiles = std::max(numberOfTiles, 1u);
+  if (m_NumberOfTiles == numberOfTiles)
+  {
+    return;
+  }
+  m_NumberOfTiles = numberOfTiles;
+  m_TileBoundaries.clear();
+  m_Tiles.clear();
+  m_TilesValid = false;
+  this->Modified();
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+unsigned int
+CellularAggregate<NSpaceDimension, TCoordinate>::ComputeTileIndex(const PointType & point) const
+{
+  return static_cast<unsigned int>(
+    std::upper_bound(m_TileBoundaries.begin(), m_TileBoundaries.end(), point[m_TileAxis]) - m_TileBoundaries.begin());
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+CellularAggregate<NSpaceDimension, TCoordinate>::BalanceTiles()
+{
+  const PointsContainer * points = m_Mesh->GetPoints();
+
+  PointType lower;
+  PointType upper;
+  lower.Fill(NumericTraits<CoordinateType>::max());
+  upper.Fill(NumericTraits<CoordinateType>::NonpositiveMin());
+  for (PointsConstIterator point = points->Begin(); point != points->End(); ++point)
+  {
+    for (unsigned int d = 0; d < SpaceDimension; ++d)
+    {
+      lower[d] = std::min(lower[d], point.Value()[d]);
+      upper[d] = std::max(upper[d], point.Value()[d]);
+    }
+  }
+
+  m_TileAxis = 0;
+  for (unsigned int d = 1; d < SpaceDimension; ++d)
+  {
+    if (upper[d] - lower[d] > upper[m_TileAxis] - lower[m_TileAxis])
+    {
+      m_TileAxis = d;
+    }
+  }
+
+  // The boundaries are the quantiles of the coordinates along the axis.
+  std::vector<double> coordinates;
+  coordinates.reserve(points->Size());
+  for (PointsConstIterator point = points->Begin(); point != points->End(); ++point)
+  {
+    coordinates.push_back(point.Value()[m_TileAxis]);
+  }
+  std::sort(coordinates.begin(), coordinates.end());
+
+  m_TileBoundaries.assign(m_NumberOfTiles - 1, 0.0);
+  if (!coordinates.empty())
+  {
+    for (unsigned int t = 1; t < m_NumberOfTiles; ++t)
+    {
+      m_TileBoundaries[t - 1] = coordinates[coordinates.size() * t / m_NumberOfTiles];
+    }
+  }
+
+  m_TileBalanceIteration = m_Iteration;
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+CellularAggregate<NSpaceDimension, TCoordinate>::UpdateTiles()
+{
+  if (m_TilesValid)
+  {
+    return;
+  }
+
+  itkBioCellTraceSpanMacro("UpdateTiles", "BioCell");
+
+  if (m_TileBoundaries.size() + 1 != m_NumberOfTiles ||
+      (m_TileRebalancingInterval > 0 && m_Iteration >= m_TileBalanceIteration + m_TileRebalancingInterval))
+  {
+    this->BalanceTiles();
+  }
+
+  m_Tiles.resize(m_NumberOfTiles);
+  for (unsigned int t = 0; t < m_NumberOfTiles; ++t)
+  {
+    Tile & tile = m_Tiles[t];
+    tile.m_Lower = (t > 0) ? m_TileBoundaries[t - 1] : -NumericTraits<double>::infinity();
+    tile.m_Upper = (t + 1 < m_NumberOfTiles) ? m_TileBoundaries[t] : NumericTraits<double>::infinity();
+
+    tile.m_PreviousCells.clear();
+    for (const TileCell & cell : tile.m_Cells)
+    {
+      tile.m_PreviousCells.push_back(cell.m_Identifier);
+    }
+    tile.m_Cells.clear();
+    tile.m_Contributions.resize(m_NumberOfTiles);
+  }
+
+  // The points, the cells and the active cells are all sorted by
+  // identifier, so the cells of each tile are sorted too.
+  const PointsContainer *    points = m_Mesh->GetPoints();
+  const PointDataContainer * cells = m_Mesh->GetPointData();
+
+  PointsConstIterator point = points->Begin();
+  CellsConstIterator  cell = cells->Begin();
+  auto                active = m_ActiveCells.begin();
+  for (; point != points->End(); ++point, ++cell)
+  {
+    const IdentifierType cellId = point.Index();
+    while (active != m_ActiveCells.end() && active->first < cellId)
+    {
+      ++active;
+    }
+    const bool isActive = (active != m_ActiveCells.end() && active->first == cellId);
+
+    const unsigned int tileIndex = this->ComputeTileIndex(point.Value());
+    Tile &             tile = m_Tiles[tileIndex];
+    const CoordinateType radius = cell.Value()->GetRadius();
+    tile.m_Cells.push_back(TileCell{ cellId, cell.Value(), point.Value(), radius, isActive });
+
+    // A cell migrated if another tile owned it before.
+    if (!std::binary_search(tile.m_PreviousCells.begin(), tile.m_PreviousCells.end(), cellId))
+    {
+      for (const Tile & other : m_Tiles)
+      {
+        if (std::binary_search(other.m_PreviousCells.begin(), other.m_PreviousCells.end(), cellId))
+        {
+          itkBioCellCounterMacro(m_CurrentStatistics, m_MigratedCells, 1);
+          break;
+        }
+      }
+    }
+  }
+
+  m_TilesValid = true;
+}
 
-  // compute forces
-  while (cell1It != end)
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+CellularAggregate<NSpaceDimension, TCoordinate>::ComputeClosestPointsInTiles()
+{
+  this->UpdateTiles();
+
+  // The cells of the other tiles closer than the range of the search are
+  // the ghosts of a tile.
+  CoordinateType maximumRadius = 0.0;
+  for (const Tile & tile : m_Tiles)
   {
-    const IdentifierType cell1Id = cell1It.Index();
+    for (const TileCell & cell : tile.m_Cells)
+    {
+      maximumRadius = std::max(maximumRadius, cell.m_Radius);
+    }
+  }
+  const double halo = 4.0 * maximumRadius;
 
-    BioCellType * cell1 = cell1It.Value();
+  m_MultiThreader->ParallelizeArray(
+    0,
+    m_NumberOfTiles,
+    [this, halo](SizeValueType tileIndex) {
+      itkBioCellTraceSpanMacro("NeighborSearchTile", "BioCell");
 
-    PointType position1;
-    position1.Fill(0);
-    m_Mesh->GetPoint(cell1Id, &position1);
+      Tile & tile = m_Tiles[tileIndex];
+      tile.m_Statistics.Reset();
 
-    const double rA = cell1->GetRadius();
+      const double lower = tile.m_Lower - halo;
+      const double upper = tile.m_Upper + halo;
 
-    VoronoiRegionAutoPointer voronoiRegion;
-    this->GetVoronoi(cell1Id, voronoiRegion);
+      tile.m_Candidates.clear();
+      for (const TileCell & cell : tile.m_Cells)
+      {
+        tile.m_Candidates.push_back(&cell);
+      }
+      for (SizeValueType otherIndex = 0; otherIndex < m_NumberOfTiles; ++otherIndex)
+      {
+        const Tile & other = m_Tiles[otherIndex];
+        if (otherIndex == tileIndex || other.m_Upper < lower || other.m_Lower >= upper)
+        {
+          continue;
+        }
+        for (const TileCell & cell : other.m_Cells)
+        {
+          const double coordinate = cell.m_Position[m_TileAxis];
+          if (coordinate >= lower && coordinate < upper)
+          {
+            tile.m_Candidates.push_back(&cell);
+            itkBioCellCounterMacro(tile.m_Statistics, m_GhostCells, 1);
+          }
+        }
+      }
 
-    typename VoronoiRegionType::PointIdIterator neighbor = voronoiRegion->PointIdsBegin();
-    typename VoronoiRegionType::PointIdIterator vend = voronoiRegion->PointIdsEnd();
+      // The neighbors are listed in the order of the sequential search.
+      std::sort(tile.m_Candidates.begin(), tile.m_Candidates.end(), [](const TileCell * a, const TileCell * b) {
+        return a->m_Identifier < b->m_Identifier;
+      });
 
-    while (neighbor != vend)
-    {
-      const IdentifierType cell2Id = (*neighbor);
+      tile.m_RowOffsets.assign(1, 0);
+      tile.m_RowNeighbors.clear();
+      for (const TileCell & cell : tile.m_Cells)
+      {
+        const CoordinateType limitDistance = cell.m_Radius * 4;
+        for (const TileCell * candidate : tile.m_Candidates)
+        {
+          if (candidate == &cell)
+          {
+            continue;
+          }
 
-      BioCellType * cell2 = nullptr;
-      PointType     position2;
+          typename BioCellType::VectorType relativePosition = cell.m_Position - candidate->m_Position;
 
-      if (!m_Mesh->GetPoint(cell2Id, &position2))
-      {
-        neighbor++; // if the neigbor has been removed, skip it
-        continue;
+          const CoordinateType distance = relativePosition.GetNorm();
+          if (distance < limitDistance)
+          {
+            tile.m_RowNeighbors.push_back(candidate->m_Identifier);
+          }
+        }
+        tile.m_RowOffsets.push_back(tile.m_RowNeighbors.size());
       }
-      m_Mesh->GetPointData(cell2Id, &cell2);
+    },
+    nullptr);
 
-      const double rB = cell2->GetRadius();
-
-      typename BioCellType::VectorType relativePosition = position1 - position2;
+  // The rows of the tiles are merged in increasing order of identifier.
+  SizeValueType numberOfCells = 0;
+  SizeValueType numberOfNeighbors = 0;
+  for (const Tile & tile : m_Tiles)
+  {
+    numberOfCells += tile.m_Cells.size();
+    numberOfNeighbors += tile.m_RowNeighbors.size();
+    itkBioCellCounterMacro(m_CurrentStatistics, m_GhostCells, tile.m_Statistics.m_GhostCells);
+  }
 
-      const double distance = relativePosition.GetNorm();
+  m_NeighborGraph.Clear();
+  m_NeighborGraph.Reserve(numberOfCells, numberOfNeighbors);
 
-      if (distance < (rA + rB) / 2.0)
-      {
-        const double                     factor = 2.0 * BioCellType::GetGrowthRadiusLimit() / distance;
-        typename BioCellType::VectorType force = relativePosition * factor;
-        cell1->AddForce(force);
-        cell2->AddForce(-force);
-      }
-      else if (distance < rA + rB)
+  std::vector<SizeValueType> rows(m_NumberOfTiles, 0);
+  for (SizeValueType i = 0; i < numberOfCells; ++i)
+  {
+    unsigned int next = m_NumberOfTiles;
+    for (unsigned int t = 0; t < m_NumberOfTiles; ++t)
+    {
+      if (rows[t] < m_Tiles[t].m_Cells.size() &&
+          (next == m_NumberOfTiles ||
+           m_Tiles[t].m_Cells[rows[t]].m_Identifier < m_Tiles[next].m_Cells[rows[next]].m_Identifier))
       {
-        typename BioCellType::VectorType force = relativePosition;
-        cell1->AddForce(force);
-        cell2->AddForce(-force);
+        next = t;
       }
+    }
 
-      neighbor++;
+    const Tile &        tile = m_Tiles[next];
+    const SizeValueType row = rows[next]++;
+
+    m_NeighborGraph.BeginRow(tile.m_Cells[row].m_Identifier);
+    for (SizeValueType k = tile.m_RowOffsets[row]; k < tile.m_RowOffsets[row + 1]; ++k)
+    {
+      m_NeighborGraph.PushBack(tile.m_RowNeighbors[k]);
     }
 
-    cell1It++;
+    itkBioCellCounterMacro(m_CurrentStatistics, m_NeighborListsRebuilt, 1);
+    itkBioCellCounterMacro(
+      m_CurrentStatistics, m_NeighborListEntries, tile.m_RowOffsets[row + 1] - tile.m_RowOffsets[row]);
+  }
+
+  // The cells woken up are now active in their tile.
+  const SizeValueType numberOfSleepingCells = m_SleepingCells.size();
+  this->WakeUpDisturbedCells();
+  if (m_SleepingCells.size() != numberOfSleepingCells)
+  {
+    m_TilesValid = false;
   }
 }
 
-template <unsigned int NSpaceDimension>
+template <unsigned int NSpaceDimension, typename TCoordinate>
 void
-CellularAggregate<NSpaceDimension>::ComputeClosestPoints()
+CellularAggregate<NSpaceDimension, TCoordinate>::ComputeForcesInTiles()
 {
-  PointsConstIterator beginPoints = m_Mesh->GetPoints()->Begin();
-  PointsConstIterator endPoints = m_Mesh->GetPoints()->End();
+  this->UpdateTiles();
 
-  PointsConstIterator point1It = beginPoints;
+  // Clear the force accumulators.
+  m_MultiThreader->ParallelizeArray(
+    0,
+    m_NumberOfTiles,
+    [this](SizeValueType tileIndex) {
+      itkBioCellTraceSpanMacro("ClearForcesTile", "BioCell");
 
-  while (point1It != endPoints)
-  {
-    PointType position1 = point1It.Value();
+      for (const TileCell & cell : m_Tiles[tileIndex].m_Cells)
+      {
+        if (cell.m_Active)
+        {
+          cell.m_Cell->ClearForce();
+        }
+      }
+    },
+    nullptr);
+
+  // Each tile computes the forces of the pairs of its active cells, as the
+  // sequential pass does, and sends the forces of its neighbors to the
+  // tiles that own them.
+  m_MultiThreader->ParallelizeArray(
+    0,
+    m_NumberOfTiles,
+    [this](SizeValueType tileIndex) {
+      itkBioCellTraceSpanMacro("ForcesTile", "BioCell");
+
+      Tile & tile = m_Tiles[tileIndex];
+      tile.m_Statistics.Reset();
+      for (auto & contributions : tile.m_Contributions)
+      {
+        contributions.clear();
+      }
 
-    PointsConstIterator point2It = beginPoints;
+      for (const TileCell & tileCell : tile.m_Cells)
+      {
+        if (!tileCell.m_Active)
+        {
+          continue;
+        }
 
-    BioCellType * cell1 = nullptr;
+        const IdentifierType cell1Id = tileCell.m_Identifier;
+        BioCellType *        cell1 = tileCell.m_Cell;
+        const PointType &    position1 = tileCell.m_Position;
 
-    IdentifierType cell1Id = point1It.Index();
-    m_Mesh->GetPointData(cell1Id, &cell1);
-    const double radius = cell1->GetRadius();
-    const double limitDistance = radius * 4.0;
+        const CoordinateType rA = cell1->GetRadius();
+        const double         growthRadiusLimit = cell1->GetCellParameters().m_GrowthRadiusLimit;
+        const bool           cell1IgnoresForces = cell1->IgnoresForces();
 
-    VoronoiRegionAutoPointer voronoiRegion;
-    this->GetVoronoi(cell1Id, voronoiRegion);
+        NeighborGraph::ConstIterator neighbor = m_NeighborGraph.Begin(cell1Id);
+        NeighborGraph::ConstIterator vend = m_NeighborGraph.End(cell1Id);
 
-    voronoiRegion->ClearPoints();
+        for (; neighbor != vend; ++neighbor)
+        {
+          const IdentifierType cell2Id = (*neighbor);
 
-    while (point2It != endPoints)
-    {
-      if (point2It == point1It)
+          BioCellType * cell2 = nullptr;
+          PointType     position2;
+
+          if (!m_Mesh->GetPointData(cell2Id, &cell2))
+          {
+            continue;
+          }
+
+          if (cell1IgnoresForces && cell2->IgnoresForces())
+          {
+            continue;
+          }
+          m_Mesh->GetPoint(cell2Id, &position2);
+
+          const CoordinateType rB = cell2->GetRadius();
+
+          typename BioCellType::VectorType relativePosition = position1 - position2;
+
+          const CoordinateType distance = relativePosition.GetNorm();
+
+          if (distance < rA + rB)
+          {
+            itkBioCellCounterMacro(tile.m_Statistics, m_PairInteractions, 1);
+          }
+
+          typename BioCellType::VectorType force;
+          if (distance < (rA + rB) / 2.0)
+          {
+            const CoordinateType factor = 2.0 * growthRadiusLimit / distance;
+            force = relativePosition * factor;
+          }
+          else if (distance < rA + rB)
+          {
+            force = relativePosition;
+          }
+          else
+          {
+            continue;
+          }
+          tile.m_Contributions[tileIndex].push_back(ForceContribution{ cell1Id, cell1Id, cell1, force });
+          tile.m_Contributions[this->ComputeTileIndex(position2)].push_back(
+            ForceContribution{ cell2Id, cell1Id, cell2, -force });
+        }
+      }
+    },
+    nullptr);
+
+  // Each tile accumulates the forces of its cells in the order of the
+  // sequential pass, so that the sums are rounded the same way.
+  m_MultiThreader->ParallelizeArray(
+    0,
+    m_NumberOfTiles,
+    [this](SizeValueType tileIndex) {
+      itkBioCellTraceSpanMacro("AccumulateForcesTile", "BioCell");
+
+      Tile & tile = m_Tiles[tileIndex];
+      tile.m_IncomingContributions.clear();
+      for (const Tile & source : m_Tiles)
       {
-        point2It++;
-        continue;
+        tile.m_IncomingContributions.insert(tile.m_IncomingContributions.end(),
+                                            source.m_Contributions[tileIndex].begin(),
+                                            source.m_Contributions[tileIndex].end());
+      }
+      std::stable_sort(tile.m_IncomingContributions.begin(),
+                       tile.m_IncomingContributions.end(),
+                       [](const ForceContribution & a, const ForceContribution & b) {
+                         return a.m_Target < b.m_Target || (a.m_Target == b.m_Target && a.m_Source < b.m_Source);
+                       });
+      for (const ForceContribution & contribution : tile.m_IncomingContributions)
+      {
+        contribution.m_TargetCell->AddForce(contribution.m_Force);
       }
+    },
+    nullptr);
 
-      const PointType & position2 = point2It.Value();
+  for (unsigned int t = 0; t < m_NumberOfTiles; ++t)
+  {
+    itkBioCellCounterMacro(m_CurrentStatistics, m_PairInteractions, m_Tiles[t].m_Statistics.m_PairInteractions);
+  }
+}
 
-      typename BioCellType::VectorType relativePosition = position1 - position2;
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+CellularAggregate<NSpaceDimension, TCoordinate>::UpdatePositionsInTiles()
+{
+  this->UpdateTiles();
 
-      const double distance = relativePosition.GetNorm();
-      if (distance < limitDistance)
+  // The tiles only modify the values of the container, not its structure.
+  auto & points = m_Mesh->GetPoints()->CastToSTLContainer();
+
+  m_MultiThreader->ParallelizeArray(
+    0,
+    m_NumberOfTiles,
+    [this, &points](SizeValueType tileIndex) {
+      itkBioCellTraceSpanMacro("PositionsTile", "BioCell");
+
+      Tile & tile = m_Tiles[tileIndex];
+      tile.m_MaximumDisplacement = 0.0;
+      for (const TileCell & tileCell : tile.m_Cells)
       {
-        voronoiRegion->AddPointId(point2It.Index());
+        if (!tileCell.m_Active)
+        {
+          continue;
+        }
+        PointType        position = tileCell.m_Position;
+        const VectorType force = tileCell.m_Cell->GetForce();
+        const double     forceNorm = force.GetNorm();
+        if (forceNorm > m_FrictionForce)
+        {
+          position += force / 50.0;
+          tile.m_MaximumDisplacement = std::max(tile.m_MaximumDisplacement, forceNorm / 50.0);
+        }
+        points.find(tileCell.m_Identifier)->second = position;
       }
-      point2It++;
-    }
+    },
+    nullptr);
 
-    point1It++;
+  m_MaximumDisplacement = 0.0;
+  for (const Tile & tile : m_Tiles)
+  {
+    m_MaximumDisplacement = std::max(m_MaximumDisplacement, tile.m_MaximumDisplacement);
   }
+
+  m_TilesValid = false;
 }
 
-template <unsigned int NSpaceDimension>
+template <unsigned int NSpaceDimension, typename TCoordinate>
 void
-CellularAggregate<NSpaceDimension>::DumpContent(std::ostream & os) const
+CellularAggregate<NSpaceDimension, TCoordinate>::DumpContent(std::ostream & os) const
 {
   CellsConstIterator beginCell = m_Mesh->GetPointData()->Begin();
   CellsConstIterator endCell = m_Mesh->GetPointData()->End();
@@ -556,10 +2049,8 @@ CellularAggregate<NSpaceDimension>::DumpContent(std::ostream & os) const
   cell1It = beginCell;
   while (cell1It != endCell)
   {
-    VoronoiRegionAutoPointer voronoiRegion;
-    this->GetVoronoi(cell1It.Index(), voronoiRegion);
-    typename VoronoiRegionType::PointIdIterator neighbor = voronoiRegion->PointIdsBegin();
-    typename VoronoiRegionType::PointIdIterator end = voronoiRegion->PointIdsEnd();
+    NeighborGraph::ConstIterator neighbor = m_NeighborGraph.Begin(cell1It.Index());
+    NeighborGraph::ConstIterator end = m_NeighborGraph.End(cell1It.Index());
 
     while (neighbor != end)
     {
@@ -572,25 +2063,369 @@ CellularAggregate<NSpaceDimension>::DumpContent(std::ostream & os) const
   }
 }
 
-template <unsigned int NSpaceDimension>
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+CellularAggregate<NSpaceDimension, TCoordinate>::WriteCheckpoint(const std::string & fileName) const
+{
+  std::ofstream ofs(fileName.c_str(), std::ios::out | std::ios::binary);
+  if (!ofs)
+  {
+    itkExceptionMacro("Unable to open checkpoint file " << fileName << " for writing");
+  }
+
+  this->WriteCheckpoint(ofs);
+
+  ofs.close();
+  if (!ofs)
+  {
+    itkExceptionMacro("Failed to write checkpoint file " << fileName);
+  }
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+CellularAggregate<NSpaceDimension, TCoordinate>::WriteCheckpoint(std::ostream & os) const
+{
+  // Apply the steps skipped by the sleeping cells.
+  this->SynchronizeSleepingCells();
+
+  const SizeValueType numberOfCells = this->GetNumberOfCells();
+
+  std::vector<CheckpointCellRecord> records(numberOfCells);
+  std::vector<std::uint64_t>        neighborOffsets(numberOfCells + 1, 0);
+  std::vector<std::uint64_t>        neighbors;
+
+  CellsConstIterator cellIt = m_Mesh->GetPointData()->Begin();
+  CellsConstIterator end = m_Mesh->GetPointData()->End();
+
+  SizeValueType index = 0;
+  while (cellIt != end)
+  {
+    const IdentifierType cellId = cellIt.Index();
+    const BioCellType *  cell = cellIt.Value();
+
+    PointType position;
+    position.Fill(0.0);
+    m_Mesh->GetPoint(cellId, &position);
+
+    FillCheckpointRecord(cellId, cell, position, records[index]);
+
+    NeighborGraph::ConstIterator neighbor = m_NeighborGraph.Begin(cellId);
+    NeighborGraph::ConstIterator vend = m_NeighborGraph.End(cellId);
+    while (neighbor != vend)
+    {
+      neighbors.push_back(*neighbor);
+      ++neighbor;
+    }
+    neighborOffsets[index + 1] = neighbors.size();
+
+    ++index;
+    ++cellIt;
+  }
+
+  std::ostringstream randomGeneratorState;
+  randomGeneratorState << this->GetRandomGenerator();
+  const std::string randomState = randomGeneratorState.str();
+
+  CheckpointHeader header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.m_Signature, "BIOCELL", 8);
+  header.m_Version = 1;
+  header.m_SpaceDimension = NSpaceDimension;
+  header.m_RecordSize = sizeof(CheckpointCellRecord);
+  header.m_ByteOrderMark = 0x01020304;
+  header.m_NumberOfCells = numberOfCells;
+  header.m_NumberOfNeighbors = neighbors.size();
+  header.m_Iteration = m_Iteration;
+  header.m_ClosestPointComputationInterval = m_ClosestPointComputationInterval;
+  header.m_CellCounter = BioCellType::GetThreadParameters()->m_Counter;
+  header.m_RandomGeneratorStateLength = randomState.size();
+  header.m_FrictionForce = m_FrictionForce;
+
+  // Fixed size sections first, so that they can be mapped directly.
+  os.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  os.write(reinterpret_cast<const char *>(records.data()),
+           static_cast<std::streamsize>(records.size() * sizeof(CheckpointCellRecord)));
+  os.write(reinterpret_cast<const char *>(neighborOffsets.data()),
+           static_cast<std::streamsize>(neighborOffsets.size() * sizeof(std::uint64_t)));
+  os.write(reinterpret_cast<const char *>(neighbors.data()),
+           static_cast<std::streamsize>(neighbors.size() * sizeof(std::uint64_t)));
+
+  // Variable size sections
+  os.write(randomState.data(), static_cast<std::streamsize>(randomState.size()));
+
+  for (cellIt = m_Mesh->GetPointData()->Begin(); cellIt != end; ++cellIt)
+  {
+    WriteCheckpointGenomes(cellIt.Value(), os);
+  }
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+CellularAggregate<NSpaceDimension, TCoordinate>::FillCheckpointRecord(IdentifierType         cellId,
+                                                         const BioCellType *    cell,
+                                                         const PointType &      position,
+                                                         CheckpointCellRecord & record)
+{
+  std::memset(&record, 0, sizeof(record));
+
+  record.m_SelfIdentifier = cellId;
+  record.m_ParentIdentifier = cell->m_ParentIdentifier;
+  record.m_Generation = cell->m_Generation;
+  record.m_GrowthLatencyTime = cell->m_GrowthLatencyTime;
+  record.m_DivisionLatencyTime = cell->m_DivisionLatencyTime;
+  for (unsigned int d = 0; d < NSpaceDimension; ++d)
+  {
+    record.m_Position[d] = position[d];
+    record.m_Force[d] = cell->m_Force[d];
+  }
+  record.m_Radius = cell->m_Radius;
+  record.m_Pressure = cell->m_Pressure;
+  record.m_EnergyReserveLevel = cell->m_EnergyReserveLevel;
+  record.m_NutrientsReserveLevel = cell->m_NutrientsReserveLevel;
+  record.m_ChemoAttractantLevel = cell->m_ChemoAttractantLevel;
+  const typename BioCellType::ColorType color = cell->GetColor();
+  record.m_Color[0] = color.GetRed();
+  record.m_Color[1] = color.GetGreen();
+  record.m_Color[2] = color.GetBlue();
+  record.m_CycleState = static_cast<std::uint32_t>(cell->m_CycleState);
+  record.m_MarkedForRemoval = cell->m_MarkedForRemoval;
+  record.m_ScheduleApoptosis = cell->m_ScheduleApoptosis;
+  record.m_HasGenome = (cell->m_Genome != nullptr);
+  record.m_HasGenomeCopy = (cell->m_GenomeCopy != nullptr);
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+CellularAggregate<NSpaceDimension, TCoordinate>::WriteCheckpointGenomes(const BioCellType * cell, std::ostream & os)
+{
+  if (cell->m_Genome)
+  {
+    cell->m_Genome->WriteBinary(os);
+  }
+  if (cell->m_GenomeCopy)
+  {
+    cell->m_GenomeCopy->WriteBinary(os);
+  }
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+auto
+CellularAggregate<NSpaceDimension, TCoordinate>::CreateCellFromCheckpointRecord(const CheckpointCellRecord & record,
+                                                                   std::istream &               is) -> BioCellType *
+{
+  std::unique_ptr<BioCellType> cell(new BioCellType);
+
+  cell->m_ParentIdentifier = record.m_ParentIdentifier;
+  cell->m_Generation = record.m_Generation;
+  cell->m_GrowthLatencyTime = record.m_GrowthLatencyTime;
+  cell->m_DivisionLatencyTime = record.m_DivisionLatencyTime;
+  for (unsigned int d = 0; d < NSpaceDimension; ++d)
+  {
+    cell->m_Force[d] = record.m_Force[d];
+  }
+  cell->m_Radius = record.m_Radius;
+  cell->m_Pressure = record.m_Pressure;
+  cell->m_EnergyReserveLevel = record.m_EnergyReserveLevel;
+  cell->m_NutrientsReserveLevel = record.m_NutrientsReserveLevel;
+  cell->SetChemoAttractantLevel(record.m_ChemoAttractantLevel);
+  // The color is computed from the chemo attractant level.
+  cell->m_CycleState = static_cast<typename BioCellType::CellCycleState>(record.m_CycleState);
+  cell->m_MarkedForRemoval = record.m_MarkedForRemoval != 0;
+  cell->m_ScheduleApoptosis = record.m_ScheduleApoptosis != 0;
+
+  if (record.m_HasGenome)
+  {
+    cell->m_Genome = new typename BioCellType::GenomeType;
+    cell->m_Genome->ReadBinary(is);
+  }
+  if (record.m_HasGenomeCopy)
+  {
+    cell->m_GenomeCopy = new typename BioCellType::GenomeType;
+    cell->m_GenomeCopy->ReadBinary(is);
+  }
+  return cell.release();
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+CellularAggregate<NSpaceDimension, TCoordinate>::InsertCell(BioCellType * cell, const PointType & position)
+{
+  const IdentifierType cellId = cell->GetSelfIdentifier();
+  if (m_NeighborGraph.HasRow(cellId))
+  {
+    itkExceptionMacro(<< "Cell " << cellId << " already exists");
+  }
+
+  m_NeighborGraph.BeginRow(cellId);
+  m_Mesh->SetPoint(cellId, position);
+  m_Mesh->SetPointData(cellId, cell);
+  m_ActiveCells[cellId] = cell;
+  cell->SetCellularAggregate(this);
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+CellularAggregate<NSpaceDimension, TCoordinate>::ReadCheckpoint(const std::string & fileName)
+{
+  std::ifstream ifs(fileName.c_str(), std::ios::in | std::ios::binary);
+  if (!ifs)
+  {
+    itkExceptionMacro("Unable to open checkpoint file " << fileName << " for reading");
+  }
+
+  this->ReadCheckpoint(ifs);
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+CellularAggregate<NSpaceDimension, TCoordinate>::ReadCheckpoint(std::istream & is)
+{
+  CheckpointHeader header;
+  is.read(reinterpret_cast<char *>(&header), sizeof(header));
+
+  if (!is || std::memcmp(header.m_Signature, "BIOCELL", 8) != 0)
+  {
+    itkExceptionMacro("The stream does not contain a CellularAggregate checkpoint");
+  }
+  if (header.m_Version != 1 || header.m_ByteOrderMark != 0x01020304 ||
+      header.m_RecordSize != sizeof(CheckpointCellRecord))
+  {
+    itkExceptionMacro("Unsupported checkpoint version or byte order");
+  }
+  if (header.m_SpaceDimension != NSpaceDimension)
+  {
+    itkExceptionMacro("The checkpoint has dimension " << header.m_SpaceDimension << " instead of "
+                                                      << NSpaceDimension);
+  }
+
+  std::vector<CheckpointCellRecord> records;
+  std::vector<std::uint64_t>        neighborOffsets;
+  std::vector<std::uint64_t>        neighbors;
+  std::vector<char>                 randomState;
+
+  // The number of offsets does not overflow once the records have been read.
+  if (!ReadCheckpointSection(is, header.m_NumberOfCells, records) ||
+      !ReadCheckpointSection(is, header.m_NumberOfCells + 1, neighborOffsets) ||
+      !ReadCheckpointSection(is, header.m_NumberOfNeighbors, neighbors) ||
+      !ReadCheckpointSection(is, header.m_RandomGeneratorStateLength, randomState))
+  {
+    itkExceptionMacro("Truncated checkpoint");
+  }
+
+  const SizeValueType numberOfCells = records.size();
+
+  // The neighbor list of the cell i is [offsets[i], offsets[i+1]).
+  bool validOffsets = (neighborOffsets.front() == 0 && neighborOffsets.back() == neighbors.size());
+  for (SizeValueType index = 0; validOffsets && index < numberOfCells; ++index)
+  {
+    validOffsets = (neighborOffsets[index] <= neighborOffsets[index + 1]);
+  }
+  if (!validOffsets)
+  {
+    itkExceptionMacro("Corrupted neighbor lists in checkpoint");
+  }
+
+  // Rebuild the cells before touching the aggregate, so that
+  // a corrupted checkpoint leaves the aggregate unchanged.
+  std::vector<std::unique_ptr<BioCellType>> cells(numberOfCells);
+  for (SizeValueType index = 0; index < numberOfCells; ++index)
+  {
+    cells[index].reset(CreateCellFromCheckpointRecord(records[index], is));
+    cells[index]->m_SelfIdentifier = records[index].m_SelfIdentifier;
+  }
+
+  RandomGeneratorType randomGenerator;
+  std::istringstream  randomGeneratorState(std::string(randomState.begin(), randomState.end()));
+  randomGeneratorState >> randomGenerator;
+  if (!randomGeneratorState)
+  {
+    itkExceptionMacro("Invalid random generator state in checkpoint");
+  }
+
+  this->ClearCells();
+  this->GetRandomGenerator() = randomGenerator;
+
+  m_NeighborGraph.Reserve(numberOfCells, neighbors.size());
+  for (SizeValueType index = 0; index < numberOfCells; ++index)
+  {
+    const CheckpointCellRecord & record = records[index];
+    const auto                   cellId = static_cast<IdentifierType>(record.m_SelfIdentifier);
+
+    PointType position;
+    for (unsigned int d = 0; d < NSpaceDimension; ++d)
+    {
+      position[d] = record.m_Position[d];
+    }
+
+    m_NeighborGraph.BeginRow(cellId);
+    for (std::uint64_t n = neighborOffsets[index]; n < neighborOffsets[index + 1]; ++n)
+    {
+      m_NeighborGraph.PushBack(static_cast<IdentifierType>(neighbors[n]));
+    }
+
+    m_Mesh->SetPoint(cellId, position);
+
+    BioCellType * cell = cells[index].release();
+    m_Mesh->SetPointData(cellId, cell);
+    m_ActiveCells[cellId] = cell;
+    cell->SetCellularAggregate(this);
+  }
+
+  m_Iteration = header.m_Iteration;
+  m_ClosestPointComputationInterval = header.m_ClosestPointComputationInterval;
+  m_FrictionForce = header.m_FrictionForce;
+  BioCellType::GetThreadParameters()->m_Counter = header.m_CellCounter;
+
+  this->Modified();
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+template <typename TElement>
+bool
+CellularAggregate<NSpaceDimension, TCoordinate>::ReadCheckpointSection(std::istream &          is,
+                                                          std::uint64_t           numberOfElements,
+                                                          std::vector<TElement> & elements)
+{
+  constexpr std::uint64_t blockSize = 65536;
+
+  elements.clear();
+  while (elements.size() < numberOfElements)
+  {
+    const SizeValueType begin = elements.size();
+    const auto          length = static_cast<SizeValueType>(std::min(blockSize, numberOfElements - begin));
+    elements.resize(begin + length);
+    if (!is.read(reinterpret_cast<char *>(elements.data() + begin),
+                 static_cast<std::streamsize>(length * sizeof(TElement))))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
 void
-CellularAggregate<NSpaceDimension>::AddSubstrate(SubstrateType * substrate)
+CellularAggregate<NSpaceDimension, TCoordinate>::AddSubstrate(SubstrateType * substrate)
 {
   SubstratePointer smartPointer(substrate);
 
   m_Substrates.push_back(smartPointer);
+
+  // The chemoattractant levels may change.
+  this->WakeUpAllCells();
 }
 
-template <unsigned int NSpaceDimension>
-typename CellularAggregate<NSpaceDimension>::SubstratesVector &
-CellularAggregate<NSpaceDimension>::GetSubstrates()
+template <unsigned int NSpaceDimension, typename TCoordinate>
+typename CellularAggregate<NSpaceDimension, TCoordinate>::SubstratesVector &
+CellularAggregate<NSpaceDimension, TCoordinate>::GetSubstrates()
 {
   return m_Substrates;
 }
 
-template <unsigned int NSpaceDimension>
-typename CellularAggregate<NSpaceDimension>::SubstrateValueType
-CellularAggregate<NSpaceDimension>::GetSubstrateValue(IdentifierType cellId, unsigned int substrateId) const
+template <unsigned int NSpaceDimension, typename TCoordinate>
+typename CellularAggregate<NSpaceDimension, TCoordinate>::SubstrateValueType
+CellularAggregate<NSpaceDimension, TCoordinate>::GetSubstrateValue(IdentifierType cellId, unsigned int substrateId) const
 {
   PointType cellPosition;
   bool      cellPositionExists = m_Mesh->GetPoint(cellId, &cellPosition);
@@ -602,6 +2437,8 @@ CellularAggregate<NSpaceDimension>::GetSubstrateValue(IdentifierType cellId, uns
     return itk::NumericTraits<SubstrateValueType>::ZeroValue();
   }
 
+  itkBioCellCounterMacro(m_CurrentStatistics, m_SubstrateSamples, 1);
+
   SubstratePointer substrate = m_Substrates[substrateId];
 
   typename SubstrateType::IndexType index;
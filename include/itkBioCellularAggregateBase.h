@@ -24,6 +24,8 @@
 #include "itkObjectFactory.h"
 #include "BioCellExport.h"
 
+#include <random>
+
 namespace itk
 {
 namespace bio
@@ -59,6 +61,12 @@ public:
   using ImagePixelType = float;
   using SubstrateValueType = ImagePixelType;
 
+  /** Random number generator used for all the stochastic decisions taken
+   *  during the simulation. Its state is part of the aggregate, so that a
+   *  simulation restored from a checkpoint reproduces the original run. */
+  using RandomGeneratorType = std::mt19937;
+  using RandomSeedType = RandomGeneratorType::result_type;
+
 public:
   virtual void
   Add(CellBase * cellA, CellBase * cellB, double perturbationLength);
@@ -66,12 +74,45 @@ public:
   virtual void
   Remove(CellBase * cell);
 
+  /** Register the daughters of a division. The first daughter takes over
+   *  the identifier, the position and the neighbors of the mother, which
+   *  is then deleted by the aggregate, and only the second daughter is
+   *  inserted as a new cell. */
+  virtual void
+  Divide(CellBase * mother, CellBase * daughterA, CellBase * daughterB, double perturbationLength);
+
+  /** When UseInPlaceMitosis is on, dividing cells call Divide() instead of
+   *  adding two new daughters with Add() and removing themselves. Off by
+   *  default, because the identifiers of the cells differ from the ones
+   *  of the default division. */
+  itkSetMacro(UseInPlaceMitosis, bool);
+  itkGetConstMacro(UseInPlaceMitosis, bool);
+  itkBooleanMacro(UseInPlaceMitosis);
+
   virtual SubstrateValueType
   GetSubstrateValue(IdentifierType cellId, unsigned int substrateId) const;
 
+  /** Reinitialize the random number generator with a given seed. */
+  void
+  SetRandomSeed(RandomSeedType seed);
+
+  /** Return a sample from a uniform distribution in [lower, upper). */
+  double
+  GetUniformVariate(double lower, double upper);
+
+  RandomGeneratorType &
+  GetRandomGenerator();
+
+  const RandomGeneratorType &
+  GetRandomGenerator() const;
+
 protected:
   CellularAggregateBase();
   ~CellularAggregateBase() override;
+
+private:
+  RandomGeneratorType m_RandomGenerator;
+  bool                m_UseInPlaceMitosis{ false };
 };
 } // end namespace bio
 } // end namespace itk
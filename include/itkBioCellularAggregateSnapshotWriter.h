@@ -0,0 +1,206 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#ifndef itkBioCellularAggregateSnapshotWriter_h
+#define itkBioCellularAggregateSnapshotWriter_h
+
+#include "itkBioCellularAggregate.h"
+#include "itkCommand.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace itk
+{
+namespace bio
+{
+/** \class CellularAggregateSnapshotWriter
+ * \brief Records the evolution of a CellularAggregate without stalling the simulation.
+ *
+ * The writer observes the IterationEvent of the aggregate. Every
+ * SnapshotInterval iterations it gathers the identifiers, positions, radii,
+ * colors and cycle states of the cells into one of two frame buffers, and a
+ * background thread serializes the frame while the simulation continues with
+ * the other buffer. The simulation only waits when a new frame is ready
+ * before the previous one has been written.
+ *
+ * Frames are either appended to a single binary trajectory file, or written
+ * as a series of legacy VTK polydata files. In the latter case the file name
+ * is a pattern that receives the snapshot number, for example
+ * "colony_%04d.vtk": it holds exactly one %d conversion, with an optional
+ * zero-padded width, and "%%" stands for a percent sign. The writer
+ * substitutes the number itself; the pattern is never passed to printf.
+ *
+ * The binary trajectory starts with the 8 bytes signature "BIOCTRAJ"
+ * followed by the version and the space dimension as 32 bits integers. Each
+ * frame then contains the iteration and the number of cells N as 64 bits
+ * integers, followed by N identifiers (uint64), N points (double), N radii
+ * (double), N RGB colors (float) and N cycle states (uint8), the frame being
+ * padded to a multiple of 8 bytes. The points are written in double
+ * precision whatever the type of the coordinates of the aggregate.
+ *
+ * \ingroup ITKBioCell
+ */
+template <unsigned int NSpaceDimension = 3, typename TCoordinate = double>
+class ITK_TEMPLATE_EXPORT CellularAggregateSnapshotWriter : public Object
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(CellularAggregateSnapshotWriter);
+
+  /** Standard class type alias. */
+  using Self = CellularAggregateSnapshotWriter;
+  using Superclass = Object;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /*** Run-time type information (and related methods). */
+  itkTypeMacro(CellularAggregateSnapshotWriter, Object);
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  static constexpr unsigned int SpaceDimension = NSpaceDimension;
+
+  using CellularAggregateType = CellularAggregate<NSpaceDimension, TCoordinate>;
+  using CellularAggregatePointer = typename CellularAggregateType::Pointer;
+
+  /** Output formats */
+  enum class SnapshotFormat : std::uint8_t
+  {
+    BinaryTrajectory,
+    VTKSeries
+  };
+
+  /** Attach the writer to an aggregate. Passing nullptr detaches it. */
+  void
+  SetCellularAggregate(CellularAggregateType * aggregate);
+
+  itkGetModifiableObjectMacro(CellularAggregate, CellularAggregateType);
+
+  /** Name of the trajectory file, or pattern of the VTK series. An invalid
+   *  pattern is reported by WriteSnapshot(). */
+  itkSetStringMacro(FileName);
+  itkGetStringMacro(FileName);
+
+  itkSetMacro(Format, SnapshotFormat);
+  itkGetConstMacro(Format, SnapshotFormat);
+
+  /** A snapshot is taken every SnapshotInterval iterations. Zero disables
+   *  the automatic snapshots; WriteSnapshot() can still be called. */
+  itkSetMacro(SnapshotInterval, SizeValueType);
+  itkGetConstMacro(SnapshotInterval, SizeValueType);
+
+  /** Capture the current state of the aggregate and queue it for writing. */
+  void
+  WriteSnapshot();
+
+  /** Wait until all the captured frames have been written. Errors that
+   *  happened in the background thread are reported here. */
+  void
+  Flush();
+
+  /** Number of frames successfully written to disk. */
+  SizeValueType
+  GetNumberOfSnapshots() const;
+
+protected:
+  CellularAggregateSnapshotWriter();
+  ~CellularAggregateSnapshotWriter() override;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  /** State of the cells at one iteration, stored as flat arrays. */
+  struct Frame
+  {
+    SizeValueType              m_Iteration{ 0 };
+    SizeValueType              m_SnapshotNumber{ 0 };
+    std::vector<std::uint64_t> m_Identifiers;
+    std::vector<double>        m_Positions;
+    std::vector<double>        m_Radii;
+    std::vector<float>         m_Colors;
+    std::vector<std::uint8_t>  m_CycleStates;
+  };
+
+  void
+  OnIteration(Object * caller, const EventObject & event);
+
+  void
+  CaptureFrame(Frame & frame) const;
+
+  void
+  ThreadedWrite();
+
+  void
+  WriteFrame(const Frame & frame);
+
+  void
+  WriteTrajectoryFrame(const Frame & frame);
+
+  void
+  WriteVTKFrame(const Frame & frame) const;
+
+  /** Replace the %d conversion of the pattern by the snapshot number.
+   *  Returns false if the pattern does not hold exactly one such
+   *  conversion, or holds another one. */
+  static bool
+  FormatFileName(const std::string & pattern, SizeValueType snapshotNumber, std::string & fileName);
+
+  void
+  StopWriterThread();
+
+  void
+  RethrowWriterError();
+
+  CellularAggregatePointer m_CellularAggregate;
+  unsigned long            m_ObserverTag{ 0 };
+
+  std::string    m_FileName;
+  SnapshotFormat m_Format{ SnapshotFormat::BinaryTrajectory };
+  SizeValueType  m_SnapshotInterval{ 1 };
+  SizeValueType  m_NumberOfCapturedFrames{ 0 };
+  SizeValueType  m_NumberOfWrittenFrames{ 0 };
+
+  // Double buffer: the simulation fills one frame while the
+  // background thread writes the other one.
+  Frame        m_Frames[2];
+  unsigned int m_CaptureIndex{ 0 };
+  unsigned int m_PendingIndex{ 0 };
+  bool         m_FramePending{ false };
+  bool         m_StopWriter{ false };
+  std::string  m_WriterError;
+
+  std::thread             m_WriterThread;
+  mutable std::mutex      m_Mutex;
+  std::condition_variable m_Condition;
+  std::ofstream           m_TrajectoryStream;
+};
+} // end namespace bio
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkBioCellularAggregateSnapshotWriter.hxx"
+#endif
+
+#endif
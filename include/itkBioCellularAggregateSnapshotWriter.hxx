@@ -0,0 +1,471 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#ifndef itkBioCellularAggregateSnapshotWriter_hxx
+#define itkBioCellularAggregateSnapshotWriter_hxx
+
+#include <cctype>
+#include <iomanip>
+
+namespace itk
+{
+namespace bio
+{
+template <unsigned int NSpaceDimension, typename TCoordinate>
+CellularAggregateSnapshotWriter<NSpaceDimension, TCoordinate>::CellularAggregateSnapshotWriter() = default;
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+CellularAggregateSnapshotWriter<NSpaceDimension, TCoordinate>::~CellularAggregateSnapshotWriter()
+{
+  if (m_CellularAggregate)
+  {
+    m_CellularAggregate->RemoveObserver(m_ObserverTag);
+  }
+  this->StopWriterThread();
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+CellularAggregateSnapshotWriter<NSpaceDimension, TCoordinate>::SetCellularAggregate(CellularAggregateType * aggregate)
+{
+  if (m_CellularAggregate == aggregate)
+  {
+    return;
+  }
+
+  if (m_CellularAggregate)
+  {
+    m_CellularAggregate->RemoveObserver(m_ObserverTag);
+  }
+
+  m_CellularAggregate = aggregate;
+
+  if (m_CellularAggregate)
+  {
+    using CommandType = MemberCommand<Self>;
+    typename CommandType::Pointer command = CommandType::New();
+    command->SetCallbackFunction(this, &Self::OnIteration);
+    m_ObserverTag = m_CellularAggregate->AddObserver(IterationEvent(), command);
+  }
+
+  this->Modified();
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+CellularAggregateSnapshotWriter<NSpaceDimension, TCoordinate>::OnIteration(Object * itkNotUsed(caller),
+                                                              const EventObject & itkNotUsed(event))
+{
+  if (m_SnapshotInterval && m_CellularAggregate->GetIteration() % m_SnapshotInterval == 0)
+  {
+    this->WriteSnapshot();
+  }
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+CellularAggregateSnapshotWriter<NSpaceDimension, TCoordinate>::WriteSnapshot()
+{
+  if (!m_CellularAggregate)
+  {
+    itkExceptionMacro("No CellularAggregate to take a snapshot from");
+  }
+  if (m_FileName.empty())
+  {
+    itkExceptionMacro("FileName is not set");
+  }
+  std::string fileName;
+  if (m_Format == SnapshotFormat::VTKSeries && !FormatFileName(m_FileName, 0, fileName))
+  {
+    itkExceptionMacro("The pattern " << m_FileName << " of the VTK series must hold exactly one %d conversion");
+  }
+
+  // The capture buffer is never the one being written.
+  Frame & frame = m_Frames[m_CaptureIndex];
+  this->CaptureFrame(frame);
+  frame.m_SnapshotNumber = m_NumberOfCapturedFrames++;
+
+  if (!m_WriterThread.joinable())
+  {
+    m_StopWriter = false;
+    m_WriterThread = std::thread(&Self::ThreadedWrite, this);
+  }
+
+  {
+    itkBioCellTraceSpanMacro("WaitForSnapshotWriter", "IO");
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    m_Condition.wait(lock, [this] { return !m_FramePending; });
+    m_PendingIndex = m_CaptureIndex;
+    m_FramePending = true;
+  }
+  m_Condition.notify_all();
+
+  m_CaptureIndex = 1 - m_CaptureIndex;
+
+  this->RethrowWriterError();
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+CellularAggregateSnapshotWriter<NSpaceDimension, TCoordinate>::CaptureFrame(Frame & frame) const
+{
+  itkBioCellTraceSpanMacro("CaptureSnapshot", "IO");
+
+  const auto * points = m_CellularAggregate->GetPoints();
+  const auto * cells = m_CellularAggregate->GetPointData();
+
+  const SizeValueType numberOfCells = cells->Size();
+
+  frame.m_Iteration = m_CellularAggregate->GetIteration();
+  frame.m_Identifiers.resize(numberOfCells);
+  frame.m_Positions.resize(numberOfCells * NSpaceDimension);
+  frame.m_Radii.resize(numberOfCells);
+  frame.m_Colors.resize(numberOfCells * 3);
+  frame.m_CycleStates.resize(numberOfCells);
+
+  auto pointIt = points->Begin();
+  auto cellIt = cells->Begin();
+
+  for (SizeValueType i = 0; i < numberOfCells; ++i, ++pointIt, ++cellIt)
+  {
+    const auto * cell = cellIt.Value();
+    const auto & position = pointIt.Value();
+
+    frame.m_Identifiers[i] = cell->GetSelfIdentifier();
+    for (unsigned int d = 0; d < NSpaceDimension; ++d)
+    {
+      frame.m_Positions[i * NSpaceDimension + d] = position[d];
+    }
+    frame.m_Radii[i] = cell->GetRadius();
+
+    const auto color = cell->GetColor();
+    frame.m_Colors[3 * i] = color.GetRed();
+    frame.m_Colors[3 * i + 1] = color.GetGreen();
+    frame.m_Colors[3 * i + 2] = color.GetBlue();
+
+    frame.m_CycleStates[i] = static_cast<std::uint8_t>(cell->GetCycleState());
+  }
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+CellularAggregateSnapshotWriter<NSpaceDimension, TCoordinate>::ThreadedWrite()
+{
+#if defined(BioCell_USE_TRACING)
+  TraceRecorder::SetThreadName("Snapshot writer");
+#endif
+
+  while (true)
+  {
+    unsigned int frameIndex = 0;
+    {
+      std::unique_lock<std::mutex> lock(m_Mutex);
+      m_Condition.wait(lock, [this] { return m_FramePending || m_StopWriter; });
+      if (!m_FramePending)
+      {
+        break;
+      }
+      frameIndex = m_PendingIndex;
+    }
+
+    std::string error;
+    try
+    {
+      this->WriteFrame(m_Frames[frameIndex]);
+    }
+    catch (const std::exception & excep)
+    {
+      error = excep.what();
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      if (error.empty())
+      {
+        ++m_NumberOfWrittenFrames;
+      }
+      else if (m_WriterError.empty())
+      {
+        m_WriterError = error;
+      }
+      m_FramePending = false;
+    }
+    m_Condition.notify_all();
+  }
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+CellularAggregateSnapshotWriter<NSpaceDimension, TCoordinate>::WriteFrame(const Frame & frame)
+{
+  itkBioCellTraceSpanMacro("WriteSnapshot", "IO");
+
+  if (m_Format == SnapshotFormat::VTKSeries)
+  {
+    this->WriteVTKFrame(frame);
+  }
+  else
+  {
+    this->WriteTrajectoryFrame(frame);
+  }
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+CellularAggregateSnapshotWriter<NSpaceDimension, TCoordinate>::WriteTrajectoryFrame(const Frame & frame)
+{
+  if (!m_TrajectoryStream.is_open())
+  {
+    m_TrajectoryStream.open(m_FileName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!m_TrajectoryStream)
+    {
+      itkExceptionMacro("Unable to open trajectory file " << m_FileName);
+    }
+
+    const std::uint32_t version = 1;
+    const std::uint32_t dimension = NSpaceDimension;
+    m_TrajectoryStream.write("BIOCTRAJ", 8);
+    m_TrajectoryStream.write(reinterpret_cast<const char *>(&version), sizeof(version));
+    m_TrajectoryStream.write(reinterpret_cast<const char *>(&dimension), sizeof(dimension));
+  }
+
+  const auto iteration = static_cast<std::uint64_t>(frame.m_Iteration);
+  const auto numberOfCells = static_cast<std::uint64_t>(frame.m_Identifiers.size());
+
+  std::ostream & os = m_TrajectoryStream;
+  os.write(reinterpret_cast<const char *>(&iteration), sizeof(iteration));
+  os.write(reinterpret_cast<const char *>(&numberOfCells), sizeof(numberOfCells));
+  os.write(reinterpret_cast<const char *>(frame.m_Identifiers.data()),
+           static_cast<std::streamsize>(frame.m_Identifiers.size() * sizeof(std::uint64_t)));
+  os.write(reinterpret_cast<const char *>(frame.m_Positions.data()),
+           static_cast<std::streamsize>(frame.m_Positions.size() * sizeof(double)));
+  os.write(reinterpret_cast<const char *>(frame.m_Radii.data()),
+           static_cast<std::streamsize>(frame.m_Radii.size() * sizeof(double)));
+  os.write(reinterpret_cast<const char *>(frame.m_Colors.data()),
+           static_cast<std::streamsize>(frame.m_Colors.size() * sizeof(float)));
+  os.write(reinterpret_cast<const char *>(frame.m_CycleStates.data()),
+           static_cast<std::streamsize>(frame.m_CycleStates.size()));
+
+  const char          padding[8] = {};
+  const std::uint64_t tail = (numberOfCells * (3 * sizeof(float) + 1)) % 8;
+  if (tail)
+  {
+    os.write(padding, static_cast<std::streamsize>(8 - tail));
+  }
+
+  os.flush();
+  if (!os)
+  {
+    itkExceptionMacro("Failed to write trajectory file " << m_FileName);
+  }
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+bool
+CellularAggregateSnapshotWriter<NSpaceDimension, TCoordinate>::FormatFileName(const std::string & pattern,
+                                                                             SizeValueType       snapshotNumber,
+                                                                             std::string &       fileName)
+{
+  bool hasNumber = false;
+  fileName.clear();
+  for (std::string::size_type i = 0; i < pattern.size(); ++i)
+  {
+    if (pattern[i] != '%')
+    {
+      fileName += pattern[i];
+      continue;
+    }
+    if (++i == pattern.size())
+    {
+      return false;
+    }
+    if (pattern[i] == '%')
+    {
+      fileName += '%';
+      continue;
+    }
+
+    // Only %d, %Nd and %0Nd are accepted, once.
+    const bool            zeroPadding = (pattern[i] == '0');
+    std::string::size_type width = 0;
+    for (i += zeroPadding ? 1 : 0; i < pattern.size() && std::isdigit(static_cast<unsigned char>(pattern[i])); ++i)
+    {
+      width = 10 * width + static_cast<std::string::size_type>(pattern[i] - '0');
+      if (width > 64)
+      {
+        return false;
+      }
+    }
+    if (i == pattern.size() || pattern[i] != 'd' || hasNumber)
+    {
+      return false;
+    }
+    hasNumber = true;
+
+    const std::string number = std::to_string(snapshotNumber);
+    if (number.size() < width)
+    {
+      fileName.append(width - number.size(), zeroPadding ? '0' : ' ');
+    }
+    fileName += number;
+  }
+  return hasNumber;
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+CellularAggregateSnapshotWriter<NSpaceDimension, TCoordinate>::WriteVTKFrame(const Frame & frame) const
+{
+  std::string fileName;
+  if (!FormatFileName(m_FileName, frame.m_SnapshotNumber, fileName))
+  {
+    itkExceptionMacro("Invalid pattern " << m_FileName << " of the VTK series");
+  }
+
+  std::ofstream os(fileName.c_str());
+  if (!os)
+  {
+    itkExceptionMacro("Unable to open VTK file " << fileName);
+  }
+
+  const SizeValueType numberOfCells = frame.m_Identifiers.size();
+
+  os << "# vtk DataFile Version 2.0" << std::endl;
+  os << "CellularAggregate iteration " << frame.m_Iteration << std::endl;
+  os << "ASCII" << std::endl;
+  os << "DATASET POLYDATA" << std::endl;
+  os << std::setprecision(17);
+
+  // VTK points are always 3D.
+  os << "POINTS " << numberOfCells << " double" << std::endl;
+  for (SizeValueType i = 0; i < numberOfCells; ++i)
+  {
+    for (unsigned int d = 0; d < 3; ++d)
+    {
+      os << (d < NSpaceDimension ? frame.m_Positions[i * NSpaceDimension + d] : 0.0) << (d < 2 ? " " : "");
+    }
+    os << std::endl;
+  }
+
+  os << "VERTICES " << numberOfCells << " " << 2 * numberOfCells << std::endl;
+  for (SizeValueType i = 0; i < numberOfCells; ++i)
+  {
+    os << "1 " << i << std::endl;
+  }
+
+  os << "POINT_DATA " << numberOfCells << std::endl;
+  os << "SCALARS identifier double 1" << std::endl << "LOOKUP_TABLE default" << std::endl;
+  for (SizeValueType i = 0; i < numberOfCells; ++i)
+  {
+    os << frame.m_Identifiers[i] << std::endl;
+  }
+  os << "SCALARS radius double 1" << std::endl << "LOOKUP_TABLE default" << std::endl;
+  for (SizeValueType i = 0; i < numberOfCells; ++i)
+  {
+    os << frame.m_Radii[i] << std::endl;
+  }
+  os << "SCALARS cycle_state int 1" << std::endl << "LOOKUP_TABLE default" << std::endl;
+  for (SizeValueType i = 0; i < numberOfCells; ++i)
+  {
+    os << static_cast<int>(frame.m_CycleStates[i]) << std::endl;
+  }
+  os << "COLOR_SCALARS color 3" << std::endl;
+  for (SizeValueType i = 0; i < numberOfCells; ++i)
+  {
+    os << frame.m_Colors[3 * i] << " " << frame.m_Colors[3 * i + 1] << " " << frame.m_Colors[3 * i + 2] << std::endl;
+  }
+
+  if (!os)
+  {
+    itkExceptionMacro("Failed to write VTK file " << fileName.data());
+  }
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+CellularAggregateSnapshotWriter<NSpaceDimension, TCoordinate>::Flush()
+{
+  {
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    m_Condition.wait(lock, [this] { return !m_FramePending; });
+  }
+  this->RethrowWriterError();
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+CellularAggregateSnapshotWriter<NSpaceDimension, TCoordinate>::StopWriterThread()
+{
+  if (!m_WriterThread.joinable())
+  {
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_StopWriter = true;
+  }
+  m_Condition.notify_all();
+  m_WriterThread.join();
+
+  if (m_TrajectoryStream.is_open())
+  {
+    m_TrajectoryStream.close();
+  }
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+CellularAggregateSnapshotWriter<NSpaceDimension, TCoordinate>::RethrowWriterError()
+{
+  std::string error;
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    error.swap(m_WriterError);
+  }
+  if (!error.empty())
+  {
+    itkExceptionMacro("Snapshot writing failed: " << error);
+  }
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+SizeValueType
+CellularAggregateSnapshotWriter<NSpaceDimension, TCoordinate>::GetNumberOfSnapshots() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_NumberOfWrittenFrames;
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+CellularAggregateSnapshotWriter<NSpaceDimension, TCoordinate>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "CellularAggregate: " << m_CellularAggregate.GetPointer() << std::endl;
+  os << indent << "FileName: " << m_FileName << std::endl;
+  os << indent << "Format: " << (m_Format == SnapshotFormat::VTKSeries ? "VTKSeries" : "BinaryTrajectory")
+     << std::endl;
+  os << indent << "SnapshotInterval: " << m_SnapshotInterval << std::endl;
+  os << indent << "NumberOfSnapshots: " << this->GetNumberOfSnapshots() << std::endl;
+}
+} // end namespace bio
+} // end namespace itk
+
+#endif
@@ -0,0 +1,189 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#ifndef itkBioCellularAggregateStatistics_h
+#define itkBioCellularAggregateStatistics_h
+
+#include "itkEventObject.h"
+#include "itkIndent.h"
+#include "itkIntTypes.h"
+#include "itkBioCellConfigure.h"
+#include "BioCellExport.h"
+
+#include <chrono>
+
+namespace itk
+{
+namespace bio
+{
+/** \class CellularAggregateStatistics
+ * \brief Timings and counters of the phases of CellularAggregate::AdvanceTimeStep().
+ *
+ * Phase times are exclusive wall-clock times in seconds: the time spent
+ * adding the daughters of a dividing cell is accounted for in the Births
+ * phase, not in the CellCycle phase that triggered the division.
+ *
+ * The statistics are only collected when the module is configured with
+ * BioCell_USE_INSTRUMENTATION. Otherwise the instrumentation is compiled
+ * out and all the values remain zero.
+ *
+ * \ingroup ITKBioCell
+ */
+class BioCell_EXPORT CellularAggregateStatistics
+{
+public:
+  enum Phase
+  {
+    NeighborSearch = 0,
+    Forces,
+    Positions,
+    CellCycle,
+    Births,
+    Deaths,
+    NumberOfPhases
+  };
+
+  /** Measure the time spent in one phase. Timers can be nested,
+   *  the time of the inner timer is subtracted from the outer one. */
+  class BioCell_EXPORT PhaseTimer
+  {
+  public:
+    PhaseTimer(CellularAggregateStatistics & statistics, Phase phase);
+    ~PhaseTimer();
+
+    PhaseTimer(const PhaseTimer &) = delete;
+    PhaseTimer &
+    operator=(const PhaseTimer &) = delete;
+
+  private:
+    using ClockType = std::chrono::steady_clock;
+
+    CellularAggregateStatistics & m_Statistics;
+    Phase                         m_Phase;
+    ClockType::time_point         m_Start;
+    double                        m_NestedTime{ 0.0 };
+    PhaseTimer *                  m_Parent;
+  };
+
+  CellularAggregateStatistics();
+
+  /** Set all the timings and counters to zero. */
+  void
+  Reset();
+
+  /** Accumulate the values of another set of statistics. */
+  CellularAggregateStatistics &
+  operator+=(const CellularAggregateStatistics & other);
+
+  /** Sum of the times of all the phases. */
+  double
+  GetTotalTime() const;
+
+  static const char *
+  GetPhaseName(Phase phase);
+
+  void
+  Print(std::ostream & os, Indent indent = 0) const;
+
+  /** Number of iterations covered by these statistics. */
+  SizeValueType m_NumberOfIterations;
+
+  /** Number of cells at the end of the last iteration. */
+  SizeValueType m_NumberOfCells;
+
+  /** Number of cells skipped by the active set at the end of the last iteration. */
+  SizeValueType m_NumberOfSleepingCells;
+
+  /** Exclusive wall-clock time of each phase, in seconds. */
+  double m_PhaseTime[NumberOfPhases];
+
+  /** Number of neighbor pairs close enough to exchange forces. The pairs of
+   *  cells that both ignore forces are not counted. */
+  SizeValueType m_PairInteractions;
+
+  /** Number of neighbor lists rebuilt and of entries written in them. */
+  SizeValueType m_NeighborListsRebuilt;
+  SizeValueType m_NeighborListEntries;
+
+  /** Number of cells added by division and removed from the aggregate. */
+  SizeValueType m_Births;
+  SizeValueType m_Deaths;
+
+  /** Number of substrate samples read by the cells. */
+  SizeValueType m_SubstrateSamples;
+
+  /** Number of ghost cells read by the tiles of the domain decomposition,
+   *  and of cells that changed tile. */
+  SizeValueType m_GhostCells;
+  SizeValueType m_MigratedCells;
+
+private:
+  PhaseTimer * m_ActiveTimer;
+};
+
+/** \class CellularAggregateIterationEvent
+ * \brief IterationEvent invoked by a CellularAggregate at the end of each time step.
+ *
+ * The event carries the statistics of the iteration that just completed.
+ * Observers of IterationEvent also receive it.
+ *
+ * \ingroup ITKBioCell
+ */
+class BioCell_EXPORT CellularAggregateIterationEvent : public IterationEvent
+{
+public:
+  using Self = CellularAggregateIterationEvent;
+  using Superclass = IterationEvent;
+
+  CellularAggregateIterationEvent(const CellularAggregateStatistics * statistics = nullptr);
+  CellularAggregateIterationEvent(const Self & s);
+  ~CellularAggregateIterationEvent() override;
+
+  const char *
+  GetEventName() const override;
+
+  bool
+  CheckEvent(const EventObject * e) const override;
+
+  EventObject *
+  MakeObject() const override;
+
+  /** Statistics of the iteration. They are only valid during the
+   *  execution of the observers. */
+  const CellularAggregateStatistics *
+  GetStatistics() const;
+
+  void
+  operator=(const Self &) = delete;
+
+private:
+  const CellularAggregateStatistics * m_Statistics;
+};
+} // end namespace bio
+} // end namespace itk
+
+#if defined(BioCell_USE_INSTRUMENTATION)
+#  define itkBioCellPhaseTimerMacro(statistics, phase) \
+    const ::itk::bio::CellularAggregateStatistics::PhaseTimer itkBioCellPhaseTimer((statistics), (phase))
+#  define itkBioCellCounterMacro(statistics, counter, value) ((statistics).counter += (value))
+#else
+#  define itkBioCellPhaseTimerMacro(statistics, phase)
+#  define itkBioCellCounterMacro(statistics, counter, value)
+#endif
+
+#endif
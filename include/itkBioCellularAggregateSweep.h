@@ -0,0 +1,201 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#ifndef itkBioCellularAggregateSweep_h
+#define itkBioCellularAggregateSweep_h
+
+#include "itkBioCellularAggregate.h"
+
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace itk
+{
+namespace bio
+{
+/** \class CellularAggregateSweep
+ * \brief Runs independent CellularAggregate simulations concurrently.
+ *
+ * Each run of the sweep simulates its own aggregate, with its own cell
+ * parameters, random seed and stopping criteria, over substrates that are
+ * shared by all the runs and only read. The runs are distributed over a
+ * pool of threads. The parameters of the cells being those of the thread
+ * that creates them (see CellBase::Parameters), a run sets the parameters
+ * of its thread before creating its first cells, and its aggregate is
+ * created, simulated and destroyed in that thread.
+ *
+ * The results of the runs are collected in one table, in the order in
+ * which the runs were added: number of cells, iterations, stop condition,
+ * wall clock time and a mask of the cells drawn on the grid of the first
+ * substrate. The table can be written as CSV with WriteResults().
+ *
+ * \ingroup ITKBioCell
+ */
+template <unsigned int NSpaceDimension = 3, typename TCoordinate = double>
+class ITK_TEMPLATE_EXPORT CellularAggregateSweep : public Object
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(CellularAggregateSweep);
+
+  /** Standard class type alias. */
+  using Self = CellularAggregateSweep;
+  using Superclass = Object;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /*** Run-time type information (and related methods). */
+  itkTypeMacro(CellularAggregateSweep, Object);
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  static constexpr unsigned int SpaceDimension = NSpaceDimension;
+
+  using CellularAggregateType = CellularAggregate<NSpaceDimension, TCoordinate>;
+  using BioCellType = typename CellularAggregateType::BioCellType;
+  using PointType = typename CellularAggregateType::PointType;
+  using StoppingCriteria = typename CellularAggregateType::StoppingCriteria;
+  using StopConditionEnum = typename CellularAggregateType::StopConditionEnum;
+  using SubstrateType = typename CellularAggregateType::SubstrateType;
+  using SubstratesVector = typename CellularAggregateType::SubstratesVector;
+  using RandomSeedType = CellularAggregateBase::RandomSeedType;
+  using CellParametersType = CellBase::Parameters;
+
+  using MaskPixelType = unsigned char;
+  using MaskImageType = Image<MaskPixelType, NSpaceDimension>;
+  using MaskImagePointer = typename MaskImageType::Pointer;
+
+  /** Settings of one run. */
+  struct RunParameters
+  {
+    std::string        m_Name;
+    CellParametersType m_CellParameters{};
+    RandomSeedType     m_RandomSeed{ 5489 };
+    StoppingCriteria   m_StoppingCriteria{};
+  };
+
+  /** Outcome of one run. */
+  struct RunResult
+  {
+    SizeValueType     m_NumberOfCells{ 0 };
+    SizeValueType     m_Iteration{ 0 };
+    StopConditionEnum m_StopCondition{ StopConditionEnum::MaximumNumberOfIterations };
+    double            m_ElapsedTime{ 0.0 }; // seconds
+
+    /** Pixels inside a cell are set to one. Null when the masks are not
+     *  computed or when there is no substrate. */
+    MaskImagePointer m_CellMask;
+    SizeValueType    m_NumberOfMaskPixels{ 0 };
+
+    /** Description of the exception that ended the run, empty on success. */
+    std::string m_Error;
+  };
+
+  /** Function placing the first cells of a run in its aggregate. */
+  using SeedFunctionType = std::function<void(CellularAggregateType *)>;
+
+  void
+  AddRun(const RunParameters & run);
+
+  void
+  ClearRuns();
+
+  SizeValueType
+  GetNumberOfRuns() const;
+
+  const RunParameters &
+  GetRun(SizeValueType runIndex) const;
+
+  /** Substrates shared by all the runs. They must not be modified while
+   *  the sweep runs. */
+  void
+  AddSubstrate(SubstrateType * substrate);
+
+  const SubstratesVector &
+  GetSubstrates() const;
+
+  /** Function called in the thread of a run to place its first cells. By
+   *  default an egg is placed at the origin. The cells that start a colony
+   *  draw their latencies from vnl_sample, which is not thread safe: the
+   *  calls are therefore serialized, and the vnl generator is reseeded with
+   *  the seed of the run before each call so that the runs can be
+   *  reproduced. */
+  void
+  SetSeedFunction(const SeedFunctionType & seedFunction);
+
+  /** Number of runs executed concurrently. Zero, the default, uses the
+   *  global default number of threads. */
+  itkSetMacro(NumberOfWorkUnits, unsigned int);
+  itkGetConstMacro(NumberOfWorkUnits, unsigned int);
+
+  /** Draw the cells of each run on the grid of the first substrate. On by
+   *  default. */
+  itkSetMacro(ComputeCellMasks, bool);
+  itkGetConstMacro(ComputeCellMasks, bool);
+  itkBooleanMacro(ComputeCellMasks);
+
+  /** Execute all the runs and wait for them to complete. A run that throws
+   *  an exception does not stop the other runs; once all of them are done
+   *  an exception is thrown if any run failed. */
+  void
+  Run();
+
+  /** Results of the last Run(), in the order of the runs. */
+  const std::vector<RunResult> &
+  GetResults() const
+  {
+    return m_Results;
+  }
+
+  /** Write the results as CSV, with one row per run. */
+  void
+  WriteResults(std::ostream & os) const;
+
+  void
+  WriteResults(const std::string & fileName) const;
+
+protected:
+  CellularAggregateSweep();
+  ~CellularAggregateSweep() override = default;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  /** Simulate one run in the calling thread. */
+  void
+  ExecuteRun(SizeValueType runIndex);
+
+  std::vector<RunParameters> m_Runs;
+  std::vector<RunResult>     m_Results;
+  SubstratesVector           m_Substrates;
+  SeedFunctionType           m_SeedFunction;
+
+  unsigned int m_NumberOfWorkUnits{ 0 };
+  bool         m_ComputeCellMasks{ true };
+};
+} // end namespace bio
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkBioCellularAggregateSweep.hxx"
+#endif
+
+#endif
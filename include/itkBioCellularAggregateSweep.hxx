@@ -0,0 +1,293 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#ifndef itkBioCellularAggregateSweep_hxx
+#define itkBioCellularAggregateSweep_hxx
+
+#include "itkMultiThreaderBase.h"
+#include "vnl/vnl_sample.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <mutex>
+#include <thread>
+
+namespace itk
+{
+namespace bio
+{
+template <unsigned int NSpaceDimension, typename TCoordinate>
+CellularAggregateSweep<NSpaceDimension, TCoordinate>::CellularAggregateSweep()
+{
+  m_SeedFunction = [](CellularAggregateType * aggregate) {
+    PointType origin;
+    origin.Fill(0.0);
+    aggregate->SetEgg(BioCellType::CreateEgg(), origin);
+  };
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+CellularAggregateSweep<NSpaceDimension, TCoordinate>::AddRun(const RunParameters & run)
+{
+  m_Runs.push_back(run);
+  this->Modified();
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+CellularAggregateSweep<NSpaceDimension, TCoordinate>::ClearRuns()
+{
+  m_Runs.clear();
+  m_Results.clear();
+  this->Modified();
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+SizeValueType
+CellularAggregateSweep<NSpaceDimension, TCoordinate>::GetNumberOfRuns() const
+{
+  return static_cast<SizeValueType>(m_Runs.size());
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+auto
+CellularAggregateSweep<NSpaceDimension, TCoordinate>::GetRun(SizeValueType runIndex) const -> const RunParameters &
+{
+  if (runIndex >= m_Runs.size())
+  {
+    itkExceptionMacro(<< "Run " << runIndex << " does not exist, the sweep has " << m_Runs.size() << " runs");
+  }
+  return m_Runs[runIndex];
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+CellularAggregateSweep<NSpaceDimension, TCoordinate>::AddSubstrate(SubstrateType * substrate)
+{
+  m_Substrates.push_back(substrate);
+  this->Modified();
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+auto
+CellularAggregateSweep<NSpaceDimension, TCoordinate>::GetSubstrates() const -> const SubstratesVector &
+{
+  return m_Substrates;
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+CellularAggregateSweep<NSpaceDimension, TCoordinate>::SetSeedFunction(const SeedFunctionType & seedFunction)
+{
+  if (!seedFunction)
+  {
+    itkExceptionMacro(<< "The seed function is empty");
+  }
+  m_SeedFunction = seedFunction;
+  this->Modified();
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+CellularAggregateSweep<NSpaceDimension, TCoordinate>::Run()
+{
+  m_Results.assign(m_Runs.size(), RunResult{});
+  if (m_Runs.empty())
+  {
+    return;
+  }
+
+  unsigned int numberOfWorkUnits = m_NumberOfWorkUnits;
+  if (numberOfWorkUnits == 0)
+  {
+    numberOfWorkUnits = MultiThreaderBase::GetGlobalDefaultNumberOfThreads();
+  }
+  numberOfWorkUnits = std::max(1u, std::min(numberOfWorkUnits, static_cast<unsigned int>(m_Runs.size())));
+
+  // The workers take the runs in order. Every run writes its own result,
+  // so the results do not need to be protected.
+  std::atomic<SizeValueType> nextRun{ 0 };
+  auto                       worker = [this, &nextRun]() {
+    for (SizeValueType runIndex = nextRun++; runIndex < m_Runs.size(); runIndex = nextRun++)
+    {
+      this->ExecuteRun(runIndex);
+    }
+  };
+
+  std::vector<std::thread> workers;
+  workers.reserve(numberOfWorkUnits);
+  for (unsigned int i = 0; i < numberOfWorkUnits; ++i)
+  {
+    workers.emplace_back(worker);
+  }
+  for (std::thread & thread : workers)
+  {
+    thread.join();
+  }
+
+  for (SizeValueType runIndex = 0; runIndex < m_Runs.size(); ++runIndex)
+  {
+    if (!m_Results[runIndex].m_Error.empty())
+    {
+      itkExceptionMacro(<< "Run " << runIndex << " (" << m_Runs[runIndex].m_Name
+                        << ") failed: " << m_Results[runIndex].m_Error);
+    }
+  }
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+CellularAggregateSweep<NSpaceDimension, TCoordinate>::ExecuteRun(SizeValueType runIndex)
+{
+  // Serializes the calls of the seed functions, which use the global vnl
+  // generator.
+  static std::mutex seedMutex;
+
+  itkBioCellTraceSpanMacro("SweepRun", "BioCell");
+
+  const RunParameters & run = m_Runs[runIndex];
+  RunResult &           result = m_Results[runIndex];
+
+  try
+  {
+    // The cells of the run are created in this thread, with its parameters.
+    BioCellType::SetParameters(run.m_CellParameters);
+    BioCellType::ResetCounter();
+
+    typename CellularAggregateType::Pointer aggregate = CellularAggregateType::New();
+    aggregate->SetRandomSeed(run.m_RandomSeed);
+    for (const auto & substrate : m_Substrates)
+    {
+      aggregate->AddSubstrate(substrate);
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(seedMutex);
+      vnl_sample_reseed(static_cast<int>(run.m_RandomSeed));
+      m_SeedFunction(aggregate.GetPointer());
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    result.m_StopCondition = aggregate->Run(run.m_StoppingCriteria);
+    result.m_ElapsedTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    result.m_NumberOfCells = aggregate->GetNumberOfCells();
+    result.m_Iteration = aggregate->GetIteration();
+
+    if (m_ComputeCellMasks && !m_Substrates.empty())
+    {
+      const SubstrateType * reference = m_Substrates.front();
+
+      MaskImagePointer mask = MaskImageType::New();
+      mask->CopyInformation(reference);
+      mask->SetRegions(reference->GetLargestPossibleRegion());
+      mask->Allocate(true);
+      aggregate->RasterizeCells(mask.GetPointer(), MaskPixelType{ 1 });
+
+      const MaskPixelType * buffer = mask->GetBufferPointer();
+      result.m_NumberOfMaskPixels = static_cast<SizeValueType>(
+        std::count(buffer, buffer + mask->GetBufferedRegion().GetNumberOfPixels(), MaskPixelType{ 1 }));
+      result.m_CellMask = mask;
+    }
+  }
+  catch (const std::exception & e)
+  {
+    result.m_Error = e.what();
+  }
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+CellularAggregateSweep<NSpaceDimension, TCoordinate>::WriteResults(std::ostream & os) const
+{
+  auto writeString = [&os](const std::string & text) {
+    os << '"';
+    for (const char c : text)
+    {
+      if (c == '"')
+      {
+        os << '"';
+      }
+      os << c;
+    }
+    os << '"';
+  };
+
+  os << "run,name,seed,chemo_attractant_low_threshold,chemo_attractant_high_threshold,growth_radius_limit,"
+        "growth_maximum_latency_time,division_maximum_latency_time,cells,iterations,stop_condition,seconds,"
+        "mask_pixels,error\n";
+
+  for (SizeValueType runIndex = 0; runIndex < m_Runs.size(); ++runIndex)
+  {
+    const RunParameters &      run = m_Runs[runIndex];
+    const CellParametersType & parameters = run.m_CellParameters;
+
+    os << runIndex << ',';
+    writeString(run.m_Name);
+    os << ',' << run.m_RandomSeed << ',' << parameters.m_ChemoAttractantLowThreshold << ','
+       << parameters.m_ChemoAttractantHighThreshold << ',' << parameters.m_GrowthRadiusLimit << ','
+       << parameters.m_GrowthMaximumLatencyTime << ',' << parameters.m_DivisionMaximumLatencyTime;
+
+    if (runIndex < m_Results.size())
+    {
+      const RunResult & result = m_Results[runIndex];
+      os << ',' << result.m_NumberOfCells << ',' << result.m_Iteration << ','
+         << static_cast<unsigned int>(result.m_StopCondition) << ',' << result.m_ElapsedTime << ','
+         << result.m_NumberOfMaskPixels << ',';
+      writeString(result.m_Error);
+    }
+    else
+    {
+      os << ",,,,,,";
+    }
+    os << '\n';
+  }
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+CellularAggregateSweep<NSpaceDimension, TCoordinate>::WriteResults(const std::string & fileName) const
+{
+  std::ofstream os(fileName);
+  if (!os)
+  {
+    itkExceptionMacro(<< "Cannot open " << fileName << " for writing");
+  }
+  this->WriteResults(os);
+  if (!os)
+  {
+    itkExceptionMacro(<< "Failed to write " << fileName);
+  }
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+CellularAggregateSweep<NSpaceDimension, TCoordinate>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "NumberOfRuns: " << m_Runs.size() << std::endl;
+  os << indent << "NumberOfSubstrates: " << m_Substrates.size() << std::endl;
+  os << indent << "NumberOfWorkUnits: " << m_NumberOfWorkUnits << std::endl;
+  os << indent << "ComputeCellMasks: " << (m_ComputeCellMasks ? "On" : "Off") << std::endl;
+}
+} // end namespace bio
+} // end namespace itk
+
+#endif
@@ -0,0 +1,313 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkBioCompactCellularAggregate_h
+#define itkBioCompactCellularAggregate_h
+
+#include "itkDefaultDynamicMeshTraits.h"
+#include "itkImage.h"
+#include "itkMesh.h"
+#include "itkPointSet.h"
+#include "itkPolygonCell.h"
+#include "itkBioCell.h"
+#include "itkBioNeighborGraph.h"
+
+#include <iostream>
+#include <vector>
+
+namespace itk
+{
+namespace bio
+{
+/** \class CompactCellularAggregate
+ * \brief Aggregate of bio::Cell objects stored in flat arrays instead of a Mesh.
+ *
+ * The cells, their identifiers and their mechanical state are stored in
+ * three parallel arrays sorted by identifier, and the neighbor lists in a
+ * NeighborGraph. The mechanical state of a cell (position, radius, force,
+ * pressure and whether it ignores forces) is a small record, so that the
+ * neighbor search, the forces and the update of the positions read
+ * contiguous records without touching the cells. The records own the
+ * forces: Cell::GetForce() is not updated for the cells of a compact
+ * aggregate, and the pressure is stored in the cell once computed, since
+ * the cell cycle reads it. The radius and the response to forces are
+ * copied to the record of a cell after its cycle. The simulation follows
+ * the same rules as
+ * CellularAggregate, in the same order, and gives the same result for the
+ * same cells, substrates and random seed, but without the containers of
+ * itk::Mesh: a cell is found from its identifier by a binary search, and
+ * the passes over the cells read contiguous memory.
+ *
+ * The active set, the tiles, the spatial reordering, the checkpoints and
+ * the statistics of CellularAggregate are not available. The cells can be
+ * exported on demand to an itk::PointSet, or to an itk::Mesh whose cells
+ * are the Voronoi regions listing the neighbors of each cell, as in
+ * CellularAggregate::GetMesh(). GetMesh() keeps such a mesh, refreshed
+ * lazily from the arrays.
+ *
+ * \ingroup ITKBioCell
+ */
+template <unsigned int NSpaceDimension = 3, typename TCoordinate = double>
+class ITK_TEMPLATE_EXPORT CompactCellularAggregate : public CellularAggregateBase
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(CompactCellularAggregate);
+
+  /** Standard class type alias. */
+  using Self = CompactCellularAggregate;
+  using Superclass = CellularAggregateBase;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /*** Run-time type information (and related methods). */
+  itkTypeMacro(CompactCellularAggregate, CellularAggregateBase);
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  static constexpr unsigned int SpaceDimension = NSpaceDimension;
+
+  using BioCellType = Cell<NSpaceDimension, TCoordinate>;
+  using CoordinateType = TCoordinate;
+  using PointType = typename BioCellType::PointType;
+  using VectorType = typename BioCellType::VectorType;
+
+  using SubstrateType = Image<ImagePixelType, NSpaceDimension>;
+  using SubstratePointer = typename SubstrateType::Pointer;
+  using SubstratesVector = std::vector<SubstratePointer>;
+
+  /** Types of the exported cells, identical to the mesh of CellularAggregate. */
+  using MeshTraits = DefaultDynamicMeshTraits<BioCellType *,   // PixelType
+                                              NSpaceDimension, // Points Dimension
+                                              NSpaceDimension, // Max.Topological Dimension
+                                              TCoordinate,     // Type for coordinates
+                                              TCoordinate,     // Type for interpolation
+                                              double           // Type for values in the cells
+                                              >;
+  using MeshType = Mesh<BioCellType *, NSpaceDimension, MeshTraits>;
+  using MeshPointer = typename MeshType::Pointer;
+  using PointSetType = PointSet<BioCellType *, NSpaceDimension, MeshTraits>;
+  using PointSetPointer = typename PointSetType::Pointer;
+
+  using CellInterfaceType = CellInterface<typename MeshType::CellPixelType, typename MeshType::CellTraits>;
+  using VoronoiRegionType = PolygonCell<CellInterfaceType>;
+
+  /** Mechanical state of a cell. The radius, the pressure factor and the
+   *  flag are copied from the cell after its cycle, which also clears the
+   *  force and the pressure accumulated by the next time step. */
+  struct MechanicsRecord
+  {
+    PointType  m_Position;
+    VectorType m_Force;
+    double     m_Radius{ 0.0 };
+    double     m_PressureFactor{ 0.0 }; // inverse of the volume of the cell
+    double     m_Pressure{ 0.0 };
+    bool       m_IgnoresForces{ false };
+  };
+
+  unsigned int
+  GetNumberOfCells() const;
+
+  /** Identifiers, mechanical states and cells, sorted by identifier. */
+  const std::vector<IdentifierType> &
+  GetCellIdentifiers() const
+  {
+    return m_Identifiers;
+  }
+
+  const std::vector<MechanicsRecord> &
+  GetCellMechanics() const
+  {
+    return m_Mechanics;
+  }
+
+  const std::vector<BioCellType *> &
+  GetCells() const
+  {
+    return m_Cells;
+  }
+
+  /** Position of a cell. Returns false if the cell is not in the aggregate. */
+  bool
+  GetCellPosition(IdentifierType cellId, PointType & position) const;
+
+  /** Neighbor lists of the cells, see CellularAggregate::GetNeighborGraph(). */
+  const NeighborGraph &
+  GetNeighborGraph() const
+  {
+    return m_NeighborGraph;
+  }
+
+  /** Number of time steps executed so far. */
+  itkGetConstMacro(Iteration, SizeValueType);
+
+  /** Largest displacement of a cell during the last iteration. */
+  itkGetConstMacro(MaximumDisplacement, double);
+
+  /** Norm of the force below which a cell does not move. */
+  itkSetMacro(FrictionForce, double);
+  itkGetConstMacro(FrictionForce, double);
+
+  /** Number of time steps between two searches of the neighbors. */
+  itkSetClampMacro(ClosestPointComputationInterval, SizeValueType, 1, NumericTraits<SizeValueType>::max());
+  itkGetConstMacro(ClosestPointComputationInterval, SizeValueType);
+
+  /** Advance the simulation by one step. */
+  virtual void
+  AdvanceTimeStep();
+
+  void
+  AdvanceTimeSteps(SizeValueType numberOfSteps);
+
+  /** Add a cell that has no parent at the given position. An exception is
+   *  thrown if a cell with the same identifier is in the aggregate. */
+  virtual void
+  SetEgg(BioCellType * cell, const PointType & position);
+
+  void
+  Add(CellBase * cellA, CellBase * cellB, double perturbationLength) override;
+
+  void
+  Remove(CellBase * cell) override;
+
+  void
+  Divide(CellBase * mother, CellBase * daughterA, CellBase * daughterB, double perturbationLength) override;
+
+  virtual void
+  AddSubstrate(SubstrateType * substrate);
+
+  const SubstratesVector &
+  GetSubstrates() const
+  {
+    return m_Substrates;
+  }
+
+  SubstrateValueType
+  GetSubstrateValue(IdentifierType cellId, unsigned int substrateId) const override;
+
+  /** Delete all the cells and reset the counter of cell identifiers. */
+  void
+  KillAll();
+
+  /** Point set holding the positions of the cells, with the cells as point
+   *  data. The cells are owned by the aggregate: the point set must not be
+   *  used once they have been removed. */
+  PointSetPointer
+  ExportPointSet() const;
+
+  /** Mesh holding the positions and the cells, as the point set, and the
+   *  Voronoi regions of the cells, indexed by cell identifier. */
+  MeshPointer
+  ExportMesh() const;
+
+  /** Mesh of the aggregate, as returned by ExportMesh(), kept by the
+   *  aggregate to feed the mesh writers. It is built when it is requested,
+   *  and rebuilt on the next request once the aggregate has been modified:
+   *  the time steps never update it. The Voronoi regions are only rebuilt
+   *  when the neighbor graph has changed. */
+  const MeshType *
+  GetMesh() const;
+
+protected:
+  CompactCellularAggregate();
+  ~CompactCellularAggregate() override;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  /** Copy the radius and the response to forces of a cell to its record,
+   *  and clear its force and pressure. */
+  void
+  UpdateMechanics(SizeValueType index);
+
+  virtual void
+  ComputeClosestPoints();
+
+  virtual void
+  ComputeForces();
+
+  /** Move the cells and store their pressure in the cells. */
+  virtual void
+  UpdatePositions();
+
+  /** Advance the cell cycle of every cell in order of identifier, adding the
+   *  daughters of the cells that divide and removing the cells that die. */
+  virtual void
+  AdvanceCellCycles();
+
+  /** Index of the cell in the arrays, or the size of the arrays if the cell
+   *  is not in the aggregate. */
+  SizeValueType
+  FindCell(IdentifierType cellId) const;
+
+  /** Insert a cell in the arrays, keeping them sorted by identifier. */
+  void
+  InsertCell(BioCellType * cell, const PointType & position);
+
+  /** Drop the entries of the removed cells from the arrays. */
+  void
+  CompactCells();
+
+private:
+  VectorType
+  ComputeDivisionPerturbation(double perturbationLength);
+
+  static MeshPointer
+  CreateMesh();
+
+  /** Replace the points and the point data of the mesh by the cells. */
+  void
+  CopyCellsToMesh(MeshType * mesh) const;
+
+  /** Replace the cells of the mesh by the Voronoi regions of the cells. */
+  void
+  CopyVoronoiRegionsToMesh(MeshType * mesh) const;
+
+  // Parallel arrays, sorted by identifier. The entries of the cells removed
+  // during the cell cycle pass hold a null cell until the end of the pass.
+  std::vector<IdentifierType>  m_Identifiers;
+  std::vector<MechanicsRecord> m_Mechanics;
+  std::vector<BioCellType *>   m_Cells;
+  SizeValueType                m_NumberOfRemovedCells{ 0 };
+
+  // Index of each cell in the arrays, indexed by identifier from the first
+  // one, rebuilt by ComputeForces() to look up the neighbors. Empty when the
+  // identifiers are too sparse, at most twice the number of cells otherwise.
+  std::vector<SizeValueType> m_CellIndices;
+  bool                       m_AdvancingCellCycles{ false };
+
+  NeighborGraph    m_NeighborGraph;
+  SubstratesVector m_Substrates;
+
+  // Mesh returned by GetMesh(), with the times of its last update.
+  mutable MeshPointer      m_Mesh;
+  mutable ModifiedTimeType m_MeshTime{ 0 };
+  mutable SizeValueType    m_VoronoiRegionsTimeStamp{ 0 };
+
+  SizeValueType m_Iteration{ 0 };
+  SizeValueType m_ClosestPointComputationInterval{ 5 };
+  double        m_FrictionForce{ 1.0 };
+  double        m_MaximumDisplacement{ 0.0 };
+};
+} // end namespace bio
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkBioCompactCellularAggregate.hxx"
+#endif
+
+#endif
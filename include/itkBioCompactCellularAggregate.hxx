@@ -0,0 +1,716 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkBioCompactCellularAggregate_hxx
+#define itkBioCompactCellularAggregate_hxx
+
+#include "itkBioInlineNeighborList.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace itk
+{
+namespace bio
+{
+template <unsigned int NSpaceDimension, typename TCoordinate>
+CompactCellularAggregate<NSpaceDimension, TCoordinate>::CompactCellularAggregate() = default;
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+CompactCellularAggregate<NSpaceDimension, TCoordinate>::~CompactCellularAggregate()
+{
+  this->KillAll();
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+unsigned int
+CompactCellularAggregate<NSpaceDimension, TCoordinate>::GetNumberOfCells() const
+{
+  return static_cast<unsigned int>(m_Cells.size() - m_NumberOfRemovedCells);
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+bool
+CompactCellularAggregate<NSpaceDimension, TCoordinate>::GetCellPosition(IdentifierType cellId,
+                                                                       PointType &    position) const
+{
+  const SizeValueType index = this->FindCell(cellId);
+  if (index == m_Cells.size())
+  {
+    return false;
+  }
+  position = m_Mechanics[index].m_Position;
+  return true;
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+SizeValueType
+CompactCellularAggregate<NSpaceDimension, TCoordinate>::FindCell(IdentifierType cellId) const
+{
+  const auto found = std::lower_bound(m_Identifiers.begin(), m_Identifiers.end(), cellId);
+  const auto index = static_cast<SizeValueType>(found - m_Identifiers.begin());
+  if (found == m_Identifiers.end() || *found != cellId || m_Cells[index] == nullptr)
+  {
+    return m_Cells.size();
+  }
+  return index;
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+CompactCellularAggregate<NSpaceDimension, TCoordinate>::InsertCell(BioCellType * cell, const PointType & position)
+{
+  const IdentifierType cellId = cell->GetSelfIdentifier();
+
+  // The new cells usually have the largest identifier.
+  auto found = m_Identifiers.end();
+  if (!m_Identifiers.empty() && m_Identifiers.back() >= cellId)
+  {
+    found = std::lower_bound(m_Identifiers.begin(), m_Identifiers.end(), cellId);
+  }
+  const auto index = found - m_Identifiers.begin();
+  if (found != m_Identifiers.end() && *found == cellId)
+  {
+    itkExceptionMacro(<< "Cell " << cellId << " is already in the aggregate");
+  }
+
+  MechanicsRecord record;
+  record.m_Position = position;
+
+  m_Identifiers.insert(found, cellId);
+  m_Mechanics.insert(m_Mechanics.begin() + index, record);
+  m_Cells.insert(m_Cells.begin() + index, cell);
+
+  cell->SetCellularAggregate(this);
+  this->UpdateMechanics(static_cast<SizeValueType>(index));
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+CompactCellularAggregate<NSpaceDimension, TCoordinate>::CompactCells()
+{
+  if (m_NumberOfRemovedCells == 0)
+  {
+    return;
+  }
+
+  SizeValueType kept = 0;
+  for (SizeValueType index = 0; index < m_Cells.size(); ++index)
+  {
+    if (m_Cells[index] != nullptr)
+    {
+      m_Identifiers[kept] = m_Identifiers[index];
+      m_Mechanics[kept] = m_Mechanics[index];
+      m_Cells[kept] = m_Cells[index];
+      ++kept;
+    }
+  }
+  m_Identifiers.resize(kept);
+  m_Mechanics.resize(kept);
+  m_Cells.resize(kept);
+  m_NumberOfRemovedCells = 0;
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+CompactCellularAggregate<NSpaceDimension, TCoordinate>::SetEgg(BioCellType * cell, const PointType & position)
+{
+  if (cell == nullptr)
+  {
+    itkExceptionMacro(<< "The egg is a null pointer");
+  }
+
+  const IdentifierType cellId = cell->GetSelfIdentifier();
+  this->InsertCell(cell, position);
+  m_NeighborGraph.BeginRow(cellId);
+  this->Modified();
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+auto
+CompactCellularAggregate<NSpaceDimension, TCoordinate>::ComputeDivisionPerturbation(double perturbationLength)
+  -> VectorType
+{
+  // Same draws as CellularAggregate::ComputeDivisionPerturbation().
+  VectorType perturbationVector;
+  for (unsigned int d = 0; d < NSpaceDimension; d++)
+  {
+    perturbationVector[d] = this->GetUniformVariate(-1.0, 1.0);
+  }
+
+  const double norm = perturbationVector.GetNorm();
+  if (itk::Math::abs(norm) > 1e-10)
+  {
+    perturbationVector *= perturbationLength / norm;
+  }
+  else
+  {
+    perturbationVector[0] = perturbationLength;
+  }
+  return perturbationVector;
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+CompactCellularAggregate<NSpaceDimension, TCoordinate>::Add(CellBase * cellA, CellBase * cellB, double perturbationLength)
+{
+  auto * daughterA = dynamic_cast<BioCellType *>(cellA);
+  auto * daughterB = dynamic_cast<BioCellType *>(cellB);
+  if (daughterA == nullptr || daughterB == nullptr)
+  {
+    itkExceptionMacro(<< "dynamic_cast failed.");
+  }
+
+  const IdentifierType parentId = daughterA->GetParentIdentifier();
+  PointType            position;
+  if (!this->GetCellPosition(parentId, position))
+  {
+    itkExceptionMacro(<< "Parent cell " << parentId << " does not exist in the aggregate");
+  }
+
+  const VectorType perturbationVector = this->ComputeDivisionPerturbation(perturbationLength);
+
+  // Each daughter inherits the neighbors of its parent, and is added to
+  // their lists. Adding neighbors may move the rows of the graph, so the
+  // row is copied first.
+  BioCellType * const  daughters[2] = { daughterA, daughterB };
+  const PointType      positions[2] = { position + perturbationVector, position - perturbationVector };
+  for (unsigned int i = 0; i < 2; ++i)
+  {
+    const IdentifierType daughterId = daughters[i]->GetSelfIdentifier();
+    this->InsertCell(daughters[i], positions[i]);
+    m_NeighborGraph.CopyRow(daughterId, parentId);
+
+    const InlineNeighborList<> neighbors(m_NeighborGraph.Begin(daughterId), m_NeighborGraph.End(daughterId));
+    for (const IdentifierType neighborId : neighbors)
+    {
+      m_NeighborGraph.AddNeighbor(neighborId, daughterId);
+    }
+  }
+
+  const IdentifierType cellAId = daughterA->GetSelfIdentifier();
+  const IdentifierType cellBId = daughterB->GetSelfIdentifier();
+
+  m_NeighborGraph.AddNeighbor(cellAId, cellBId);
+  m_NeighborGraph.AddNeighbor(cellBId, cellAId);
+  this->Modified();
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+CompactCellularAggregate<NSpaceDimension, TCoordinate>::Divide(CellBase * mother,
+                                                              CellBase * daughterA,
+                                                              CellBase * daughterB,
+                                                              double     perturbationLength)
+{
+  auto * cellA = dynamic_cast<BioCellType *>(daughterA);
+  auto * cellB = dynamic_cast<BioCellType *>(daughterB);
+  if (mother == nullptr || cellA == nullptr || cellB == nullptr)
+  {
+    itkExceptionMacro(<< "dynamic_cast failed.");
+  }
+
+  const IdentifierType motherId = mother->GetSelfIdentifier();
+  const IdentifierType cellBId = cellB->GetSelfIdentifier();
+  const SizeValueType  motherIndex = this->FindCell(motherId);
+
+  if (cellA->GetSelfIdentifier() != motherId || motherIndex == m_Cells.size())
+  {
+    itkExceptionMacro(<< "The first daughter must take over the identifier of the mother " << motherId);
+  }
+
+  const PointType  position = m_Mechanics[motherIndex].m_Position;
+  const VectorType perturbationVector = this->ComputeDivisionPerturbation(perturbationLength);
+
+  // The first daughter replaces the mother in its slot and keeps its row
+  // of the neighbor graph. The mother is deleted by AdvanceCellCycles().
+  m_Mechanics[motherIndex].m_Position = position + perturbationVector;
+  m_Cells[motherIndex] = cellA;
+  cellA->SetCellularAggregate(this);
+  this->UpdateMechanics(motherIndex);
+
+  this->InsertCell(cellB, position - perturbationVector);
+  m_NeighborGraph.CopyRow(cellBId, motherId);
+
+  const InlineNeighborList<> neighbors(m_NeighborGraph.Begin(motherId), m_NeighborGraph.End(motherId));
+  for (const IdentifierType neighborId : neighbors)
+  {
+    m_NeighborGraph.AddNeighbor(neighborId, cellBId);
+  }
+
+  m_NeighborGraph.AddNeighbor(motherId, cellBId);
+  m_NeighborGraph.AddNeighbor(cellBId, motherId);
+  this->Modified();
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+CompactCellularAggregate<NSpaceDimension, TCoordinate>::Remove(CellBase * cellBase)
+{
+  auto * cell = dynamic_cast<BioCellType *>(cellBase);
+  if (cell == nullptr)
+  {
+    itkExceptionMacro(<< "Trying to remove a null pointer to cell");
+  }
+
+  const IdentifierType cellId = cell->GetSelfIdentifier();
+  const SizeValueType  index = this->FindCell(cellId);
+  if (index == m_Cells.size() || m_Cells[index] != cell)
+  {
+    itkExceptionMacro(<< "Cell " << cellId << " is not in the aggregate");
+  }
+
+  const IdentifierType * neighborEnd = m_NeighborGraph.End(cellId);
+  for (const IdentifierType * neighbor = m_NeighborGraph.Begin(cellId); neighbor != neighborEnd; ++neighbor)
+  {
+    if (m_NeighborGraph.HasRow(*neighbor))
+    {
+      m_NeighborGraph.RemoveNeighbor(*neighbor, cellId);
+    }
+  }
+  m_NeighborGraph.RemoveRow(cellId);
+
+  // The entry is dropped at the end of the cell cycle pass, which iterates
+  // over the arrays.
+  m_Cells[index] = nullptr;
+  ++m_NumberOfRemovedCells;
+  delete cell;
+  this->Modified();
+
+  if (!m_AdvancingCellCycles)
+  {
+    this->CompactCells();
+  }
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+CompactCellularAggregate<NSpaceDimension, TCoordinate>::AdvanceTimeStep()
+{
+  if (m_Iteration % m_ClosestPointComputationInterval == 0)
+  {
+    this->ComputeClosestPoints();
+  }
+
+  this->ComputeForces();
+  this->UpdatePositions();
+  this->AdvanceCellCycles();
+
+  m_Iteration++;
+  this->Modified();
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+CompactCellularAggregate<NSpaceDimension, TCoordinate>::AdvanceTimeSteps(SizeValueType numberOfSteps)
+{
+  for (SizeValueType step = 0; step < numberOfSteps; ++step)
+  {
+    this->AdvanceTimeStep();
+  }
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+CompactCellularAggregate<NSpaceDimension, TCoordinate>::AdvanceCellCycles()
+{
+  m_AdvancingCellCycles = true;
+
+  // The daughters added during the pass have larger identifiers than
+  // their mother, so their cycle is also advanced in this pass. The
+  // removed cells keep their entry until the end of the pass.
+  SizeValueType index = 0;
+  while (index < m_Cells.size())
+  {
+    BioCellType * theCell = m_Cells[index];
+    if (theCell == nullptr)
+    {
+      ++index;
+      continue;
+    }
+    const IdentifierType cellId = m_Identifiers[index];
+
+    theCell->AdvanceTimeStep();
+
+    // A cell that died by apoptosis has already been removed.
+    index = this->FindCell(cellId);
+    if (index != m_Cells.size())
+    {
+      if (m_Cells[index] != theCell)
+      {
+        // The cell divided in place. Its first daughter now holds the
+        // identifier, and starts its cycle in this pass like the second one.
+        delete theCell;
+        continue;
+      }
+      if (theCell->MarkedForRemoval())
+      {
+        this->Remove(theCell);
+      }
+      else
+      {
+        this->UpdateMechanics(index);
+      }
+    }
+    index = static_cast<SizeValueType>(std::upper_bound(m_Identifiers.begin(), m_Identifiers.end(), cellId) -
+                                       m_Identifiers.begin());
+  }
+
+  m_AdvancingCellCycles = false;
+  this->CompactCells();
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+CompactCellularAggregate<NSpaceDimension, TCoordinate>::UpdateMechanics(SizeValueType index)
+{
+  const BioCellType * cell = m_Cells[index];
+  MechanicsRecord &   record = m_Mechanics[index];
+
+  // Same factor as in Cell::AddForce().
+  record.m_Radius = cell->GetRadius();
+  record.m_PressureFactor = 1.0 / std::pow(record.m_Radius, static_cast<double>(NSpaceDimension));
+  record.m_IgnoresForces = cell->IgnoresForces();
+  record.m_Force.Fill(0.0);
+  record.m_Pressure = 0.0;
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+CompactCellularAggregate<NSpaceDimension, TCoordinate>::ComputeClosestPoints()
+{
+  const SizeValueType numberOfCells = m_Mechanics.size();
+
+  // The graph is rebuilt in bulk, in increasing order of identifier, reusing
+  // the memory of the previous graph.
+  m_NeighborGraph.Clear();
+  m_NeighborGraph.Reserve(numberOfCells, m_NeighborGraph.GetStorageSize());
+
+  for (SizeValueType i = 0; i < numberOfCells; ++i)
+  {
+    const PointType &    position1 = m_Mechanics[i].m_Position;
+    const CoordinateType radius = m_Mechanics[i].m_Radius;
+    const CoordinateType limitDistance = radius * 4;
+
+    m_NeighborGraph.BeginRow(m_Identifiers[i]);
+
+    for (SizeValueType j = 0; j < numberOfCells; ++j)
+    {
+      if (j == i)
+      {
+        continue;
+      }
+      const VectorType     relativePosition = position1 - m_Mechanics[j].m_Position;
+      const CoordinateType distance = relativePosition.GetNorm();
+      if (distance < limitDistance)
+      {
+        m_NeighborGraph.PushBack(m_Identifiers[j]);
+      }
+    }
+  }
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+CompactCellularAggregate<NSpaceDimension, TCoordinate>::ComputeForces()
+{
+  // Accumulates a force as Cell::AddForce().
+  const auto addForce = [](MechanicsRecord & record, const VectorType & force) {
+    if (!record.m_IgnoresForces)
+    {
+      record.m_Force += force;
+      record.m_Pressure += force.GetNorm() * record.m_PressureFactor;
+    }
+  };
+
+  // The neighbor lists hold identifiers. While the identifiers of the cells
+  // are dense, the indices of the cells are tabulated once instead of
+  // searching each neighbor in the arrays. Once the dead cells leave more
+  // identifiers unused than cells remain, the table would grow with the
+  // number of births, and the neighbors are searched instead.
+  const SizeValueType  numberOfCells = m_Cells.size();
+  const IdentifierType firstIdentifier = numberOfCells > 0 ? m_Identifiers.front() : 0;
+  const SizeValueType  identifierSpan = numberOfCells > 0 ? m_Identifiers.back() - firstIdentifier + 1 : 0;
+  const bool           useCellIndices = identifierSpan <= 2 * numberOfCells;
+  if (useCellIndices)
+  {
+    m_CellIndices.assign(identifierSpan, numberOfCells);
+    for (SizeValueType i = 0; i < numberOfCells; ++i)
+    {
+      if (m_Cells[i] != nullptr)
+      {
+        m_CellIndices[m_Identifiers[i] - firstIdentifier] = i;
+      }
+    }
+  }
+  else
+  {
+    m_CellIndices.clear();
+    m_CellIndices.shrink_to_fit();
+  }
+
+  for (SizeValueType i = 0; i < numberOfCells; ++i)
+  {
+    MechanicsRecord &    record1 = m_Mechanics[i];
+    const CoordinateType rA = record1.m_Radius;
+    const CoordinateType growthRadiusLimit = m_Cells[i]->GetCellParameters().m_GrowthRadiusLimit;
+
+    const IdentifierType *       neighbor = m_NeighborGraph.Begin(m_Identifiers[i]);
+    const IdentifierType * const neighborEnd = m_NeighborGraph.End(m_Identifiers[i]);
+    for (; neighbor != neighborEnd; ++neighbor)
+    {
+      // The neighbors removed since the last search are skipped. The
+      // identifiers below the first one wrap around beyond the table.
+      SizeValueType j = numberOfCells;
+      if (useCellIndices)
+      {
+        const IdentifierType offset = *neighbor - firstIdentifier;
+        j = offset < identifierSpan ? m_CellIndices[offset] : numberOfCells;
+      }
+      else
+      {
+        j = this->FindCell(*neighbor);
+      }
+      if (j == numberOfCells)
+      {
+        continue;
+      }
+
+      MechanicsRecord & record2 = m_Mechanics[j];
+      if (record1.m_IgnoresForces && record2.m_IgnoresForces)
+      {
+        continue;
+      }
+
+      const CoordinateType rB = record2.m_Radius;
+      const VectorType     relativePosition = record1.m_Position - record2.m_Position;
+      const CoordinateType distance = relativePosition.GetNorm();
+
+      if (distance < (rA + rB) / 2.0)
+      {
+        const CoordinateType factor = 2.0 * growthRadiusLimit / distance;
+        const VectorType     force = relativePosition * factor;
+        addForce(record1, force);
+        addForce(record2, -force);
+      }
+      else if (distance < rA + rB)
+      {
+        addForce(record1, relativePosition);
+        addForce(record2, -relativePosition);
+      }
+    }
+  }
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+CompactCellularAggregate<NSpaceDimension, TCoordinate>::UpdatePositions()
+{
+  m_MaximumDisplacement = 0.0;
+
+  for (SizeValueType i = 0; i < m_Mechanics.size(); ++i)
+  {
+    MechanicsRecord & record = m_Mechanics[i];
+    const double      forceNorm = record.m_Force.GetNorm();
+    if (forceNorm > m_FrictionForce)
+    {
+      record.m_Position += record.m_Force / 50.0;
+      m_MaximumDisplacement = std::max(m_MaximumDisplacement, forceNorm / 50.0);
+    }
+
+    // The cell cycle reads the pressure.
+    m_Cells[i]->m_Pressure = record.m_Pressure;
+  }
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+CompactCellularAggregate<NSpaceDimension, TCoordinate>::AddSubstrate(SubstrateType * substrate)
+{
+  m_Substrates.push_back(substrate);
+  this->Modified();
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+auto
+CompactCellularAggregate<NSpaceDimension, TCoordinate>::GetSubstrateValue(IdentifierType cellId,
+                                                                         unsigned int   substrateId) const
+  -> SubstrateValueType
+{
+  const SizeValueType cellIndex = this->FindCell(cellId);
+  if (cellIndex == m_Cells.size())
+  {
+    std::cerr << " Cell position doesn't exist for cell Id = ";
+    std::cerr << cellId << std::endl;
+    return itk::NumericTraits<SubstrateValueType>::ZeroValue();
+  }
+
+  const SubstrateType *             substrate = m_Substrates[substrateId];
+  typename SubstrateType::IndexType pixelIndex;
+  substrate->TransformPhysicalPointToIndex(m_Mechanics[cellIndex].m_Position, pixelIndex);
+
+  SubstrateValueType value = 0;
+  if (substrate->GetBufferedRegion().IsInside(pixelIndex))
+  {
+    value = substrate->GetPixel(pixelIndex);
+  }
+  return value;
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+CompactCellularAggregate<NSpaceDimension, TCoordinate>::KillAll()
+{
+  for (BioCellType * cell : m_Cells)
+  {
+    delete cell;
+  }
+  m_Identifiers.clear();
+  m_Mechanics.clear();
+  m_Cells.clear();
+  m_NumberOfRemovedCells = 0;
+  m_NeighborGraph.Clear();
+  this->Modified();
+
+  BioCellType::ResetCounter();
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+auto
+CompactCellularAggregate<NSpaceDimension, TCoordinate>::ExportPointSet() const -> PointSetPointer
+{
+  auto pointSet = PointSetType::New();
+  auto points = PointSetType::PointsContainer::New();
+  auto pointData = PointSetType::PointDataContainer::New();
+
+  for (SizeValueType i = 0; i < m_Cells.size(); ++i)
+  {
+    if (m_Cells[i] != nullptr)
+    {
+      points->InsertElement(m_Identifiers[i], m_Mechanics[i].m_Position);
+      pointData->InsertElement(m_Identifiers[i], m_Cells[i]);
+    }
+  }
+  pointSet->SetPoints(points);
+  pointSet->SetPointData(pointData);
+  return pointSet;
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+auto
+CompactCellularAggregate<NSpaceDimension, TCoordinate>::CreateMesh() -> MeshPointer
+{
+  auto mesh = MeshType::New();
+  mesh->SetCellsAllocationMethod(MeshEnums::MeshClassCellsAllocationMethod::CellsAllocatedDynamicallyCellByCell);
+  mesh->SetPoints(MeshType::PointsContainer::New());
+  mesh->SetPointData(MeshType::PointDataContainer::New());
+  mesh->SetCells(MeshType::CellsContainer::New());
+  return mesh;
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+CompactCellularAggregate<NSpaceDimension, TCoordinate>::CopyCellsToMesh(MeshType * mesh) const
+{
+  typename MeshType::PointsContainer *    points = mesh->GetPoints();
+  typename MeshType::PointDataContainer * pointData = mesh->GetPointData();
+  points->Initialize();
+  pointData->Initialize();
+
+  for (SizeValueType i = 0; i < m_Cells.size(); ++i)
+  {
+    if (m_Cells[i] != nullptr)
+    {
+      points->InsertElement(m_Identifiers[i], m_Mechanics[i].m_Position);
+      pointData->InsertElement(m_Identifiers[i], m_Cells[i]);
+    }
+  }
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+CompactCellularAggregate<NSpaceDimension, TCoordinate>::CopyVoronoiRegionsToMesh(MeshType * mesh) const
+{
+  typename MeshType::CellsContainer * regions = mesh->GetCells();
+  for (auto region = regions->Begin(); region != regions->End(); ++region)
+  {
+    delete region.Value();
+  }
+  regions->Initialize();
+
+  for (const IdentifierType cellId : m_NeighborGraph.GetRowIdentifiers())
+  {
+    auto * voronoiRegion = new VoronoiRegionType;
+    voronoiRegion->SetPointIds(m_NeighborGraph.Begin(cellId), m_NeighborGraph.End(cellId));
+
+    typename MeshType::CellAutoPointer regionPointer;
+    regionPointer.TakeOwnership(voronoiRegion);
+    mesh->SetCell(cellId, regionPointer);
+  }
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+auto
+CompactCellularAggregate<NSpaceDimension, TCoordinate>::ExportMesh() const -> MeshPointer
+{
+  MeshPointer mesh = CreateMesh();
+  this->CopyCellsToMesh(mesh);
+  this->CopyVoronoiRegionsToMesh(mesh);
+  return mesh;
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+auto
+CompactCellularAggregate<NSpaceDimension, TCoordinate>::GetMesh() const -> const MeshType *
+{
+  if (m_Mesh.IsNull())
+  {
+    m_Mesh = CreateMesh();
+  }
+
+  if (m_MeshTime != this->GetMTime())
+  {
+    this->CopyCellsToMesh(m_Mesh);
+    m_MeshTime = this->GetMTime();
+  }
+
+  if (m_VoronoiRegionsTimeStamp != m_NeighborGraph.GetTimeStamp())
+  {
+    this->CopyVoronoiRegionsToMesh(m_Mesh);
+    m_VoronoiRegionsTimeStamp = m_NeighborGraph.GetTimeStamp();
+  }
+
+  return m_Mesh;
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+CompactCellularAggregate<NSpaceDimension, TCoordinate>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "NumberOfCells: " << this->GetNumberOfCells() << std::endl;
+  os << indent << "NumberOfSubstrates: " << m_Substrates.size() << std::endl;
+  os << indent << "Iteration: " << m_Iteration << std::endl;
+  os << indent << "ClosestPointComputationInterval: " << m_ClosestPointComputationInterval << std::endl;
+  os << indent << "FrictionForce: " << m_FrictionForce << std::endl;
+  os << indent << "MaximumDisplacement: " << m_MaximumDisplacement << std::endl;
+}
+} // end namespace bio
+} // end namespace itk
+
+#endif
@@ -0,0 +1,195 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkBioDistributedCellularAggregate_h
+#define itkBioDistributedCellularAggregate_h
+
+#include "itkBioCellularAggregate.h"
+#include "itkBioTransport.h"
+
+#include <vector>
+
+namespace itk
+{
+namespace bio
+{
+/** \class DistributedCellularAggregate
+ * \brief CellularAggregate whose cells are distributed over several processes.
+ *
+ * Space is partitioned in slabs along the DecompositionAxis, one per rank
+ * of the Transport, and each process simulates the cells whose center is
+ * in its slab. At the beginning of each time step:
+ *
+ * - the cells that left the slab of the rank migrate to the rank that owns
+ *   their new position, with their complete state, in the format of the
+ *   checkpoint records;
+ * - the ranks send each other the position, radius and reaction to forces
+ *   of the cells that are closer to their slab than the range of the
+ *   neighbor search. These halo cells push the cells of the rank as their
+ *   neighbors would in a single aggregate, and wake up the sleeping cells
+ *   they disturb, but they are not part of the aggregate.
+ *
+ * The processes must all execute the same number of time steps, so only
+ * the MaximumNumberOfIterations stopping criterion of Run() can be used.
+ * Each rank draws from its own random generator, which should be seeded
+ * differently on each rank. The result is therefore not the one of a
+ * single aggregate with the same cells, although it follows the same
+ * rules.
+ *
+ * Each rank writes and reads its own checkpoints, in the format of
+ * CellularAggregate, and the slab boundaries must be set again when a
+ * simulation is restored.
+ *
+ * Without a transport, or with a single rank, the aggregate behaves as a
+ * CellularAggregate.
+ *
+ * \ingroup ITKBioCell
+ */
+template <unsigned int NSpaceDimension = 3, typename TCoordinate = double>
+class ITK_TEMPLATE_EXPORT DistributedCellularAggregate : public CellularAggregate<NSpaceDimension, TCoordinate>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(DistributedCellularAggregate);
+
+  /** Standard class type alias. */
+  using Self = DistributedCellularAggregate;
+  using Superclass = CellularAggregate<NSpaceDimension, TCoordinate>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /*** Run-time type information (and related methods). */
+  itkTypeMacro(DistributedCellularAggregate, CellularAggregate);
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  static constexpr unsigned int SpaceDimension = NSpaceDimension;
+
+  using BioCellType = typename Superclass::BioCellType;
+  using PointType = typename Superclass::PointType;
+  using VectorType = typename Superclass::VectorType;
+  using SubstrateType = typename Superclass::SubstrateType;
+  using CheckpointCellRecord = typename Superclass::CheckpointCellRecord;
+
+  /** Transport connecting the ranks of the simulation. */
+  itkSetObjectMacro(Transport, Transport);
+  itkGetModifiableObjectMacro(Transport, Transport);
+
+  /** Rank of this process, and number of ranks of the simulation. */
+  unsigned int
+  GetRank() const;
+
+  unsigned int
+  GetNumberOfRanks() const;
+
+  /** Axis along which space is partitioned. Default is 0. */
+  itkSetMacro(DecompositionAxis, unsigned int);
+  itkGetConstMacro(DecompositionAxis, unsigned int);
+
+  /** Positions of the boundaries between the slabs of consecutive ranks
+   *  along the decomposition axis, in increasing order. When they are not
+   *  set, the extent of the first substrate is divided in slabs of equal
+   *  width at the first time step. */
+  void
+  SetSlabBoundaries(const std::vector<double> & boundaries);
+
+  const std::vector<double> &
+  GetSlabBoundaries() const
+  {
+    return m_SlabBoundaries;
+  }
+
+  /** Rank whose slab contains the point. */
+  unsigned int
+  ComputeRank(const PointType & point) const;
+
+  void
+  AdvanceTimeStep() override;
+
+  /** Number of cells of all the ranks. All the ranks must call it. */
+  SizeValueType
+  GetGlobalNumberOfCells();
+
+  /** Number of cells that left or joined the rank since its creation. */
+  itkGetConstMacro(NumberOfEmigratedCells, SizeValueType);
+  itkGetConstMacro(NumberOfImmigratedCells, SizeValueType);
+
+  /** Number of halo cells received at the last time step. */
+  SizeValueType
+  GetNumberOfHaloCells() const
+  {
+    return m_HaloCells.size();
+  }
+
+protected:
+  DistributedCellularAggregate() = default;
+  ~DistributedCellularAggregate() override = default;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  /** Add the forces of the halo cells to the cells of the rank. */
+  void
+  ComputeForces() override;
+
+  /** Divide the extent of the first substrate in slabs, unless the
+   *  boundaries are set. */
+  void
+  InitializeSlabBoundaries();
+
+  /** Send the cells out of the slab of the rank to their new rank, and
+   *  insert the cells received from the other ranks. */
+  void
+  MigrateCells();
+
+  /** Exchange the cells close to the slabs of the other ranks. */
+  void
+  ExchangeHaloCells();
+
+private:
+  /** Cell of another rank, close to the slab of this rank. */
+  struct HaloCellRecord
+  {
+    double       m_Position[NSpaceDimension];
+    double       m_Radius;
+    std::uint8_t m_IgnoresForces;
+    std::uint8_t m_Padding[7];
+  };
+
+  Transport::Pointer  m_Transport;
+  unsigned int        m_DecompositionAxis{ 0 };
+  std::vector<double> m_SlabBoundaries;
+
+  // Largest radius of the cells of all the ranks, known after the migration.
+  double m_MaximumRadius{ 0.0 };
+
+  std::vector<HaloCellRecord> m_HaloCells;
+
+  // Cells of the rank that may have halo cells as neighbors.
+  std::vector<IdentifierType> m_BoundaryCells;
+
+  SizeValueType m_NumberOfEmigratedCells{ 0 };
+  SizeValueType m_NumberOfImmigratedCells{ 0 };
+};
+} // end namespace bio
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkBioDistributedCellularAggregate.hxx"
+#endif
+
+#endif
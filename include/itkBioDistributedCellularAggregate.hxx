@@ -0,0 +1,448 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkBioDistributedCellularAggregate_hxx
+#define itkBioDistributedCellularAggregate_hxx
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+
+namespace itk
+{
+namespace bio
+{
+template <unsigned int NSpaceDimension, typename TCoordinate>
+unsigned int
+DistributedCellularAggregate<NSpaceDimension, TCoordinate>::GetRank() const
+{
+  return m_Transport ? m_Transport->GetRank() : 0;
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+unsigned int
+DistributedCellularAggregate<NSpaceDimension, TCoordinate>::GetNumberOfRanks() const
+{
+  return m_Transport ? m_Transport->GetNumberOfRanks() : 1;
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+DistributedCellularAggregate<NSpaceDimension, TCoordinate>::SetSlabBoundaries(const std::vector<double> & boundaries)
+{
+  if (!std::is_sorted(boundaries.begin(), boundaries.end()))
+  {
+    itkExceptionMacro(<< "The slab boundaries must be in increasing order");
+  }
+  m_SlabBoundaries = boundaries;
+  this->Modified();
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+unsigned int
+DistributedCellularAggregate<NSpaceDimension, TCoordinate>::ComputeRank(const PointType & point) const
+{
+  return static_cast<unsigned int>(
+    std::upper_bound(m_SlabBoundaries.begin(), m_SlabBoundaries.end(), point[m_DecompositionAxis]) -
+    m_SlabBoundaries.begin());
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+DistributedCellularAggregate<NSpaceDimension, TCoordinate>::AdvanceTimeStep()
+{
+  if (this->GetNumberOfRanks() < 2)
+  {
+    m_HaloCells.clear();
+    m_BoundaryCells.clear();
+    Superclass::AdvanceTimeStep();
+    return;
+  }
+
+  this->InitializeSlabBoundaries();
+
+  {
+    itkBioCellTraceSpanMacro("Migration", "BioCell");
+    this->MigrateCells();
+  }
+
+  {
+    itkBioCellTraceSpanMacro("HaloExchange", "BioCell");
+    this->ExchangeHaloCells();
+  }
+
+  Superclass::AdvanceTimeStep();
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+SizeValueType
+DistributedCellularAggregate<NSpaceDimension, TCoordinate>::GetGlobalNumberOfCells()
+{
+  const SizeValueType numberOfCells = this->GetNumberOfCells();
+  return m_Transport ? m_Transport->AllReduceSum(numberOfCells) : numberOfCells;
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+DistributedCellularAggregate<NSpaceDimension, TCoordinate>::InitializeSlabBoundaries()
+{
+  const unsigned int numberOfRanks = this->GetNumberOfRanks();
+  if (m_SlabBoundaries.size() + 1 == numberOfRanks)
+  {
+    return;
+  }
+  if (!m_SlabBoundaries.empty())
+  {
+    itkExceptionMacro(<< m_SlabBoundaries.size() << " slab boundaries for " << numberOfRanks << " ranks");
+  }
+  if (m_DecompositionAxis >= NSpaceDimension)
+  {
+    itkExceptionMacro(<< "Invalid decomposition axis " << m_DecompositionAxis);
+  }
+  if (this->GetSubstrates().empty())
+  {
+    itkExceptionMacro(<< "The slab boundaries must be set when the aggregate has no substrate");
+  }
+
+  const SubstrateType * substrate = this->GetSubstrates().front();
+  const auto &          region = substrate->GetLargestPossibleRegion();
+
+  PointType first;
+  PointType last;
+  substrate->TransformIndexToPhysicalPoint(region.GetIndex(), first);
+  substrate->TransformIndexToPhysicalPoint(region.GetUpperIndex(), last);
+
+  const double lower = std::min(first[m_DecompositionAxis], last[m_DecompositionAxis]);
+  const double upper = std::max(first[m_DecompositionAxis], last[m_DecompositionAxis]);
+  for (unsigned int rank = 1; rank < numberOfRanks; ++rank)
+  {
+    m_SlabBoundaries.push_back(lower + (upper - lower) * rank / numberOfRanks);
+  }
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+DistributedCellularAggregate<NSpaceDimension, TCoordinate>::MigrateCells()
+{
+  const unsigned int numberOfRanks = this->GetNumberOfRanks();
+  const unsigned int rank = this->GetRank();
+  const auto *       points = this->GetPoints();
+  const auto *       pointData = this->GetPointData();
+
+  double                                   maximumRadius = 0.0;
+  std::vector<std::vector<IdentifierType>> emigrants(numberOfRanks);
+
+  auto cell = pointData->Begin();
+  for (auto point = points->Begin(); point != points->End(); ++point, ++cell)
+  {
+    maximumRadius = std::max(maximumRadius, cell.Value()->GetRadius());
+    const unsigned int owner = this->ComputeRank(point.Value());
+    if (owner != rank)
+    {
+      emigrants[owner].push_back(point.Index());
+    }
+  }
+
+  // The message to each rank holds the largest radius of this rank, the
+  // number of emigrants, their checkpoint records and then their genomes.
+  Transport::BufferVector outgoing(numberOfRanks);
+  for (unsigned int peer = 0; peer < numberOfRanks; ++peer)
+  {
+    if (peer == rank)
+    {
+      continue;
+    }
+
+    const std::uint64_t               numberOfCells = emigrants[peer].size();
+    std::vector<CheckpointCellRecord> records(numberOfCells);
+    std::vector<BioCellType *>        cells(numberOfCells);
+    for (SizeValueType i = 0; i < numberOfCells; ++i)
+    {
+      const IdentifierType cellId = emigrants[peer][i];
+
+      // The steps skipped by a sleeping cell are applied before it leaves.
+      this->WakeUp(cellId);
+
+      PointType position;
+      points->GetElementIfIndexExists(cellId, &position);
+      pointData->GetElementIfIndexExists(cellId, &cells[i]);
+      Superclass::FillCheckpointRecord(cellId, cells[i], position, records[i]);
+    }
+
+    std::ostringstream message;
+    message.write(reinterpret_cast<const char *>(&maximumRadius), sizeof(maximumRadius));
+    message.write(reinterpret_cast<const char *>(&numberOfCells), sizeof(numberOfCells));
+    message.write(reinterpret_cast<const char *>(records.data()),
+                  static_cast<std::streamsize>(records.size() * sizeof(CheckpointCellRecord)));
+    for (const BioCellType * emigrant : cells)
+    {
+      Superclass::WriteCheckpointGenomes(emigrant, message);
+    }
+
+    const std::string bytes = message.str();
+    outgoing[peer].assign(bytes.begin(), bytes.end());
+
+    for (BioCellType * emigrant : cells)
+    {
+      this->Remove(emigrant);
+    }
+    m_NumberOfEmigratedCells += numberOfCells;
+  }
+
+  Transport::BufferVector incoming;
+  m_Transport->Exchange(outgoing, incoming);
+
+  // The immigrants get new identifiers, and start without neighbors until
+  // the neighbor search that follows.
+  m_MaximumRadius = maximumRadius;
+  SizeValueType numberOfImmigrants = 0;
+  for (unsigned int peer = 0; peer < numberOfRanks; ++peer)
+  {
+    if (peer == rank)
+    {
+      continue;
+    }
+
+    std::istringstream message(std::string(incoming[peer].begin(), incoming[peer].end()));
+
+    double        peerMaximumRadius = 0.0;
+    std::uint64_t numberOfCells = 0;
+    message.read(reinterpret_cast<char *>(&peerMaximumRadius), sizeof(peerMaximumRadius));
+    message.read(reinterpret_cast<char *>(&numberOfCells), sizeof(numberOfCells));
+    if (!message || numberOfCells * sizeof(CheckpointCellRecord) > incoming[peer].size())
+    {
+      itkExceptionMacro(<< "Invalid migration message from rank " << peer);
+    }
+    m_MaximumRadius = std::max(m_MaximumRadius, peerMaximumRadius);
+
+    std::vector<CheckpointCellRecord> records(static_cast<SizeValueType>(numberOfCells));
+    message.read(reinterpret_cast<char *>(records.data()),
+                 static_cast<std::streamsize>(records.size() * sizeof(CheckpointCellRecord)));
+    for (const CheckpointCellRecord & record : records)
+    {
+      BioCellType * immigrant = Superclass::CreateCellFromCheckpointRecord(record, message);
+
+      PointType position;
+      for (unsigned int d = 0; d < NSpaceDimension; ++d)
+      {
+        position[d] = record.m_Position[d];
+      }
+      this->InsertCell(immigrant, position);
+    }
+    if (!message)
+    {
+      itkExceptionMacro(<< "Truncated migration message from rank " << peer);
+    }
+    numberOfImmigrants += records.size();
+  }
+  m_NumberOfImmigratedCells += numberOfImmigrants;
+
+  if (numberOfImmigrants > 0)
+  {
+    this->ComputeClosestPoints();
+  }
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+DistributedCellularAggregate<NSpaceDimension, TCoordinate>::ExchangeHaloCells()
+{
+  const unsigned int numberOfRanks = this->GetNumberOfRanks();
+  const unsigned int rank = this->GetRank();
+  const auto *       points = this->GetPoints();
+  const auto *       pointData = this->GetPointData();
+
+  // Range of the neighbor search of the largest cells.
+  const double haloWidth = 4.0 * m_MaximumRadius;
+
+  auto lowerBound = [this](unsigned int r) {
+    return (r > 0) ? m_SlabBoundaries[r - 1] : -NumericTraits<double>::infinity();
+  };
+  auto upperBound = [this, numberOfRanks](unsigned int r) {
+    return (r + 1 < numberOfRanks) ? m_SlabBoundaries[r] : NumericTraits<double>::infinity();
+  };
+
+  std::vector<std::vector<HaloCellRecord>> records(numberOfRanks);
+  m_BoundaryCells.clear();
+
+  auto cell = pointData->Begin();
+  for (auto point = points->Begin(); point != points->End(); ++point, ++cell)
+  {
+    const double coordinate = point.Value()[m_DecompositionAxis];
+    if (coordinate < lowerBound(rank) + haloWidth || coordinate >= upperBound(rank) - haloWidth)
+    {
+      m_BoundaryCells.push_back(point.Index());
+    }
+
+    for (unsigned int peer = 0; peer < numberOfRanks; ++peer)
+    {
+      if (peer != rank && coordinate >= lowerBound(peer) - haloWidth && coordinate < upperBound(peer) + haloWidth)
+      {
+        HaloCellRecord record;
+        std::memset(&record, 0, sizeof(record));
+        for (unsigned int d = 0; d < NSpaceDimension; ++d)
+        {
+          record.m_Position[d] = point.Value()[d];
+        }
+        record.m_Radius = cell.Value()->GetRadius();
+        record.m_IgnoresForces = cell.Value()->IgnoresForces();
+        records[peer].push_back(record);
+      }
+    }
+  }
+
+  Transport::BufferVector outgoing(numberOfRanks);
+  for (unsigned int peer = 0; peer < numberOfRanks; ++peer)
+  {
+    const char * bytes = reinterpret_cast<const char *>(records[peer].data());
+    outgoing[peer].assign(bytes, bytes + records[peer].size() * sizeof(HaloCellRecord));
+  }
+
+  Transport::BufferVector incoming;
+  m_Transport->Exchange(outgoing, incoming);
+
+  m_HaloCells.clear();
+  for (unsigned int peer = 0; peer < numberOfRanks; ++peer)
+  {
+    if (peer == rank)
+    {
+      continue;
+    }
+    if (incoming[peer].size() % sizeof(HaloCellRecord) != 0)
+    {
+      itkExceptionMacro(<< "Invalid halo message from rank " << peer);
+    }
+    const SizeValueType numberOfCells = incoming[peer].size() / sizeof(HaloCellRecord);
+    const SizeValueType offset = m_HaloCells.size();
+    m_HaloCells.resize(offset + numberOfCells);
+    std::memcpy(m_HaloCells.data() + offset, incoming[peer].data(), incoming[peer].size());
+  }
+
+  // The halo cells that react to forces wake up the sleeping cells that
+  // would have them as neighbors.
+  for (const IdentifierType cellId : m_BoundaryCells)
+  {
+    BioCellType * boundaryCell = nullptr;
+    PointType     position;
+    pointData->GetElementIfIndexExists(cellId, &boundaryCell);
+    points->GetElementIfIndexExists(cellId, &position);
+    const double radius = boundaryCell->GetRadius();
+
+    for (const HaloCellRecord & halo : m_HaloCells)
+    {
+      if (halo.m_IgnoresForces)
+      {
+        continue;
+      }
+      double squaredDistance = 0.0;
+      for (unsigned int d = 0; d < NSpaceDimension; ++d)
+      {
+        squaredDistance += (position[d] - halo.m_Position[d]) * (position[d] - halo.m_Position[d]);
+      }
+      const double range = 4.0 * std::max(radius, halo.m_Radius);
+      if (squaredDistance < range * range)
+      {
+        this->WakeUp(cellId);
+        break;
+      }
+    }
+  }
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+DistributedCellularAggregate<NSpaceDimension, TCoordinate>::ComputeForces()
+{
+  Superclass::ComputeForces();
+
+  if (m_HaloCells.empty())
+  {
+    return;
+  }
+
+  const auto * points = this->GetPoints();
+  const auto * pointData = this->GetPointData();
+
+  for (const IdentifierType cellId : m_BoundaryCells)
+  {
+    BioCellType * cell = nullptr;
+    PointType     position;
+    if (!pointData->GetElementIfIndexExists(cellId, &cell))
+    {
+      continue;
+    }
+    points->GetElementIfIndexExists(cellId, &position);
+
+    const double rA = cell->GetRadius();
+    const bool   cellIgnoresForces = cell->IgnoresForces();
+
+    for (const HaloCellRecord & halo : m_HaloCells)
+    {
+      if (cellIgnoresForces && halo.m_IgnoresForces)
+      {
+        continue;
+      }
+
+      PointType haloPosition;
+      for (unsigned int d = 0; d < NSpaceDimension; ++d)
+      {
+        haloPosition[d] = halo.m_Position[d];
+      }
+
+      const VectorType relativePosition = position - haloPosition;
+      const double     distance = relativePosition.GetNorm();
+      const double     rB = halo.m_Radius;
+      if (distance >= rA + rB)
+      {
+        continue;
+      }
+
+      VectorType force = relativePosition;
+      if (distance < (rA + rB) / 2.0)
+      {
+        force *= 2.0 * cell->GetCellParameters().m_GrowthRadiusLimit / distance;
+      }
+
+      // In a single aggregate the pair is visited from the neighbor list of
+      // each of the two cells that lists the other.
+      if (distance < 4.0 * rA)
+      {
+        cell->AddForce(force);
+      }
+      if (distance < 4.0 * rB)
+      {
+        cell->AddForce(force);
+      }
+    }
+  }
+}
+
+template <unsigned int NSpaceDimension, typename TCoordinate>
+void
+DistributedCellularAggregate<NSpaceDimension, TCoordinate>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "Transport: " << m_Transport.GetPointer() << std::endl;
+  os << indent << "DecompositionAxis: " << m_DecompositionAxis << std::endl;
+  os << indent << "NumberOfSlabBoundaries: " << m_SlabBoundaries.size() << std::endl;
+  os << indent << "NumberOfEmigratedCells: " << m_NumberOfEmigratedCells << std::endl;
+  os << indent << "NumberOfImmigratedCells: " << m_NumberOfImmigratedCells << std::endl;
+}
+} // end namespace bio
+} // end namespace itk
+
+#endif
@@ -29,6 +29,7 @@
 #include <map>
 #include <string>
 #include <cmath>
+#include <iostream>
 
 namespace itk
 {
@@ -68,6 +69,16 @@ public:
   void
   SetExpressionLevel(const GeneIdType & geneId, double level);
 
+  /** Write the genes and their levels of expression in binary form.
+   *  The format is the one used by the checkpoints of the CellularAggregate. */
+  void
+  WriteBinary(std::ostream & os) const;
+
+  /** Replace the content of this genome with the one previously
+   *  stored with WriteBinary(). */
+  void
+  ReadBinary(std::istream & is);
+
   /** This method computes a normalized Sigmoide function that can
    *  be used for gene network computations.  */
   static double
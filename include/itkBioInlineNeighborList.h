@@ -0,0 +1,186 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#ifndef itkBioInlineNeighborList_h
+#define itkBioInlineNeighborList_h
+
+#include "itkIntTypes.h"
+#include "itkMacro.h"
+
+#include <vector>
+
+namespace itk
+{
+namespace bio
+{
+/** \class InlineNeighborList
+ * \brief List of neighbor identifiers with inline storage for the common case.
+ *
+ * The first VInlineCapacity identifiers are stored inside the object
+ * itself, so that a list of the usual size of a neighborhood (6 to 30
+ * cells) does not allocate any memory. When the list outgrows the inline
+ * storage, all the identifiers are moved to the heap, and the list stays
+ * on the heap until it is destroyed, which lets a list reused as scratch
+ * space keep its capacity.
+ *
+ * Erase() preserves the order of the remaining identifiers.
+ *
+ * \ingroup ITKBioCell
+ */
+template <unsigned int VInlineCapacity = 32>
+class ITK_TEMPLATE_EXPORT InlineNeighborList
+{
+public:
+  using Iterator = IdentifierType *;
+  using ConstIterator = const IdentifierType *;
+
+  static constexpr unsigned int InlineCapacity = VInlineCapacity;
+
+  InlineNeighborList() = default;
+
+  template <typename TInputIterator>
+  InlineNeighborList(TInputIterator first, TInputIterator last)
+  {
+    this->Assign(first, last);
+  }
+
+  InlineNeighborList(const InlineNeighborList & other);
+  InlineNeighborList(InlineNeighborList && other) noexcept;
+
+  InlineNeighborList &
+  operator=(const InlineNeighborList & other);
+  InlineNeighborList &
+  operator=(InlineNeighborList && other) noexcept;
+
+  /** Replace the content of the list by the identifiers of the range. */
+  template <typename TInputIterator>
+  void
+  Assign(TInputIterator first, TInputIterator last);
+
+  void
+  PushBack(IdentifierType identifier);
+
+  /** Remove the first occurrence of the identifier. Returns false if the
+   *  identifier is not in the list. */
+  bool
+  Erase(IdentifierType identifier);
+
+  bool
+  Contains(IdentifierType identifier) const;
+
+  /** Remove all the identifiers, keeping the current storage. */
+  void
+  Clear();
+
+  SizeValueType
+  Size() const
+  {
+    return m_OnHeap ? m_Heap.size() : m_Size;
+  }
+
+  bool
+  Empty() const
+  {
+    return this->Size() == 0;
+  }
+
+  SizeValueType
+  Capacity() const
+  {
+    return m_OnHeap ? m_Heap.capacity() : VInlineCapacity;
+  }
+
+  /** True until the list overflows its inline storage. */
+  bool
+  IsInline() const
+  {
+    return !m_OnHeap;
+  }
+
+  IdentifierType &
+  operator[](SizeValueType index)
+  {
+    return this->Begin()[index];
+  }
+  const IdentifierType &
+  operator[](SizeValueType index) const
+  {
+    return this->Begin()[index];
+  }
+
+  Iterator
+  Begin()
+  {
+    return m_OnHeap ? m_Heap.data() : m_Inline;
+  }
+  ConstIterator
+  Begin() const
+  {
+    return m_OnHeap ? m_Heap.data() : m_Inline;
+  }
+  Iterator
+  End()
+  {
+    return this->Begin() + this->Size();
+  }
+  ConstIterator
+  End() const
+  {
+    return this->Begin() + this->Size();
+  }
+
+  /** Lower case aliases for range-based for loops. */
+  Iterator
+  begin()
+  {
+    return this->Begin();
+  }
+  ConstIterator
+  begin() const
+  {
+    return this->Begin();
+  }
+  Iterator
+  end()
+  {
+    return this->End();
+  }
+  ConstIterator
+  end() const
+  {
+    return this->End();
+  }
+
+private:
+  /** Move the identifiers to the heap, with room for at least the given number. */
+  void
+  Spill(SizeValueType capacity);
+
+  IdentifierType              m_Inline[VInlineCapacity];
+  SizeValueType               m_Size{ 0 };
+  bool                        m_OnHeap{ false };
+  std::vector<IdentifierType> m_Heap;
+};
+} // end namespace bio
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkBioInlineNeighborList.hxx"
+#endif
+
+#endif
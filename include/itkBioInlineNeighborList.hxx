@@ -0,0 +1,171 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#ifndef itkBioInlineNeighborList_hxx
+#define itkBioInlineNeighborList_hxx
+
+#include <algorithm>
+#include <iterator>
+
+namespace itk
+{
+namespace bio
+{
+template <unsigned int VInlineCapacity>
+InlineNeighborList<VInlineCapacity>::InlineNeighborList(const InlineNeighborList & other)
+{
+  this->Assign(other.Begin(), other.End());
+}
+
+template <unsigned int VInlineCapacity>
+InlineNeighborList<VInlineCapacity>::InlineNeighborList(InlineNeighborList && other) noexcept
+  : m_Size(other.m_Size)
+  , m_OnHeap(other.m_OnHeap)
+  , m_Heap(std::move(other.m_Heap))
+{
+  if (!m_OnHeap)
+  {
+    std::copy(other.m_Inline, other.m_Inline + m_Size, m_Inline);
+  }
+  other.m_Size = 0;
+  other.m_OnHeap = false;
+  other.m_Heap.clear();
+}
+
+template <unsigned int VInlineCapacity>
+InlineNeighborList<VInlineCapacity> &
+InlineNeighborList<VInlineCapacity>::operator=(const InlineNeighborList & other)
+{
+  if (this != &other)
+  {
+    this->Assign(other.Begin(), other.End());
+  }
+  return *this;
+}
+
+template <unsigned int VInlineCapacity>
+InlineNeighborList<VInlineCapacity> &
+InlineNeighborList<VInlineCapacity>::operator=(InlineNeighborList && other) noexcept
+{
+  if (this != &other)
+  {
+    m_Size = other.m_Size;
+    m_OnHeap = other.m_OnHeap;
+    m_Heap = std::move(other.m_Heap);
+    if (!m_OnHeap)
+    {
+      std::copy(other.m_Inline, other.m_Inline + m_Size, m_Inline);
+    }
+    other.m_Size = 0;
+    other.m_OnHeap = false;
+    other.m_Heap.clear();
+  }
+  return *this;
+}
+
+template <unsigned int VInlineCapacity>
+template <typename TInputIterator>
+void
+InlineNeighborList<VInlineCapacity>::Assign(TInputIterator first, TInputIterator last)
+{
+  const auto size = static_cast<SizeValueType>(std::distance(first, last));
+  if (!m_OnHeap && size > VInlineCapacity)
+  {
+    this->Spill(size);
+  }
+
+  if (m_OnHeap)
+  {
+    m_Heap.assign(first, last);
+  }
+  else
+  {
+    std::copy(first, last, m_Inline);
+    m_Size = size;
+  }
+}
+
+template <unsigned int VInlineCapacity>
+void
+InlineNeighborList<VInlineCapacity>::PushBack(IdentifierType identifier)
+{
+  if (!m_OnHeap && m_Size == VInlineCapacity)
+  {
+    this->Spill(2 * VInlineCapacity);
+  }
+
+  if (m_OnHeap)
+  {
+    m_Heap.push_back(identifier);
+  }
+  else
+  {
+    m_Inline[m_Size++] = identifier;
+  }
+}
+
+template <unsigned int VInlineCapacity>
+bool
+InlineNeighborList<VInlineCapacity>::Erase(IdentifierType identifier)
+{
+  const Iterator position = std::find(this->Begin(), this->End(), identifier);
+  if (position == this->End())
+  {
+    return false;
+  }
+
+  if (m_OnHeap)
+  {
+    m_Heap.erase(m_Heap.begin() + (position - this->Begin()));
+  }
+  else
+  {
+    std::copy(position + 1, this->End(), position);
+    --m_Size;
+  }
+  return true;
+}
+
+template <unsigned int VInlineCapacity>
+bool
+InlineNeighborList<VInlineCapacity>::Contains(IdentifierType identifier) const
+{
+  return std::find(this->Begin(), this->End(), identifier) != this->End();
+}
+
+template <unsigned int VInlineCapacity>
+void
+InlineNeighborList<VInlineCapacity>::Clear()
+{
+  m_Size = 0;
+  m_Heap.clear();
+}
+
+template <unsigned int VInlineCapacity>
+void
+InlineNeighborList<VInlineCapacity>::Spill(SizeValueType capacity)
+{
+  m_Heap.reserve(std::max<SizeValueType>(capacity, m_Size));
+  m_Heap.assign(m_Inline, m_Inline + m_Size);
+  m_Size = 0;
+  m_OnHeap = true;
+}
+} // end namespace bio
+} // end namespace itk
+
+#endif
@@ -0,0 +1,162 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#ifndef itkBioNeighborGraph_h
+#define itkBioNeighborGraph_h
+
+#include "itkIntTypes.h"
+#include "BioCellExport.h"
+
+#include <vector>
+
+namespace itk
+{
+namespace bio
+{
+/** \class NeighborGraph
+ * \brief Neighbor lists of the cells of an aggregate, stored in compressed sparse rows.
+ *
+ * The neighbors of all the cells are stored in a single array, each cell
+ * owning a row of consecutive entries. The table of rows is sorted by cell
+ * identifier, and the graph is meant to be rebuilt in bulk, the rows being
+ * appended with BeginRow() and PushBack() in increasing order of identifier.
+ *
+ * The rows can also be modified incrementally between two rebuilds. A row
+ * that grows beyond its capacity is moved to the end of the array, leaving
+ * a hole that is reclaimed by Compact(), which is also called automatically
+ * when the holes take more room than the neighbors.
+ *
+ * The order of the neighbors in a row is preserved by all the operations.
+ * Adding rows or neighbors invalidates the iterators on the rows, removing
+ * them does not.
+ *
+ * \ingroup ITKBioCell
+ */
+class BioCell_EXPORT NeighborGraph
+{
+public:
+  using ConstIterator = const IdentifierType *;
+
+  /** Remove all the rows. The memory is kept for the next rebuild. */
+  void
+  Clear();
+
+  void
+  Reserve(SizeValueType numberOfRows, SizeValueType numberOfNeighbors);
+
+  /** Start a new empty row for the cell, replacing its current row. */
+  void
+  BeginRow(IdentifierType cellId);
+
+  /** Append a neighbor to the row started last. */
+  void
+  PushBack(IdentifierType neighborId);
+
+  /** Replace the row of the cell by a copy of the row of another cell. */
+  void
+  CopyRow(IdentifierType cellId, IdentifierType sourceCellId);
+
+  /** Append a neighbor to the row of the cell. Returns false if the cell has no row. */
+  bool
+  AddNeighbor(IdentifierType cellId, IdentifierType neighborId);
+
+  /** Remove the first occurrence of the neighbor from the row of the cell. */
+  void
+  RemoveNeighbor(IdentifierType cellId, IdentifierType neighborId);
+
+  void
+  RemoveRow(IdentifierType cellId);
+
+  bool
+  HasRow(IdentifierType cellId) const;
+
+  /** Neighbors of the cell. The range is empty if the cell has no row. */
+  ConstIterator
+  Begin(IdentifierType cellId) const;
+  ConstIterator
+  End(IdentifierType cellId) const;
+
+  SizeValueType
+  GetNumberOfNeighbors(IdentifierType cellId) const;
+
+  /** Identifiers of the cells that have a row, in increasing order. */
+  std::vector<IdentifierType>
+  GetRowIdentifiers() const;
+
+  SizeValueType
+  GetNumberOfRows() const;
+
+  /** Total number of neighbors in all the rows. */
+  SizeValueType
+  GetNumberOfEntries() const;
+
+  /** Size of the array of neighbors, including the holes left by moved rows. */
+  SizeValueType
+  GetStorageSize() const;
+
+  /** Rewrite the rows without holes, in increasing order of identifier. */
+  void
+  Compact();
+
+  /** Rewrite the rows without holes, in the given order of cells. The rows
+   *  of the cells missing from the order are written last. */
+  void
+  Compact(const std::vector<IdentifierType> & order);
+
+  /** Counter incremented by every modification of the graph. */
+  SizeValueType
+  GetTimeStamp() const;
+
+private:
+  struct Row
+  {
+    IdentifierType m_CellId;
+    SizeValueType  m_Offset;
+    SizeValueType  m_Size;
+    SizeValueType  m_Capacity;
+    bool           m_Removed;
+  };
+
+  Row *
+  FindRow(IdentifierType cellId);
+  const Row *
+  FindRow(IdentifierType cellId) const;
+
+  /** Return the row of the cell, creating an empty one if needed. */
+  Row &
+  InsertRow(IdentifierType cellId);
+
+  /** Move the row to the end of the array with room for the given number of neighbors. */
+  void
+  Relocate(Row & row, SizeValueType capacity);
+
+  void
+  CompactIfFragmented();
+
+  // Removed rows stay in the table until the next compaction.
+  std::vector<Row>            m_Rows;
+  std::vector<IdentifierType> m_Neighbors;
+  SizeValueType               m_LastRow{ 0 };
+  SizeValueType               m_NumberOfRemovedRows{ 0 };
+  SizeValueType               m_NumberOfEntries{ 0 };
+  SizeValueType               m_TimeStamp{ 0 };
+};
+} // end namespace bio
+} // end namespace itk
+
+#endif
@@ -0,0 +1,176 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkBioSpeciesCell_h
+#define itkBioSpeciesCell_h
+
+#include "itkBioCell.h"
+
+namespace itk
+{
+namespace bio
+{
+/** \class SpeciesCell
+ * \brief Cell whose time step calls the hooks of its species without virtual calls.
+ *
+ * A species derives from SpeciesCell with itself as first template
+ * argument, and overrides the hooks of the cell cycle it needs:
+ * ReceptorsReading(), ComputeGeneNetwork(), SecreteProducts(), the
+ * CheckPoint methods, Grow(), NutrientsIntake(), EnergyIntake(),
+ * DNAReplication(), Mitosis() and Apoptosis().
+ *
+ * AdvanceTimeStep() runs the cell cycle of Cell::RunCellCycle(), but calls
+ * the hooks qualified by the species, so that they are bound at compile
+ * time and the hooks defined in the class of the species can be inlined in
+ * the time step. The hooks that the species does not override are called
+ * directly, without going through the virtual table, but most of them are
+ * defined out of line in CellBase, in the library: they are not inlined
+ * unless the module is built with link-time optimization. The aggregates
+ * still hold the cells as Cell objects and call the virtual
+ * AdvanceTimeStep() once per cell and time step.
+ *
+ * The daughters of a cell are created by Mitosis() as cells of the same
+ * species, and the first cells of a colony by CreateEgg() and CreateSeed().
+ * SpeciesCell must therefore be able to construct the species and to call
+ * its hooks: a species that declares them protected or private declares
+ * SpeciesCell as a friend. The cells read from a checkpoint are restored
+ * as Cell objects.
+ *
+ * \code
+ * class MyCell final : public itk::bio::SpeciesCell<MyCell, 3>
+ * {
+ *   friend class itk::bio::SpeciesCell<MyCell, 3>;
+ *
+ * protected:
+ *   MyCell() = default;
+ *   void Grow() override { ... }
+ * };
+ * \endcode
+ *
+ * \ingroup ITKBioCell
+ */
+template <typename TSpecies, unsigned int NSpaceDimension = 3, typename TCoordinate = double>
+class ITK_TEMPLATE_EXPORT SpeciesCell : public Cell<NSpaceDimension, TCoordinate>
+{
+public:
+  using Superclass = Cell<NSpaceDimension, TCoordinate>;
+  using SpeciesType = TSpecies;
+
+  using VectorType = typename Superclass::VectorType;
+  using PointType = typename Superclass::PointType;
+
+  void
+  AdvanceTimeStep() final;
+
+  /** Create a cell of the species that starts a colony, see
+   *  Cell::CreateEgg(). */
+  static TSpecies *
+  CreateEgg();
+
+  /** Create a cell of the species of the first generation, see
+   *  Cell::CreateSeed(). */
+  static TSpecies *
+  CreateSeed();
+
+protected:
+  SpeciesCell() = default;
+
+  Superclass *
+  CreateDaughter() const override;
+
+private:
+  // Hooks of the species, qualified so that they are bound at compile time.
+  class SpeciesHooks
+  {
+  public:
+    explicit SpeciesHooks(TSpecies & species)
+      : m_Species(species)
+    {}
+
+    void
+    ReceptorsReading()
+    {
+      m_Species.TSpecies::ReceptorsReading();
+    }
+    void
+    ComputeGeneNetwork()
+    {
+      m_Species.TSpecies::ComputeGeneNetwork();
+    }
+    void
+    SecreteProducts()
+    {
+      m_Species.TSpecies::SecreteProducts();
+    }
+    bool
+    CheckPointApoptosis()
+    {
+      return m_Species.TSpecies::CheckPointApoptosis();
+    }
+    bool
+    CheckPointDNAReplication()
+    {
+      return m_Species.TSpecies::CheckPointDNAReplication();
+    }
+    bool
+    CheckPointMitosis()
+    {
+      return m_Species.TSpecies::CheckPointMitosis();
+    }
+    void
+    Mitosis()
+    {
+      m_Species.TSpecies::Mitosis();
+    }
+    void
+    NutrientsIntake()
+    {
+      m_Species.TSpecies::NutrientsIntake();
+    }
+    void
+    EnergyIntake()
+    {
+      m_Species.TSpecies::EnergyIntake();
+    }
+    void
+    Grow()
+    {
+      m_Species.TSpecies::Grow();
+    }
+    void
+    DNAReplication()
+    {
+      m_Species.TSpecies::DNAReplication();
+    }
+    void
+    Apoptosis()
+    {
+      m_Species.TSpecies::Apoptosis();
+    }
+
+  private:
+    TSpecies & m_Species;
+  };
+};
+} // end namespace bio
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkBioSpeciesCell.hxx"
+#endif
+
+#endif
@@ -0,0 +1,69 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkBioSpeciesCell_hxx
+#define itkBioSpeciesCell_hxx
+
+namespace itk
+{
+namespace bio
+{
+/**
+ *    Execute a time step in the life of the cell, calling the hooks of
+ *    the species.
+ */
+template <typename TSpecies, unsigned int NSpaceDimension, typename TCoordinate>
+void
+SpeciesCell<TSpecies, NSpaceDimension, TCoordinate>::AdvanceTimeStep()
+{
+  SpeciesHooks hooks(static_cast<TSpecies &>(*this));
+  this->RunCellCycle(hooks);
+}
+
+template <typename TSpecies, unsigned int NSpaceDimension, typename TCoordinate>
+TSpecies *
+SpeciesCell<TSpecies, NSpaceDimension, TCoordinate>::CreateEgg()
+{
+  auto * cell = new TSpecies;
+
+  cell->m_SelfIdentifier = 1;
+  cell->StartColony();
+
+  return cell;
+}
+
+template <typename TSpecies, unsigned int NSpaceDimension, typename TCoordinate>
+TSpecies *
+SpeciesCell<TSpecies, NSpaceDimension, TCoordinate>::CreateSeed()
+{
+  auto * cell = new TSpecies;
+
+  cell->StartColony();
+
+  return cell;
+}
+
+template <typename TSpecies, unsigned int NSpaceDimension, typename TCoordinate>
+auto
+SpeciesCell<TSpecies, NSpaceDimension, TCoordinate>::CreateDaughter() const -> Superclass *
+{
+  return new TSpecies;
+}
+} // end namespace bio
+} // end namespace itk
+
+#endif
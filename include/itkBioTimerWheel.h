@@ -0,0 +1,88 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#ifndef itkBioTimerWheel_h
+#define itkBioTimerWheel_h
+
+#include "itkIntTypes.h"
+#include "BioCellExport.h"
+
+#include <vector>
+
+namespace itk
+{
+namespace bio
+{
+/** \class TimerWheel
+ * \brief Schedules the identifiers of cells to be woken up at a given iteration.
+ *
+ * The timers are hashed by iteration into a fixed number of slots, so that
+ * scheduling a timer and collecting the timers of an iteration only touch
+ * one slot. Timers further away than the number of slots stay in their slot
+ * until their iteration comes.
+ *
+ * Timers cannot be cancelled: the owner of the wheel is expected to ignore
+ * the expired identifiers that are no longer waiting.
+ *
+ * \ingroup ITKBioCell
+ */
+class BioCell_EXPORT TimerWheel
+{
+public:
+  explicit TimerWheel(SizeValueType numberOfSlots = 128);
+
+  /** Schedule the identifier for the given iteration. A timer scheduled
+   *  for an iteration that already expired expires at the next call of
+   *  Expire(). */
+  void
+  Schedule(IdentifierType identifier, SizeValueType iteration);
+
+  /** Move the identifiers scheduled at or before the given iteration to
+   *  the expired list. Expire() is expected to be called for every
+   *  iteration, in increasing order. */
+  void
+  Expire(SizeValueType iteration, std::vector<IdentifierType> & expired);
+
+  /** Number of timers not expired yet. */
+  SizeValueType
+  GetNumberOfTimers() const;
+
+  SizeValueType
+  GetNumberOfSlots() const;
+
+  /** Remove all the timers, and restart the iterations from zero. */
+  void
+  Clear();
+
+private:
+  struct Timer
+  {
+    IdentifierType m_Identifier;
+    SizeValueType  m_Iteration;
+  };
+
+  std::vector<std::vector<Timer>> m_Slots;
+  SizeValueType                   m_NumberOfTimers{ 0 };
+
+  // First iteration that has not expired yet.
+  SizeValueType m_NextIteration{ 0 };
+};
+} // end namespace bio
+} // end namespace itk
+
+#endif
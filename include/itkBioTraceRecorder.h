@@ -0,0 +1,135 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#ifndef itkBioTraceRecorder_h
+#define itkBioTraceRecorder_h
+
+#include "itkIntTypes.h"
+#include "itkBioCellConfigure.h"
+#include "BioCellExport.h"
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+namespace itk
+{
+namespace bio
+{
+/** \class TraceRecorder
+ * \brief Records timed spans of the simulation in the Chrome trace format.
+ *
+ * Each thread that records a span owns a ring buffer of events, so recording
+ * does not take any lock. When the buffer of a thread is full the oldest
+ * events are overwritten. The spans of all the threads can be written to a
+ * JSON file that is opened with chrome://tracing or https://ui.perfetto.dev.
+ *
+ * Recording is disabled by default. A disabled recorder only costs one
+ * atomic load per span. The spans of the simulation loop are compiled out
+ * entirely when the module is configured without BioCell_USE_TRACING.
+ *
+ * The names and categories of the spans must be string literals, or strings
+ * that outlive the recorder.
+ *
+ * \ingroup ITKBioCell
+ */
+class BioCell_EXPORT TraceRecorder
+{
+public:
+  /** One completed span. Times are in nanoseconds since the last Clear(). */
+  struct Event
+  {
+    const char * m_Name;
+    const char * m_Category;
+    std::int64_t m_Start;
+    std::int64_t m_Duration;
+  };
+
+  /** Record the lifetime of the object as a span of the calling thread. */
+  class BioCell_EXPORT Span
+  {
+  public:
+    Span(const char * name, const char * category);
+    ~Span();
+
+    Span(const Span &) = delete;
+    Span &
+    operator=(const Span &) = delete;
+
+  private:
+    const char * m_Name;
+    const char * m_Category;
+    std::int64_t m_Start{ 0 };
+  };
+
+  static void
+  SetEnabled(bool enabled);
+
+  static bool
+  GetEnabled();
+
+  /** Number of events kept per thread. It applies to the buffers created
+   *  after the call, and to all of them after Clear(). Default is 65536. */
+  static void
+  SetBufferSize(SizeValueType numberOfEvents);
+
+  static SizeValueType
+  GetBufferSize();
+
+  /** Name of the calling thread in the trace. */
+  static void
+  SetThreadName(const std::string & name);
+
+  /** Current time, in nanoseconds since the last Clear(). */
+  static std::int64_t
+  Now();
+
+  /** Add a completed span to the buffer of the calling thread. */
+  static void
+  Record(const char * name, const char * category, std::int64_t start, std::int64_t duration);
+
+  /** Number of events currently held by all the buffers. */
+  static SizeValueType
+  GetNumberOfEvents();
+
+  /** Discard all the events and restart the clock. This must not be called
+   *  while other threads are recording. */
+  static void
+  Clear();
+
+  /** Write the events of all the threads as a Chrome trace JSON document.
+   *  It can be called while other threads are recording: the events
+   *  recorded while writing may or may not be included, and the oldest
+   *  events that are overwritten meanwhile are left out. */
+  static void
+  WriteChromeTrace(std::ostream & os);
+
+  static void
+  WriteChromeTrace(const std::string & fileName);
+};
+} // end namespace bio
+} // end namespace itk
+
+#if defined(BioCell_USE_TRACING)
+#  define itkBioCellTraceSpanMacro(name, category) \
+    const ::itk::bio::TraceRecorder::Span itkBioCellTraceSpan((name), (category))
+#else
+#  define itkBioCellTraceSpanMacro(name, category)
+#endif
+
+#endif
@@ -0,0 +1,99 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkBioTransport_h
+#define itkBioTransport_h
+
+#include "itkIntTypes.h"
+#include "itkObject.h"
+#include "BioCellExport.h"
+
+#include <vector>
+
+namespace itk
+{
+namespace bio
+{
+/** \class Transport
+ * \brief Exchanges messages between the ranks of a distributed simulation.
+ *
+ * A transport connects a group of processes, the ranks, numbered from zero.
+ * All the communications are collective: every rank of the group calls the
+ * same operations in the same order, and an operation returns when the
+ * messages of all the ranks have been received. Subclasses implement
+ * Exchange() over a given mechanism, see UnixSocketTransport.
+ *
+ * \ingroup ITKBioCell
+ */
+class BioCell_EXPORT Transport : public Object
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(Transport);
+
+  /** Standard class type alias. */
+  using Self = Transport;
+  using Superclass = Object;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /*** Run-time type information (and related methods). */
+  itkTypeMacro(Transport, Object);
+
+  using BufferType = std::vector<char>;
+  using BufferVector = std::vector<BufferType>;
+
+  /** Rank of this process in the group, and size of the group. */
+  itkGetConstMacro(Rank, unsigned int);
+  itkGetConstMacro(NumberOfRanks, unsigned int);
+
+  /** Send outgoing[r] to each rank r, and receive in incoming[r] the
+   *  message that rank r sent to this one. The messages may be empty, and
+   *  the message of a rank to itself is copied. */
+  virtual void
+  Exchange(const BufferVector & outgoing, BufferVector & incoming) = 0;
+
+  /** Wait for all the ranks to reach the barrier. */
+  void
+  Barrier();
+
+  /** Sum or maximum of a value over all the ranks. */
+  SizeValueType
+  AllReduceSum(SizeValueType value);
+
+  double
+  AllReduceMaximum(double value);
+
+protected:
+  Transport();
+  ~Transport() override;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  /** Exchange the same value with every rank, returning the values of all
+   *  the ranks in order of rank. */
+  template <typename TValue>
+  std::vector<TValue>
+  AllGather(const TValue & value);
+
+  unsigned int m_Rank{ 0 };
+  unsigned int m_NumberOfRanks{ 1 };
+};
+} // end namespace bio
+} // end namespace itk
+
+#endif
@@ -0,0 +1,102 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkBioUnixSocketTransport_h
+#define itkBioUnixSocketTransport_h
+
+#include "itkBioTransport.h"
+#include "itkObjectFactory.h"
+
+#include <string>
+
+namespace itk
+{
+namespace bio
+{
+/** \class UnixSocketTransport
+ * \brief Transport between the processes of one host over Unix domain sockets.
+ *
+ * The ranks rendezvous in a directory shared by the processes: each rank
+ * listens on a socket file named after its rank, connects to the ranks
+ * below it and accepts the connections of the ranks above it, so that
+ * every pair of ranks is connected by one stream socket. The socket files
+ * are removed once the group is complete.
+ *
+ * The messages are written and read without blocking, all the peers at
+ * once, so that the ranks can send large messages to each other at the
+ * same time. An operation that does not complete within the timeout, or
+ * a peer that closes its connection, throws an exception.
+ *
+ * Only available on POSIX systems.
+ *
+ * \ingroup ITKBioCell
+ */
+class BioCell_EXPORT UnixSocketTransport : public Transport
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(UnixSocketTransport);
+
+  /** Standard class type alias. */
+  using Self = UnixSocketTransport;
+  using Superclass = Transport;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /*** Run-time type information (and related methods). */
+  itkTypeMacro(UnixSocketTransport, Transport);
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Join the group of numberOfRanks processes that rendezvous in the
+   *  directory, as the given rank. Returns once all the ranks are
+   *  connected. The path of the sockets must be shorter than about 100
+   *  characters. */
+  void
+  Open(const std::string & directory, unsigned int rank, unsigned int numberOfRanks);
+
+  /** Close the connections to the other ranks. */
+  void
+  Close();
+
+  bool
+  IsOpen() const;
+
+  /** Time to wait for the other ranks, in seconds, when connecting and
+   *  when exchanging messages. Default is 60. */
+  itkSetMacro(Timeout, double);
+  itkGetConstMacro(Timeout, double);
+
+  void
+  Exchange(const BufferVector & outgoing, BufferVector & incoming) override;
+
+protected:
+  UnixSocketTransport();
+  ~UnixSocketTransport() override;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  // Socket connected to each rank, -1 for this rank.
+  std::vector<int> m_Sockets;
+  double           m_Timeout{ 60.0 };
+};
+} // end namespace bio
+} // end namespace itk
+
+#endif
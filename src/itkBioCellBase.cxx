@@ -17,34 +17,18 @@
  *=========================================================================*/
 
 #include "itkBioCellBase.h"
+#include "itkMath.h"
+#include "itkNumericTraits.h"
 
 #include "vnl/vnl_sample.h"
 
+#include <algorithm>
+#include <memory>
+
 namespace itk
 {
 namespace bio
 {
-CellBase::ColorType CellBase::DefaultColor;
-
-double CellBase::DefaultRadius = 1.00; // microns
-
-double CellBase::GrowthRadiusIncrement = 0.01; // microns
-double CellBase::GrowthRadiusLimit = 2.00;     // microns
-
-SizeValueType CellBase::MaximumGenerationLimit = 30L; // 30th
-                                                      // generation
-
-SizeValueType CellBase::GrowthMaximumLatencyTime = 50;
-SizeValueType CellBase::DivisionMaximumLatencyTime = 50;
-
-double CellBase::NutrientSelfRepairLevel = 0;
-double CellBase::EnergySelfRepairLevel = 0;
-
-double CellBase::DefaultEnergyIntake = 1;
-double CellBase::DefaultNutrientsIntake = 1;
-
-SizeValueType CellBase::Counter = 0; // number of cells created
-
 CellBase::GeneIdType CellBase::RedGene = "Red";
 CellBase::GeneIdType CellBase::GreenGene = "Green";
 CellBase::GeneIdType CellBase::BlueGene = "Blue";
@@ -52,47 +36,49 @@ CellBase::GeneIdType CellBase::Cdk2E = "Cdk2E";
 CellBase::GeneIdType CellBase::Caspase = "Caspase";
 CellBase::GeneIdType CellBase::Pressurin = "Pressurin";
 
-double CellBase::ChemoAttractantLowThreshold = 200.0f;
-double CellBase::ChemoAttractantHighThreshold = 255.0f;
-
-CellBase::ColorType CellBase::WellNourishedColor;
-CellBase::ColorType CellBase::HopefullColor;
-CellBase::ColorType CellBase::StarvingColor;
+/**
+ *    Return the parameters of the cells created by the calling thread.
+ *    They are only allocated the first time a thread uses them.
+ */
+const CellBase::SharedParametersPointer &
+CellBase ::GetThreadParameters()
+{
+  thread_local const SharedParametersPointer parameters = std::make_shared<SharedParameters>();
+  return parameters;
+}
 
 /**
  *    Constructor Lonely Cell
  */
 CellBase ::CellBase()
+  : m_Parameters(GetThreadParameters())
 {
   m_Genome = nullptr;
   m_GenomeCopy = nullptr;
 
-  m_Radius = DefaultRadius;
-  m_Color = DefaultColor;
+  m_Radius = m_Parameters->m_DefaultRadius;
 
   m_Pressure = 0.0f;
 
   m_ParentIdentifier = 0; // Parent cell has to write here
 
   // The first Cell is numbered as 1
-  Counter++;
-  m_SelfIdentifier = Counter;
+  m_SelfIdentifier = ++m_Parameters->m_Counter;
 
   m_Generation = 0;
   m_CycleState = Gap1; // cells are created in Gap1 state
 
   // Start with minimum reserves
-  m_NutrientsReserveLevel = NutrientSelfRepairLevel + DefaultNutrientsIntake;
-  m_EnergyReserveLevel = EnergySelfRepairLevel + DefaultEnergyIntake;
-
-  // delay before starting to grow after Mitosis
-  m_GrowthLatencyTime = static_cast<SizeValueType>(vnl_sample_uniform(0, this->GetGrowthMaximumLatencyTime()));
+  m_NutrientsReserveLevel = m_Parameters->m_NutrientSelfRepairLevel + m_Parameters->m_DefaultNutrientsIntake;
+  m_EnergyReserveLevel = m_Parameters->m_EnergySelfRepairLevel + m_Parameters->m_DefaultEnergyIntake;
 
-  // add a random time before starting to grow
-  m_DivisionLatencyTime = static_cast<SizeValueType>(vnl_sample_uniform(0, this->GetDivisionMaximumLatencyTime()));
+  // The latencies are drawn by the factory methods, or by the mother cell
+  // from the generator of the aggregate.
+  m_GrowthLatencyTime = 0;
+  m_DivisionLatencyTime = 0;
 
   m_ScheduleApoptosis = false;
-  m_ChemoAttractantLevel = 200.0f;
+  this->SetChemoAttractantLevel(200.0f);
 
   // too young to die...
   m_MarkedForRemoval = false;
@@ -109,6 +95,21 @@ CellBase ::~CellBase()
   m_GenomeCopy = nullptr;
 }
 
+/**
+ *    Draw the latencies of a cell that starts a colony
+ */
+void
+CellBase ::DrawLatencyTimes()
+{
+  // delay before starting to grow after Mitosis
+  m_GrowthLatencyTime =
+    static_cast<SizeValueType>(vnl_sample_uniform(0, static_cast<double>(m_Parameters->m_GrowthMaximumLatencyTime)));
+
+  // add a random time before starting to grow
+  m_DivisionLatencyTime =
+    static_cast<SizeValueType>(vnl_sample_uniform(0, static_cast<double>(m_Parameters->m_DivisionMaximumLatencyTime)));
+}
+
 /**
  *    DNA Replication
  */
@@ -159,8 +160,8 @@ CellBase ::CheckPointDNAReplication()
   // radius & teleomerasa counting should be removed from here
   // and be related to Cdk expression by using proteins like P53
   // The radius should be estimated by a cytoskeleton-related protein.
-  const bool fatality = (m_Generation < MaximumGenerationLimit);
-  const bool radius = (m_Radius >= GrowthRadiusLimit);
+  const bool fatality = (m_Generation < m_Parameters->m_MaximumGenerationLimit);
+  const bool radius = (m_Radius >= m_Parameters->m_GrowthRadiusLimit);
 
   bool         isOkToReplicate = true;
   const double cdk2E = m_Genome->GetExpressionLevel(Cdk2E);
@@ -183,7 +184,7 @@ CellBase ::CheckPointDNAReplication()
   bool goodCellMatrix = false;
   if (!m_ScheduleApoptosis)
   {
-    if (m_ChemoAttractantLevel > ChemoAttractantLowThreshold && m_ChemoAttractantLevel < ChemoAttractantHighThreshold)
+    if ((this->GetChemoAttractantMask() & PermissiveChemoAttractant) == PermissiveChemoAttractant)
     {
       goodCellMatrix = true;
     }
@@ -252,11 +253,11 @@ CellBase ::Initialize()
   SetMaximumGenerationLimit(40); // it should use Teleomeres for implementing
                                  // this
 
-  WellNourishedColor.Set(0.0f, 0.0f, 1.0f);
-  HopefullColor.Set(0.0f, 1.0f, 0.0f);
-  StarvingColor.Set(1.0f, 0.0f, 0.0f);
-
-  SetDefaultColor(HopefullColor);
+  SharedParameters & parameters = *GetThreadParameters();
+  parameters.m_WellNourishedColor.Set(0.0f, 0.0f, 1.0f);
+  parameters.m_HopefullColor.Set(0.0f, 1.0f, 0.0f);
+  parameters.m_StarvingColor.Set(1.0f, 0.0f, 0.0f);
+  parameters.m_DefaultColor = parameters.m_HopefullColor;
 }
 
 /**
@@ -299,12 +300,14 @@ CellBase ::Grow()
     return;
   }
 
-  if (m_NutrientsReserveLevel > NutrientSelfRepairLevel && m_EnergyReserveLevel > EnergySelfRepairLevel)
+  const SharedParameters & parameters = *m_Parameters;
+  if (m_NutrientsReserveLevel > parameters.m_NutrientSelfRepairLevel &&
+      m_EnergyReserveLevel > parameters.m_EnergySelfRepairLevel)
   {
-    m_Radius += GrowthRadiusIncrement;
-    if (m_Radius > GrowthRadiusLimit)
+    m_Radius += parameters.m_GrowthRadiusIncrement;
+    if (m_Radius > parameters.m_GrowthRadiusLimit)
     {
-      m_Radius = GrowthRadiusLimit;
+      m_Radius = parameters.m_GrowthRadiusLimit;
     }
   }
 }
@@ -315,7 +318,7 @@ CellBase ::Grow()
 void
 CellBase ::SetGrowthMaximumLatencyTime(SizeValueType latency)
 {
-  CellBase::GrowthMaximumLatencyTime = latency;
+  GetThreadParameters()->m_GrowthMaximumLatencyTime = latency;
 }
 
 /**
@@ -324,7 +327,7 @@ CellBase ::SetGrowthMaximumLatencyTime(SizeValueType latency)
 SizeValueType
 CellBase ::GetGrowthMaximumLatencyTime()
 {
-  return CellBase::GrowthMaximumLatencyTime;
+  return GetThreadParameters()->m_GrowthMaximumLatencyTime;
 }
 
 /**
@@ -345,6 +348,102 @@ CellBase ::GetParentIdentifier() const
   return m_ParentIdentifier;
 }
 
+/**
+ *    Return the current stage in the cell cycle
+ */
+CellBase::CellCycleState
+CellBase ::GetCycleState() const
+{
+  return m_CycleState;
+}
+
+/**
+ *    Return true if the cell does not react to forces
+ */
+bool
+CellBase ::IgnoresForces() const
+{
+  return (this->GetChemoAttractantMask() & PermissiveChemoAttractant) != PermissiveChemoAttractant;
+}
+
+/**
+ *    Return the classification of the chemo attractant level
+ */
+std::uint8_t
+CellBase ::GetChemoAttractantMask() const
+{
+  return ComputeChemoAttractantMask(m_ChemoAttractantLevel, *m_Parameters);
+}
+
+/**
+ *    Classify a chemo attractant level against the thresholds
+ */
+std::uint8_t
+CellBase ::ComputeChemoAttractantMask(double level, const Parameters & parameters)
+{
+  std::uint8_t mask = 0;
+  if (level > parameters.m_ChemoAttractantLowThreshold)
+  {
+    mask |= AboveLowThreshold;
+  }
+  if (level < parameters.m_ChemoAttractantHighThreshold)
+  {
+    mask |= BelowHighThreshold;
+  }
+  if (level > parameters.m_ChemoAttractantHighThreshold)
+  {
+    mask |= AboveHighThreshold;
+  }
+  return mask;
+}
+
+/**
+ *    Set the chemo attractant level read from the substrate
+ */
+void
+CellBase ::SetChemoAttractantLevel(double level)
+{
+  m_ChemoAttractantLevel = level;
+}
+
+/**
+ *    Return true if the cell is quiescent. The pressure is null when
+ *    the cell ignored the forces, so the gene network has reached a
+ *    fixed point and the cell does not move. Growth either has reached
+ *    the radius limit or waits for the growth latency.
+ */
+bool
+CellBase ::IsQuiescent() const
+{
+  return m_CycleState == Gap1 && m_Genome && !m_ScheduleApoptosis && !m_MarkedForRemoval && !(m_Pressure > 0.0) &&
+         this->IgnoresForces() && (m_GrowthLatencyTime > 0 || Math::ExactlyEquals(m_Radius, m_Parameters->m_GrowthRadiusLimit));
+}
+
+/**
+ *    Return the number of steps before a quiescent cell starts growing
+ */
+SizeValueType
+CellBase ::GetQuiescenceDuration() const
+{
+  if (Math::ExactlyEquals(m_Radius, m_Parameters->m_GrowthRadiusLimit))
+  {
+    return NumericTraits<SizeValueType>::max();
+  }
+  return m_GrowthLatencyTime;
+}
+
+/**
+ *    Catch up with the time steps skipped while quiescent
+ */
+void
+CellBase ::AdvanceQuiescentTimeSteps(SizeValueType numberOfSteps)
+{
+  m_GrowthLatencyTime -= std::min(m_GrowthLatencyTime, numberOfSteps);
+  m_DivisionLatencyTime -= std::min(m_DivisionLatencyTime, numberOfSteps);
+  m_NutrientsReserveLevel += numberOfSteps * m_Parameters->m_DefaultNutrientsIntake;
+  m_EnergyReserveLevel += numberOfSteps * m_Parameters->m_DefaultEnergyIntake;
+}
+
 /**
  *    Return the radius
  */
@@ -355,12 +454,22 @@ CellBase ::GetRadius() const
 }
 
 /**
- *    Return the Color
+ *    Return the Color, computed from the level of chemo attractant
  */
 CellBase::ColorType
 CellBase ::GetColor() const
 {
-  return m_Color;
+  const std::uint8_t       chemoAttractantMask = this->GetChemoAttractantMask();
+  const SharedParameters & parameters = *m_Parameters;
+  if (chemoAttractantMask & AboveHighThreshold)
+  {
+    return parameters.m_WellNourishedColor;
+  }
+  if (chemoAttractantMask & AboveLowThreshold)
+  {
+    return parameters.m_HopefullColor;
+  }
+  return parameters.m_StarvingColor;
 }
 
 /**
@@ -369,7 +478,16 @@ CellBase ::GetColor() const
 void
 CellBase ::SetDefaultRadius(double value)
 {
-  DefaultRadius = value;
+  GetThreadParameters()->m_DefaultRadius = value;
+}
+
+/**
+ *    Get the value of the initial cell radius.
+ */
+double
+CellBase ::GetDefaultRadius()
+{
+  return GetThreadParameters()->m_DefaultRadius;
 }
 
 /**
@@ -380,7 +498,7 @@ CellBase ::SetDefaultRadius(double value)
 void
 CellBase ::SetGrowthRadiusLimit(double value)
 {
-  GrowthRadiusLimit = value;
+  GetThreadParameters()->m_GrowthRadiusLimit = value;
 }
 
 /**
@@ -391,7 +509,7 @@ CellBase ::SetGrowthRadiusLimit(double value)
 void
 CellBase ::SetEnergySelfRepairLevel(double value)
 {
-  EnergySelfRepairLevel = value;
+  GetThreadParameters()->m_EnergySelfRepairLevel = value;
 }
 
 /**
@@ -402,7 +520,7 @@ CellBase ::SetEnergySelfRepairLevel(double value)
 void
 CellBase ::SetNutrientSelfRepairLevel(double value)
 {
-  NutrientSelfRepairLevel = value;
+  GetThreadParameters()->m_NutrientSelfRepairLevel = value;
 }
 
 /**
@@ -415,7 +533,7 @@ CellBase ::SetNutrientSelfRepairLevel(double value)
 void
 CellBase ::SetMaximumGenerationLimit(SizeValueType generationLimit)
 {
-  MaximumGenerationLimit = generationLimit;
+  GetThreadParameters()->m_MaximumGenerationLimit = generationLimit;
 }
 
 /**
@@ -426,7 +544,7 @@ CellBase ::SetMaximumGenerationLimit(SizeValueType generationLimit)
 double
 CellBase ::GetGrowthRadiusLimit()
 {
-  return GrowthRadiusLimit;
+  return GetThreadParameters()->m_GrowthRadiusLimit;
 }
 
 /**
@@ -438,7 +556,7 @@ CellBase ::GetGrowthRadiusLimit()
 void
 CellBase ::SetGrowthRadiusIncrement(double value)
 {
-  GrowthRadiusIncrement = value;
+  GetThreadParameters()->m_GrowthRadiusIncrement = value;
 }
 
 /**
@@ -447,7 +565,7 @@ CellBase ::SetGrowthRadiusIncrement(double value)
 void
 CellBase ::NutrientsIntake()
 {
-  m_NutrientsReserveLevel += DefaultNutrientsIntake;
+  m_NutrientsReserveLevel += m_Parameters->m_DefaultNutrientsIntake;
 }
 
 /**
@@ -456,7 +574,7 @@ CellBase ::NutrientsIntake()
 void
 CellBase ::EnergyIntake()
 {
-  m_EnergyReserveLevel += DefaultEnergyIntake;
+  m_EnergyReserveLevel += m_Parameters->m_DefaultEnergyIntake;
 }
 
 /**
@@ -468,45 +586,10 @@ CellBase ::EnergyIntake()
 void
 CellBase ::ComputeGeneNetwork()
 {
-  // Default level of pigments
-  m_Genome->SetExpressionLevel(CellBase::RedGene, 1.0);
-  m_Genome->SetExpressionLevel(CellBase::GreenGene, 1.0);
-  m_Genome->SetExpressionLevel(CellBase::BlueGene, 1.0);
-
-  // Color the cell according to pressure.
-  // This is done by generating pigments under
-  // the influence of pressure.
+  // The pigments are not synthetized here: the color of the cell only
+  // depends on the substrate and is computed by GetColor() when requested.
   const double pressurinLevel = m_Genome->GetExpressionLevel(Pressurin);
 
-  const double red = GenomeType::Sigmoide(5.0, 1.0, pressurinLevel);
-
-  m_Genome->SetExpressionLevel(RedGene, red);
-  m_Genome->SetExpressionLevel(BlueGene, 1.0 - red);
-  m_Genome->SetExpressionLevel(GreenGene, 0.0);
-
-  // Color the Cell according to the substrate.
-  // This is done by generating pigments.
-  // This color overrides the selection of the Pressure...
-
-  if (m_ChemoAttractantLevel > ChemoAttractantHighThreshold)
-  {
-    m_Genome->SetExpressionLevel(RedGene, WellNourishedColor.GetRed());
-    m_Genome->SetExpressionLevel(GreenGene, WellNourishedColor.GetGreen());
-    m_Genome->SetExpressionLevel(BlueGene, WellNourishedColor.GetBlue());
-  }
-  else if (m_ChemoAttractantLevel > ChemoAttractantLowThreshold)
-  {
-    m_Genome->SetExpressionLevel(RedGene, HopefullColor.GetRed());
-    m_Genome->SetExpressionLevel(GreenGene, HopefullColor.GetGreen());
-    m_Genome->SetExpressionLevel(BlueGene, HopefullColor.GetBlue());
-  }
-  else
-  {
-    m_Genome->SetExpressionLevel(RedGene, StarvingColor.GetRed());
-    m_Genome->SetExpressionLevel(GreenGene, StarvingColor.GetGreen());
-    m_Genome->SetExpressionLevel(BlueGene, StarvingColor.GetBlue());
-  }
-
   // Prevent cells from replicating if they are in a high pressure zone
   const double cdk2E = GenomeType::Sigmoide(2.0, -0.5, pressurinLevel);
   m_Genome->SetExpressionLevel(Cdk2E, cdk2E);
@@ -522,30 +605,52 @@ CellBase ::ComputeGeneNetwork()
  */
 void
 CellBase ::SecreteProducts()
+{}
+
+/**
+ *    Set default Color
+ */
+void
+CellBase ::SetDefaultColor(const ColorType & color)
+{
+  GetThreadParameters()->m_DefaultColor = color;
+}
+
+/**
+ *    Return the parameters of the calling thread
+ */
+const CellBase::Parameters &
+CellBase ::GetParameters()
 {
-  using ColorValueType = ColorType::ValueType;
+  return *GetThreadParameters();
+}
 
-  m_Color.SetRed(ColorValueType(m_Genome->GetExpressionLevel(RedGene)));
-  m_Color.SetGreen(ColorValueType(m_Genome->GetExpressionLevel(GreenGene)));
-  m_Color.SetBlue(ColorValueType(m_Genome->GetExpressionLevel(BlueGene)));
+/**
+ *    Return the parameters of the thread that created the cell
+ */
+const CellBase::Parameters &
+CellBase ::GetCellParameters() const
+{
+  return *m_Parameters;
 }
 
 /**
- *    Set default Color
+ *    Replace all the parameters of the calling thread
  */
 void
-CellBase ::SetDefaultColor(const ColorType & color)
+CellBase ::SetParameters(const Parameters & parameters)
 {
-  DefaultColor = color;
+  SharedParameters & threadParameters = *GetThreadParameters();
+  static_cast<Parameters &>(threadParameters) = parameters;
 }
 
 /**
- *    Reset the counter
+ *    Reset the counter of the calling thread
  */
 void
 CellBase ::ResetCounter()
 {
-  Counter = 0;
+  GetThreadParameters()->m_Counter = 0;
 }
 
 /**
@@ -554,7 +659,7 @@ CellBase ::ResetCounter()
 void
 CellBase ::SetDivisionMaximumLatencyTime(SizeValueType latency)
 {
-  CellBase::DivisionMaximumLatencyTime = latency;
+  GetThreadParameters()->m_DivisionMaximumLatencyTime = latency;
 }
 
 /**
@@ -563,7 +668,7 @@ CellBase ::SetDivisionMaximumLatencyTime(SizeValueType latency)
 SizeValueType
 CellBase ::GetDivisionMaximumLatencyTime()
 {
-  return CellBase::DivisionMaximumLatencyTime;
+  return GetThreadParameters()->m_DivisionMaximumLatencyTime;
 }
 
 /**
@@ -572,7 +677,7 @@ CellBase ::GetDivisionMaximumLatencyTime()
 void
 CellBase ::SetChemoAttractantLowThreshold(double lowvalue)
 {
-  CellBase::ChemoAttractantLowThreshold = lowvalue;
+  GetThreadParameters()->m_ChemoAttractantLowThreshold = lowvalue;
 }
 
 /**
@@ -581,7 +686,7 @@ CellBase ::SetChemoAttractantLowThreshold(double lowvalue)
 void
 CellBase ::SetChemoAttractantHighThreshold(double highvalue)
 {
-  CellBase::ChemoAttractantHighThreshold = highvalue;
+  GetThreadParameters()->m_ChemoAttractantHighThreshold = highvalue;
 }
 } // end namespace bio
 } // end namespace itk
@@ -46,5 +46,40 @@ void
 CellularAggregateBase ::Remove(CellBase *)
 {}
 
+/** The actual implementation is provided in the derived classes where the Cell
+ * dimension is known. */
+void
+CellularAggregateBase ::Divide(CellBase *, CellBase *, CellBase *, double)
+{}
+
+void
+CellularAggregateBase ::SetRandomSeed(RandomSeedType seed)
+{
+  m_RandomGenerator.seed(seed);
+}
+
+/** The sample is computed directly from the raw output of the Mersenne
+ * Twister, which is fully specified by the standard, instead of using
+ * std::uniform_real_distribution whose output depends on the library. */
+double
+CellularAggregateBase ::GetUniformVariate(double lower, double upper)
+{
+  const double unit = static_cast<double>(m_RandomGenerator() - RandomGeneratorType::min()) /
+                      (static_cast<double>(RandomGeneratorType::max() - RandomGeneratorType::min()) + 1.0);
+  return lower + (upper - lower) * unit;
+}
+
+CellularAggregateBase::RandomGeneratorType &
+CellularAggregateBase ::GetRandomGenerator()
+{
+  return m_RandomGenerator;
+}
+
+const CellularAggregateBase::RandomGeneratorType &
+CellularAggregateBase ::GetRandomGenerator() const
+{
+  return m_RandomGenerator;
+}
+
 } // end namespace bio
 } // end namespace itk
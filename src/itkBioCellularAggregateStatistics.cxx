@@ -0,0 +1,181 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkBioCellularAggregateStatistics.h"
+
+namespace itk
+{
+namespace bio
+{
+CellularAggregateStatistics ::CellularAggregateStatistics()
+{
+  this->Reset();
+}
+
+void
+CellularAggregateStatistics ::Reset()
+{
+  m_NumberOfIterations = 0;
+  m_NumberOfCells = 0;
+  m_NumberOfSleepingCells = 0;
+  for (double & phaseTime : m_PhaseTime)
+  {
+    phaseTime = 0.0;
+  }
+  m_PairInteractions = 0;
+  m_NeighborListsRebuilt = 0;
+  m_NeighborListEntries = 0;
+  m_Births = 0;
+  m_Deaths = 0;
+  m_SubstrateSamples = 0;
+  m_GhostCells = 0;
+  m_MigratedCells = 0;
+  m_ActiveTimer = nullptr;
+}
+
+CellularAggregateStatistics &
+CellularAggregateStatistics ::operator+=(const CellularAggregateStatistics & other)
+{
+  m_NumberOfIterations += other.m_NumberOfIterations;
+  m_NumberOfCells = other.m_NumberOfCells;
+  m_NumberOfSleepingCells = other.m_NumberOfSleepingCells;
+  for (unsigned int phase = 0; phase < NumberOfPhases; ++phase)
+  {
+    m_PhaseTime[phase] += other.m_PhaseTime[phase];
+  }
+  m_PairInteractions += other.m_PairInteractions;
+  m_NeighborListsRebuilt += other.m_NeighborListsRebuilt;
+  m_NeighborListEntries += other.m_NeighborListEntries;
+  m_Births += other.m_Births;
+  m_Deaths += other.m_Deaths;
+  m_SubstrateSamples += other.m_SubstrateSamples;
+  m_GhostCells += other.m_GhostCells;
+  m_MigratedCells += other.m_MigratedCells;
+  return *this;
+}
+
+double
+CellularAggregateStatistics ::GetTotalTime() const
+{
+  double total = 0.0;
+  for (double phaseTime : m_PhaseTime)
+  {
+    total += phaseTime;
+  }
+  return total;
+}
+
+const char *
+CellularAggregateStatistics ::GetPhaseName(Phase phase)
+{
+  switch (phase)
+  {
+    case NeighborSearch:
+      return "NeighborSearch";
+    case Forces:
+      return "Forces";
+    case Positions:
+      return "Positions";
+    case CellCycle:
+      return "CellCycle";
+    case Births:
+      return "Births";
+    case Deaths:
+      return "Deaths";
+    default:
+      return "Unknown";
+  }
+}
+
+void
+CellularAggregateStatistics ::Print(std::ostream & os, Indent indent) const
+{
+  os << indent << "NumberOfIterations: " << m_NumberOfIterations << std::endl;
+  os << indent << "NumberOfCells: " << m_NumberOfCells << std::endl;
+  os << indent << "NumberOfSleepingCells: " << m_NumberOfSleepingCells << std::endl;
+  for (unsigned int phase = 0; phase < NumberOfPhases; ++phase)
+  {
+    os << indent << GetPhaseName(static_cast<Phase>(phase)) << " time: " << m_PhaseTime[phase] << " s" << std::endl;
+  }
+  os << indent << "PairInteractions: " << m_PairInteractions << std::endl;
+  os << indent << "NeighborListsRebuilt: " << m_NeighborListsRebuilt << std::endl;
+  os << indent << "NeighborListEntries: " << m_NeighborListEntries << std::endl;
+  os << indent << "Births: " << m_Births << std::endl;
+  os << indent << "Deaths: " << m_Deaths << std::endl;
+  os << indent << "SubstrateSamples: " << m_SubstrateSamples << std::endl;
+  os << indent << "GhostCells: " << m_GhostCells << std::endl;
+  os << indent << "MigratedCells: " << m_MigratedCells << std::endl;
+}
+
+CellularAggregateStatistics::PhaseTimer ::PhaseTimer(CellularAggregateStatistics & statistics, Phase phase)
+  : m_Statistics(statistics)
+  , m_Phase(phase)
+  , m_Start(ClockType::now())
+  , m_Parent(statistics.m_ActiveTimer)
+{
+  m_Statistics.m_ActiveTimer = this;
+}
+
+CellularAggregateStatistics::PhaseTimer ::~PhaseTimer()
+{
+  const double elapsed = std::chrono::duration<double>(ClockType::now() - m_Start).count();
+
+  m_Statistics.m_PhaseTime[m_Phase] += elapsed - m_NestedTime;
+  if (m_Parent)
+  {
+    m_Parent->m_NestedTime += elapsed;
+  }
+  m_Statistics.m_ActiveTimer = m_Parent;
+}
+
+CellularAggregateIterationEvent ::CellularAggregateIterationEvent(const CellularAggregateStatistics * statistics)
+  : m_Statistics(statistics)
+{}
+
+CellularAggregateIterationEvent ::CellularAggregateIterationEvent(const Self & s)
+  : Superclass(s)
+  , m_Statistics(s.m_Statistics)
+{}
+
+CellularAggregateIterationEvent ::~CellularAggregateIterationEvent() = default;
+
+const char *
+CellularAggregateIterationEvent ::GetEventName() const
+{
+  return "CellularAggregateIterationEvent";
+}
+
+bool
+CellularAggregateIterationEvent ::CheckEvent(const EventObject * e) const
+{
+  return (dynamic_cast<const Self *>(e) != nullptr);
+}
+
+EventObject *
+CellularAggregateIterationEvent ::MakeObject() const
+{
+  return new Self;
+}
+
+const CellularAggregateStatistics *
+CellularAggregateIterationEvent ::GetStatistics() const
+{
+  return m_Statistics;
+}
+} // end namespace bio
+} // end namespace itk
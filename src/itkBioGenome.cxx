@@ -18,6 +18,8 @@
 
 #include "itkBioGenome.h"
 
+#include <cstdint>
+
 namespace itk
 {
 namespace bio
@@ -89,5 +91,54 @@ Genome ::SetExpressionLevel(const GeneIdType & geneId, double level)
 {
   m_Map[geneId] = level;
 }
+
+/**
+ *    Write the genome in binary form
+ */
+void
+Genome ::WriteBinary(std::ostream & os) const
+{
+  const auto numberOfGenes = static_cast<std::uint64_t>(m_Map.size());
+  os.write(reinterpret_cast<const char *>(&numberOfGenes), sizeof(numberOfGenes));
+
+  for (const auto & gene : m_Map)
+  {
+    const auto nameLength = static_cast<std::uint64_t>(gene.first.size());
+    os.write(reinterpret_cast<const char *>(&nameLength), sizeof(nameLength));
+    os.write(gene.first.data(), static_cast<std::streamsize>(nameLength));
+    os.write(reinterpret_cast<const char *>(&gene.second), sizeof(gene.second));
+  }
+}
+
+/**
+ *    Read the genome in binary form
+ */
+void
+Genome ::ReadBinary(std::istream & is)
+{
+  m_Map.clear();
+
+  std::uint64_t numberOfGenes = 0;
+  is.read(reinterpret_cast<char *>(&numberOfGenes), sizeof(numberOfGenes));
+
+  for (std::uint64_t g = 0; g < numberOfGenes && is; ++g)
+  {
+    std::uint64_t nameLength = 0;
+    is.read(reinterpret_cast<char *>(&nameLength), sizeof(nameLength));
+
+    GeneIdType geneId(static_cast<GeneIdType::size_type>(nameLength), ' ');
+    is.read(&geneId[0], static_cast<std::streamsize>(nameLength));
+
+    double level = 0.0;
+    is.read(reinterpret_cast<char *>(&level), sizeof(level));
+
+    m_Map[geneId] = level;
+  }
+
+  if (!is)
+  {
+    itkGenericExceptionMacro(<< "Genome::ReadBinary() failed to read the genome");
+  }
+}
 } // end namespace bio
 } // end namespace itk
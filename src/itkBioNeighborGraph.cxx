@@ -0,0 +1,355 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkBioNeighborGraph.h"
+
+#include <algorithm>
+
+namespace itk
+{
+namespace bio
+{
+void
+NeighborGraph ::Clear()
+{
+  m_Rows.clear();
+  m_Neighbors.clear();
+  m_LastRow = 0;
+  m_NumberOfRemovedRows = 0;
+  m_NumberOfEntries = 0;
+  m_TimeStamp++;
+}
+
+void
+NeighborGraph ::Reserve(SizeValueType numberOfRows, SizeValueType numberOfNeighbors)
+{
+  m_Rows.reserve(numberOfRows);
+  m_Neighbors.reserve(numberOfNeighbors);
+}
+
+void
+NeighborGraph ::BeginRow(IdentifierType cellId)
+{
+  Row & row = this->InsertRow(cellId);
+  m_LastRow = static_cast<SizeValueType>(&row - m_Rows.data());
+  m_TimeStamp++;
+}
+
+void
+NeighborGraph ::PushBack(IdentifierType neighborId)
+{
+  Row & row = m_Rows[m_LastRow];
+
+  if (row.m_Offset + row.m_Size != m_Neighbors.size())
+  {
+    this->Relocate(row, row.m_Size + 1);
+  }
+  m_Neighbors.resize(row.m_Offset + row.m_Size);
+  m_Neighbors.push_back(neighborId);
+  row.m_Size++;
+  row.m_Capacity = row.m_Size;
+  m_NumberOfEntries++;
+  m_TimeStamp++;
+}
+
+void
+NeighborGraph ::CopyRow(IdentifierType cellId, IdentifierType sourceCellId)
+{
+  Row & row = this->InsertRow(cellId);
+
+  // The source row may move when the row of the cell is inserted.
+  const Row *         source = this->FindRow(sourceCellId);
+  const SizeValueType size = source ? source->m_Size : 0;
+  const SizeValueType sourceOffset = source ? source->m_Offset : 0;
+
+  // Leave some room for the neighbors added after a division.
+  row.m_Offset = m_Neighbors.size();
+  row.m_Size = size;
+  row.m_Capacity = size + 4;
+  m_Neighbors.resize(row.m_Offset + row.m_Capacity);
+  std::copy_n(m_Neighbors.begin() + sourceOffset, size, m_Neighbors.begin() + row.m_Offset);
+
+  m_NumberOfEntries += size;
+  m_TimeStamp++;
+
+  this->CompactIfFragmented();
+}
+
+bool
+NeighborGraph ::AddNeighbor(IdentifierType cellId, IdentifierType neighborId)
+{
+  Row * row = this->FindRow(cellId);
+  if (!row)
+  {
+    return false;
+  }
+
+  if (row->m_Offset + row->m_Size == m_Neighbors.size())
+  {
+    m_Neighbors.push_back(neighborId);
+    row->m_Capacity = row->m_Size + 1;
+  }
+  else
+  {
+    if (row->m_Size == row->m_Capacity)
+    {
+      this->Relocate(*row, std::max<SizeValueType>(2 * row->m_Size, 4));
+    }
+    m_Neighbors[row->m_Offset + row->m_Size] = neighborId;
+  }
+  row->m_Size++;
+  m_NumberOfEntries++;
+  m_TimeStamp++;
+
+  this->CompactIfFragmented();
+  return true;
+}
+
+void
+NeighborGraph ::RemoveNeighbor(IdentifierType cellId, IdentifierType neighborId)
+{
+  Row * row = this->FindRow(cellId);
+  if (!row)
+  {
+    return;
+  }
+
+  const auto first = m_Neighbors.begin() + row->m_Offset;
+  const auto last = first + row->m_Size;
+  const auto position = std::find(first, last, neighborId);
+  if (position != last)
+  {
+    std::copy(position + 1, last, position);
+    row->m_Size--;
+    m_NumberOfEntries--;
+    m_TimeStamp++;
+  }
+}
+
+void
+NeighborGraph ::RemoveRow(IdentifierType cellId)
+{
+  Row * row = this->FindRow(cellId);
+  if (!row)
+  {
+    return;
+  }
+
+  m_NumberOfEntries -= row->m_Size;
+  row->m_Size = 0;
+  row->m_Capacity = 0;
+  row->m_Removed = true;
+  m_NumberOfRemovedRows++;
+  m_TimeStamp++;
+}
+
+bool
+NeighborGraph ::HasRow(IdentifierType cellId) const
+{
+  return this->FindRow(cellId) != nullptr;
+}
+
+NeighborGraph::ConstIterator
+NeighborGraph ::Begin(IdentifierType cellId) const
+{
+  const Row * row = this->FindRow(cellId);
+  return row ? m_Neighbors.data() + row->m_Offset : nullptr;
+}
+
+NeighborGraph::ConstIterator
+NeighborGraph ::End(IdentifierType cellId) const
+{
+  const Row * row = this->FindRow(cellId);
+  return row ? m_Neighbors.data() + row->m_Offset + row->m_Size : nullptr;
+}
+
+SizeValueType
+NeighborGraph ::GetNumberOfNeighbors(IdentifierType cellId) const
+{
+  const Row * row = this->FindRow(cellId);
+  return row ? row->m_Size : 0;
+}
+
+std::vector<IdentifierType>
+NeighborGraph ::GetRowIdentifiers() const
+{
+  std::vector<IdentifierType> identifiers;
+  identifiers.reserve(this->GetNumberOfRows());
+  for (const Row & row : m_Rows)
+  {
+    if (!row.m_Removed)
+    {
+      identifiers.push_back(row.m_CellId);
+    }
+  }
+  return identifiers;
+}
+
+SizeValueType
+NeighborGraph ::GetNumberOfRows() const
+{
+  return m_Rows.size() - m_NumberOfRemovedRows;
+}
+
+SizeValueType
+NeighborGraph ::GetNumberOfEntries() const
+{
+  return m_NumberOfEntries;
+}
+
+SizeValueType
+NeighborGraph ::GetStorageSize() const
+{
+  return m_Neighbors.size();
+}
+
+void
+NeighborGraph ::Compact()
+{
+  this->Compact(std::vector<IdentifierType>());
+}
+
+void
+NeighborGraph ::Compact(const std::vector<IdentifierType> & order)
+{
+  std::vector<Row> rows;
+  rows.reserve(this->GetNumberOfRows());
+  for (const Row & row : m_Rows)
+  {
+    if (!row.m_Removed)
+    {
+      rows.push_back(row);
+    }
+  }
+
+  std::vector<IdentifierType> neighbors;
+  neighbors.reserve(m_NumberOfEntries);
+
+  std::vector<bool> written(rows.size(), false);
+
+  const auto writeRow = [this, &rows, &neighbors, &written](SizeValueType index) {
+    Row & row = rows[index];
+    const auto first = m_Neighbors.begin() + row.m_Offset;
+    row.m_Offset = neighbors.size();
+    row.m_Capacity = row.m_Size;
+    neighbors.insert(neighbors.end(), first, first + row.m_Size);
+    written[index] = true;
+  };
+
+  for (const IdentifierType cellId : order)
+  {
+    const auto position = std::lower_bound(
+      rows.begin(), rows.end(), cellId, [](const Row & row, IdentifierType id) { return row.m_CellId < id; });
+    if (position != rows.end() && position->m_CellId == cellId)
+    {
+      const auto index = static_cast<SizeValueType>(position - rows.begin());
+      if (!written[index])
+      {
+        writeRow(index);
+      }
+    }
+  }
+  for (SizeValueType index = 0; index < rows.size(); ++index)
+  {
+    if (!written[index])
+    {
+      writeRow(index);
+    }
+  }
+
+  m_Rows.swap(rows);
+  m_Neighbors.swap(neighbors);
+  m_LastRow = 0;
+  m_NumberOfRemovedRows = 0;
+  m_TimeStamp++;
+}
+
+SizeValueType
+NeighborGraph ::GetTimeStamp() const
+{
+  return m_TimeStamp;
+}
+
+NeighborGraph::Row *
+NeighborGraph ::FindRow(IdentifierType cellId)
+{
+  return const_cast<Row *>(static_cast<const NeighborGraph *>(this)->FindRow(cellId));
+}
+
+const NeighborGraph::Row *
+NeighborGraph ::FindRow(IdentifierType cellId) const
+{
+  const auto position = std::lower_bound(
+    m_Rows.begin(), m_Rows.end(), cellId, [](const Row & row, IdentifierType id) { return row.m_CellId < id; });
+  if (position == m_Rows.end() || position->m_CellId != cellId || position->m_Removed)
+  {
+    return nullptr;
+  }
+  return &(*position);
+}
+
+NeighborGraph::Row &
+NeighborGraph ::InsertRow(IdentifierType cellId)
+{
+  auto position = m_Rows.end();
+  if (!m_Rows.empty() && cellId <= m_Rows.back().m_CellId)
+  {
+    position = std::lower_bound(
+      m_Rows.begin(), m_Rows.end(), cellId, [](const Row & row, IdentifierType id) { return row.m_CellId < id; });
+  }
+
+  if (position != m_Rows.end() && position->m_CellId == cellId)
+  {
+    if (position->m_Removed)
+    {
+      position->m_Removed = false;
+      m_NumberOfRemovedRows--;
+    }
+    m_NumberOfEntries -= position->m_Size;
+  }
+  else
+  {
+    position = m_Rows.insert(position, Row{ cellId, 0, 0, 0, false });
+  }
+
+  position->m_Offset = m_Neighbors.size();
+  position->m_Size = 0;
+  position->m_Capacity = 0;
+  return *position;
+}
+
+void
+NeighborGraph ::Relocate(Row & row, SizeValueType capacity)
+{
+  const SizeValueType offset = m_Neighbors.size();
+  m_Neighbors.resize(offset + capacity);
+  std::copy_n(m_Neighbors.begin() + row.m_Offset, row.m_Size, m_Neighbors.begin() + offset);
+  row.m_Offset = offset;
+  row.m_Capacity = capacity;
+}
+
+void
+NeighborGraph ::CompactIfFragmented()
+{
+  if (m_Neighbors.size() > 2 * m_NumberOfEntries + 1024 || m_NumberOfRemovedRows > m_Rows.size() / 2 + 64)
+  {
+    this->Compact();
+  }
+}
+} // end namespace bio
+} // end namespace itk
@@ -0,0 +1,87 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkBioTimerWheel.h"
+
+#include <algorithm>
+
+namespace itk
+{
+namespace bio
+{
+TimerWheel ::TimerWheel(SizeValueType numberOfSlots)
+  : m_Slots(std::max<SizeValueType>(numberOfSlots, 1))
+{}
+
+void
+TimerWheel ::Schedule(IdentifierType identifier, SizeValueType iteration)
+{
+  // The late timers go to the slot of the next iteration.
+  const SizeValueType slotIteration = std::max(iteration, m_NextIteration);
+  m_Slots[slotIteration % m_Slots.size()].push_back(Timer{ identifier, iteration });
+  m_NumberOfTimers++;
+}
+
+void
+TimerWheel ::Expire(SizeValueType iteration, std::vector<IdentifierType> & expired)
+{
+  std::vector<Timer> & slot = m_Slots[iteration % m_Slots.size()];
+
+  // Keep the timers of the next turns of the wheel in place.
+  auto kept = slot.begin();
+  for (const Timer & timer : slot)
+  {
+    if (timer.m_Iteration <= iteration)
+    {
+      expired.push_back(timer.m_Identifier);
+    }
+    else
+    {
+      *kept++ = timer;
+    }
+  }
+  m_NumberOfTimers -= static_cast<SizeValueType>(slot.end() - kept);
+  slot.erase(kept, slot.end());
+
+  m_NextIteration = std::max(m_NextIteration, iteration + 1);
+}
+
+SizeValueType
+TimerWheel ::GetNumberOfTimers() const
+{
+  return m_NumberOfTimers;
+}
+
+SizeValueType
+TimerWheel ::GetNumberOfSlots() const
+{
+  return m_Slots.size();
+}
+
+void
+TimerWheel ::Clear()
+{
+  for (auto & slot : m_Slots)
+  {
+    slot.clear();
+  }
+  m_NumberOfTimers = 0;
+  m_NextIteration = 0;
+}
+} // end namespace bio
+} // end namespace itk
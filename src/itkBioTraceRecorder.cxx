@@ -0,0 +1,315 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkBioTraceRecorder.h"
+#include "itkMacro.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace itk
+{
+namespace bio
+{
+namespace
+{
+using ClockType = std::chrono::steady_clock;
+
+// Event of a ring buffer. The fields are atomic so that the trace can be
+// written while the owner thread overwrites the oldest events.
+struct EventSlot
+{
+  std::atomic<const char *> m_Name{ nullptr };
+  std::atomic<const char *> m_Category{ nullptr };
+  std::atomic<std::int64_t> m_Start{ 0 };
+  std::atomic<std::int64_t> m_Duration{ 0 };
+};
+
+// Ring buffer written only by its owner thread. The event of index i is
+// stored in the slot i % m_Size, and m_Head is the number of events
+// recorded. The slots are allocated under the mutex of the registry.
+struct ThreadBuffer
+{
+  std::unique_ptr<EventSlot[]> m_Events;
+  SizeValueType                m_Size{ 0 };
+  std::atomic<std::uint64_t>   m_Head{ 0 };
+  unsigned int                 m_ThreadId{ 0 };
+  std::string                  m_ThreadName;
+
+  void
+  Allocate(SizeValueType size)
+  {
+    m_Size = std::max<SizeValueType>(size, 1);
+    m_Events.reset(new EventSlot[m_Size]);
+  }
+};
+
+struct TraceRegistry
+{
+  std::mutex                                 m_Mutex;
+  std::vector<std::unique_ptr<ThreadBuffer>> m_Buffers;
+  std::atomic<bool>                          m_Enabled{ false };
+  SizeValueType                              m_BufferSize{ 65536 };
+  ClockType::time_point                      m_Epoch{ ClockType::now() };
+};
+
+TraceRegistry &
+GetRegistry()
+{
+  static TraceRegistry registry;
+  return registry;
+}
+
+// The buffers are owned by the registry, so that the events of the threads
+// that already finished can still be written. The events are only allocated
+// when the thread records its first span.
+ThreadBuffer &
+GetThreadBuffer()
+{
+  thread_local ThreadBuffer * threadBuffer = nullptr;
+  if (!threadBuffer)
+  {
+    TraceRegistry &             registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.m_Mutex);
+
+    auto buffer = std::make_unique<ThreadBuffer>();
+    buffer->m_ThreadId = static_cast<unsigned int>(registry.m_Buffers.size() + 1);
+    threadBuffer = buffer.get();
+    registry.m_Buffers.push_back(std::move(buffer));
+  }
+  return *threadBuffer;
+}
+
+void
+WriteJSONString(std::ostream & os, const char * text)
+{
+  os << '"';
+  for (const char * c = text; *c; ++c)
+  {
+    if (*c == '"' || *c == '\\')
+    {
+      os << '\\';
+    }
+    os << *c;
+  }
+  os << '"';
+}
+} // namespace
+
+TraceRecorder::Span ::Span(const char * name, const char * category)
+  : m_Name(TraceRecorder::GetEnabled() ? name : nullptr)
+  , m_Category(category)
+{
+  if (m_Name)
+  {
+    m_Start = TraceRecorder::Now();
+  }
+}
+
+TraceRecorder::Span ::~Span()
+{
+  if (m_Name)
+  {
+    TraceRecorder::Record(m_Name, m_Category, m_Start, TraceRecorder::Now() - m_Start);
+  }
+}
+
+void
+TraceRecorder ::SetEnabled(bool enabled)
+{
+  GetRegistry().m_Enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool
+TraceRecorder ::GetEnabled()
+{
+  return GetRegistry().m_Enabled.load(std::memory_order_relaxed);
+}
+
+void
+TraceRecorder ::SetBufferSize(SizeValueType numberOfEvents)
+{
+  TraceRegistry &             registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry.m_Mutex);
+  registry.m_BufferSize = numberOfEvents;
+}
+
+SizeValueType
+TraceRecorder ::GetBufferSize()
+{
+  TraceRegistry &             registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry.m_Mutex);
+  return registry.m_BufferSize;
+}
+
+void
+TraceRecorder ::SetThreadName(const std::string & name)
+{
+  ThreadBuffer &              buffer = GetThreadBuffer();
+  std::lock_guard<std::mutex> lock(GetRegistry().m_Mutex);
+  buffer.m_ThreadName = name;
+}
+
+std::int64_t
+TraceRecorder ::Now()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(ClockType::now() - GetRegistry().m_Epoch).count();
+}
+
+void
+TraceRecorder ::Record(const char * name, const char * category, std::int64_t start, std::int64_t duration)
+{
+  ThreadBuffer & buffer = GetThreadBuffer();
+  if (!buffer.m_Events)
+  {
+    TraceRegistry &             registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.m_Mutex);
+    buffer.Allocate(registry.m_BufferSize);
+  }
+
+  const std::uint64_t head = buffer.m_Head.load(std::memory_order_relaxed);
+
+  // The fence orders the publication of the previous event before the
+  // overwrite of the slot, which lets WriteChromeTrace() detect it.
+  std::atomic_thread_fence(std::memory_order_release);
+
+  EventSlot & slot = buffer.m_Events[head % buffer.m_Size];
+  slot.m_Name.store(name, std::memory_order_relaxed);
+  slot.m_Category.store(category, std::memory_order_relaxed);
+  slot.m_Start.store(start, std::memory_order_relaxed);
+  slot.m_Duration.store(duration, std::memory_order_relaxed);
+  buffer.m_Head.store(head + 1, std::memory_order_release);
+}
+
+SizeValueType
+TraceRecorder ::GetNumberOfEvents()
+{
+  TraceRegistry &             registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry.m_Mutex);
+
+  SizeValueType numberOfEvents = 0;
+  for (const auto & buffer : registry.m_Buffers)
+  {
+    numberOfEvents += std::min<std::uint64_t>(buffer->m_Head.load(std::memory_order_acquire), buffer->m_Size);
+  }
+  return numberOfEvents;
+}
+
+void
+TraceRecorder ::Clear()
+{
+  TraceRegistry &             registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry.m_Mutex);
+
+  for (const auto & buffer : registry.m_Buffers)
+  {
+    if (buffer->m_Events)
+    {
+      buffer->Allocate(registry.m_BufferSize);
+    }
+    buffer->m_Head.store(0, std::memory_order_release);
+  }
+  registry.m_Epoch = ClockType::now();
+}
+
+void
+TraceRecorder ::WriteChromeTrace(std::ostream & os)
+{
+  TraceRegistry &             registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry.m_Mutex);
+
+  const std::ios::fmtflags flags = os.flags();
+  os.setf(std::ios::fixed, std::ios::floatfield);
+  const std::streamsize precision = os.precision(3);
+
+  os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  bool first = true;
+  for (const auto & buffer : registry.m_Buffers)
+  {
+    if (!buffer->m_ThreadName.empty())
+    {
+      os << (first ? "\n" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"
+         << buffer->m_ThreadId << ",\"args\":{\"name\":";
+      WriteJSONString(os, buffer->m_ThreadName.c_str());
+      os << "}}";
+      first = false;
+    }
+
+    // The events are copied first. The owner thread may overwrite the
+    // oldest ones meanwhile: the events whose slot was reused before the
+    // copy ended are dropped.
+    const std::uint64_t head = buffer->m_Head.load(std::memory_order_acquire);
+    const std::uint64_t size = buffer->m_Size;
+    const std::uint64_t oldest = (head > size ? head - size : 0);
+
+    std::vector<Event> events;
+    events.reserve(head - oldest);
+    for (std::uint64_t i = oldest; i < head; ++i)
+    {
+      const EventSlot & slot = buffer->m_Events[i % size];
+      events.push_back(Event{ slot.m_Name.load(std::memory_order_relaxed),
+                              slot.m_Category.load(std::memory_order_relaxed),
+                              slot.m_Start.load(std::memory_order_relaxed),
+                              slot.m_Duration.load(std::memory_order_relaxed) });
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    // The event i may have been overwritten by the event i + size, which is
+    // being recorded once the head reaches i + size.
+    const std::uint64_t headAfterCopy = buffer->m_Head.load(std::memory_order_relaxed);
+    const std::uint64_t firstIntact = (headAfterCopy >= size ? headAfterCopy - size + 1 : 0);
+
+    for (std::uint64_t i = std::max(oldest, firstIntact); i < head; ++i)
+    {
+      const Event & event = events[i - oldest];
+      os << (first ? "\n" : ",\n") << "{\"name\":";
+      WriteJSONString(os, event.m_Name);
+      os << ",\"cat\":";
+      WriteJSONString(os, event.m_Category);
+      os << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->m_ThreadId << ",\"ts\":" << event.m_Start / 1000.0
+         << ",\"dur\":" << event.m_Duration / 1000.0 << '}';
+      first = false;
+    }
+  }
+  os << "\n]}\n";
+
+  os.precision(precision);
+  os.flags(flags);
+}
+
+void
+TraceRecorder ::WriteChromeTrace(const std::string & fileName)
+{
+  std::ofstream os(fileName);
+  if (!os)
+  {
+    itkGenericExceptionMacro("Cannot open " << fileName << " for writing");
+  }
+  WriteChromeTrace(os);
+  if (!os)
+  {
+    itkGenericExceptionMacro("Failed to write " << fileName);
+  }
+}
+} // end namespace bio
+} // end namespace itk
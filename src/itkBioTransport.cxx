@@ -0,0 +1,84 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkBioTransport.h"
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+
+namespace itk
+{
+namespace bio
+{
+Transport ::Transport() = default;
+
+Transport ::~Transport() = default;
+
+template <typename TValue>
+std::vector<TValue>
+Transport ::AllGather(const TValue & value)
+{
+  const char *       bytes = reinterpret_cast<const char *>(&value);
+  const BufferVector outgoing(m_NumberOfRanks, BufferType(bytes, bytes + sizeof(TValue)));
+  BufferVector       incoming;
+  this->Exchange(outgoing, incoming);
+
+  std::vector<TValue> values(m_NumberOfRanks);
+  for (unsigned int rank = 0; rank < m_NumberOfRanks; ++rank)
+  {
+    if (incoming[rank].size() != sizeof(TValue))
+    {
+      itkExceptionMacro(<< "Rank " << rank << " sent " << incoming[rank].size() << " bytes instead of "
+                        << sizeof(TValue));
+    }
+    std::memcpy(&values[rank], incoming[rank].data(), sizeof(TValue));
+  }
+  return values;
+}
+
+void
+Transport ::Barrier()
+{
+  const BufferVector outgoing(m_NumberOfRanks);
+  BufferVector       incoming;
+  this->Exchange(outgoing, incoming);
+}
+
+SizeValueType
+Transport ::AllReduceSum(SizeValueType value)
+{
+  const std::vector<SizeValueType> values = this->AllGather(value);
+  return std::accumulate(values.begin(), values.end(), SizeValueType{ 0 });
+}
+
+double
+Transport ::AllReduceMaximum(double value)
+{
+  const std::vector<double> values = this->AllGather(value);
+  return *std::max_element(values.begin(), values.end());
+}
+
+void
+Transport ::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "Rank: " << m_Rank << std::endl;
+  os << indent << "NumberOfRanks: " << m_NumberOfRanks << std::endl;
+}
+} // end namespace bio
+} // end namespace itk
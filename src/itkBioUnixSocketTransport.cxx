@@ -0,0 +1,463 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkBioUnixSocketTransport.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace itk
+{
+namespace bio
+{
+namespace
+{
+using ClockType = std::chrono::steady_clock;
+
+// Writing to a socket closed by the peer must fail with EPIPE instead of
+// raising SIGPIPE: send() takes MSG_NOSIGNAL where it is defined, and the
+// sockets set SO_NOSIGPIPE elsewhere.
+#ifdef MSG_NOSIGNAL
+constexpr int SendFlags = MSG_NOSIGNAL;
+#else
+constexpr int SendFlags = 0;
+#endif
+
+void
+DisableSigPipe(int socket)
+{
+#if !defined(MSG_NOSIGNAL) && defined(SO_NOSIGPIPE)
+  const int on = 1;
+  ::setsockopt(socket, SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+#else
+  (void)socket;
+#endif
+}
+
+std::string
+GetSocketFileName(const std::string & directory, unsigned int rank)
+{
+  return directory + "/rank" + std::to_string(rank) + ".socket";
+}
+
+sockaddr_un
+MakeAddress(const std::string & fileName)
+{
+  sockaddr_un address;
+  std::memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  if (fileName.size() >= sizeof(address.sun_path))
+  {
+    itkGenericExceptionMacro(<< "The socket path " << fileName << " is too long");
+  }
+  std::memcpy(address.sun_path, fileName.c_str(), fileName.size());
+  return address;
+}
+
+// Milliseconds left before the deadline, at least zero.
+int
+GetRemainingTime(ClockType::time_point deadline)
+{
+  const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - ClockType::now()).count();
+  return static_cast<int>(std::max<decltype(remaining)>(remaining, 0));
+}
+
+// Blocking transfers of the ranks while the group is set up.
+bool
+WriteAll(int socket, const void * data, size_t size)
+{
+  const char * bytes = static_cast<const char *>(data);
+  while (size > 0)
+  {
+    const ssize_t written = ::send(socket, bytes, size, SendFlags);
+    if (written < 0 && errno == EINTR)
+    {
+      continue;
+    }
+    if (written <= 0)
+    {
+      return false;
+    }
+    bytes += written;
+    size -= static_cast<size_t>(written);
+  }
+  return true;
+}
+
+bool
+ReadAll(int socket, void * data, size_t size)
+{
+  char * bytes = static_cast<char *>(data);
+  while (size > 0)
+  {
+    const ssize_t read = ::recv(socket, bytes, size, 0);
+    if (read < 0 && errno == EINTR)
+    {
+      continue;
+    }
+    if (read <= 0)
+    {
+      return false;
+    }
+    bytes += read;
+    size -= static_cast<size_t>(read);
+  }
+  return true;
+}
+
+// State of the transfers with one peer during an exchange. A message is
+// its size on 8 bytes followed by its content.
+struct Channel
+{
+  std::uint64_t m_OutgoingSize{ 0 };
+  size_t        m_Sent{ 0 };
+  std::uint64_t m_IncomingSize{ 0 };
+  size_t        m_Received{ 0 };
+};
+} // namespace
+
+UnixSocketTransport ::UnixSocketTransport() = default;
+
+UnixSocketTransport ::~UnixSocketTransport()
+{
+  this->Close();
+}
+
+void
+UnixSocketTransport ::Open(const std::string & directory, unsigned int rank, unsigned int numberOfRanks)
+{
+  if (rank >= numberOfRanks)
+  {
+    itkExceptionMacro(<< "Invalid rank " << rank << " in a group of " << numberOfRanks);
+  }
+
+  this->Close();
+
+  const ClockType::time_point deadline =
+    ClockType::now() + std::chrono::duration_cast<ClockType::duration>(std::chrono::duration<double>(m_Timeout));
+
+  std::vector<int> sockets(numberOfRanks, -1);
+  int              listener = -1;
+  const std::string listenerFileName = GetSocketFileName(directory, rank);
+
+  auto cleanUp = [&sockets, &listener, &listenerFileName]() {
+    for (const int socket : sockets)
+    {
+      if (socket >= 0)
+      {
+        ::close(socket);
+      }
+    }
+    if (listener >= 0)
+    {
+      ::close(listener);
+      ::unlink(listenerFileName.c_str());
+    }
+  };
+
+  try
+  {
+    // The socket of this rank must exist before the ranks above it try to
+    // connect, so it is created first.
+    if (rank + 1 < numberOfRanks)
+    {
+      const sockaddr_un address = MakeAddress(listenerFileName);
+      ::unlink(listenerFileName.c_str());
+      listener = ::socket(AF_UNIX, SOCK_STREAM, 0);
+      if (listener < 0 || ::bind(listener, reinterpret_cast<const sockaddr *>(&address), sizeof(address)) != 0 ||
+          ::listen(listener, static_cast<int>(numberOfRanks)) != 0)
+      {
+        itkExceptionMacro(<< "Cannot listen on " << listenerFileName << ": " << std::strerror(errno));
+      }
+    }
+
+    // Connect to the ranks below, retrying until they listen.
+    const std::uint32_t identification = rank;
+    for (unsigned int peer = 0; peer < rank; ++peer)
+    {
+      const std::string fileName = GetSocketFileName(directory, peer);
+      const sockaddr_un address = MakeAddress(fileName);
+      while (true)
+      {
+        sockets[peer] = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (sockets[peer] < 0)
+        {
+          itkExceptionMacro(<< "Cannot create a socket: " << std::strerror(errno));
+        }
+        if (::connect(sockets[peer], reinterpret_cast<const sockaddr *>(&address), sizeof(address)) == 0)
+        {
+          break;
+        }
+        const int error = errno;
+        ::close(sockets[peer]);
+        sockets[peer] = -1;
+        if ((error != ENOENT && error != ECONNREFUSED) || GetRemainingTime(deadline) == 0)
+        {
+          itkExceptionMacro(<< "Cannot connect to rank " << peer << " on " << fileName << ": "
+                            << std::strerror(error));
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      }
+      DisableSigPipe(sockets[peer]);
+      if (!WriteAll(sockets[peer], &identification, sizeof(identification)))
+      {
+        itkExceptionMacro(<< "Cannot identify to rank " << peer << ": " << std::strerror(errno));
+      }
+    }
+
+    // Accept the ranks above.
+    for (unsigned int accepted = rank + 1; accepted < numberOfRanks; ++accepted)
+    {
+      pollfd descriptor{ listener, POLLIN, 0 };
+      const int ready = ::poll(&descriptor, 1, GetRemainingTime(deadline));
+      if (ready < 0 && errno == EINTR)
+      {
+        --accepted;
+        continue;
+      }
+      if (ready <= 0)
+      {
+        itkExceptionMacro(<< "Timeout while waiting for the ranks above " << rank);
+      }
+
+      const int     socket = ::accept(listener, nullptr, nullptr);
+      std::uint32_t peer = 0;
+      if (socket < 0 || !ReadAll(socket, &peer, sizeof(peer)) || peer <= rank || peer >= numberOfRanks ||
+          sockets[peer] >= 0)
+      {
+        if (socket >= 0)
+        {
+          ::close(socket);
+        }
+        itkExceptionMacro(<< "Invalid connection to rank " << rank);
+      }
+      DisableSigPipe(socket);
+      sockets[peer] = socket;
+    }
+  }
+  catch (...)
+  {
+    cleanUp();
+    throw;
+  }
+
+  if (listener >= 0)
+  {
+    ::close(listener);
+    ::unlink(listenerFileName.c_str());
+  }
+
+  for (const int socket : sockets)
+  {
+    if (socket >= 0)
+    {
+      ::fcntl(socket, F_SETFL, ::fcntl(socket, F_GETFL) | O_NONBLOCK);
+    }
+  }
+
+  m_Sockets = std::move(sockets);
+  m_Rank = rank;
+  m_NumberOfRanks = numberOfRanks;
+  this->Modified();
+}
+
+void
+UnixSocketTransport ::Close()
+{
+  for (const int socket : m_Sockets)
+  {
+    if (socket >= 0)
+    {
+      ::close(socket);
+    }
+  }
+  m_Sockets.clear();
+  m_Rank = 0;
+  m_NumberOfRanks = 1;
+}
+
+bool
+UnixSocketTransport ::IsOpen() const
+{
+  return !m_Sockets.empty();
+}
+
+void
+UnixSocketTransport ::Exchange(const BufferVector & outgoing, BufferVector & incoming)
+{
+  if (!this->IsOpen())
+  {
+    itkExceptionMacro(<< "The transport is not open");
+  }
+  if (outgoing.size() != m_NumberOfRanks)
+  {
+    itkExceptionMacro(<< outgoing.size() << " messages for " << m_NumberOfRanks << " ranks");
+  }
+
+  incoming.assign(m_NumberOfRanks, BufferType());
+  incoming[m_Rank] = outgoing[m_Rank];
+
+  constexpr size_t headerSize = sizeof(std::uint64_t);
+
+  std::vector<Channel> channels(m_NumberOfRanks);
+  for (unsigned int peer = 0; peer < m_NumberOfRanks; ++peer)
+  {
+    channels[peer].m_OutgoingSize = outgoing[peer].size();
+  }
+
+  const ClockType::time_point deadline =
+    ClockType::now() + std::chrono::duration_cast<ClockType::duration>(std::chrono::duration<double>(m_Timeout));
+
+  std::vector<pollfd>       descriptors;
+  std::vector<unsigned int> peers;
+  while (true)
+  {
+    descriptors.clear();
+    peers.clear();
+    for (unsigned int peer = 0; peer < m_NumberOfRanks; ++peer)
+    {
+      if (peer == m_Rank)
+      {
+        continue;
+      }
+      const Channel & channel = channels[peer];
+      short           events = 0;
+      if (channel.m_Sent < headerSize + channel.m_OutgoingSize)
+      {
+        events |= POLLOUT;
+      }
+      if (channel.m_Received < headerSize || channel.m_Received < headerSize + channel.m_IncomingSize)
+      {
+        events |= POLLIN;
+      }
+      if (events)
+      {
+        descriptors.push_back(pollfd{ m_Sockets[peer], events, 0 });
+        peers.push_back(peer);
+      }
+    }
+    if (descriptors.empty())
+    {
+      break;
+    }
+
+    const int ready = ::poll(descriptors.data(), descriptors.size(), GetRemainingTime(deadline));
+    if (ready < 0 && errno == EINTR)
+    {
+      continue;
+    }
+    if (ready <= 0)
+    {
+      itkExceptionMacro(<< "Timeout while exchanging messages with the other ranks");
+    }
+
+    for (size_t i = 0; i < descriptors.size(); ++i)
+    {
+      const unsigned int peer = peers[i];
+      const int          socket = descriptors[i].fd;
+      Channel &          channel = channels[peer];
+      const short        events = descriptors[i].revents;
+
+      if (events & POLLNVAL)
+      {
+        itkExceptionMacro(<< "Invalid connection to rank " << peer);
+      }
+
+      if (events & (POLLOUT | POLLERR))
+      {
+        const char * data = nullptr;
+        size_t       size = 0;
+        if (channel.m_Sent < headerSize)
+        {
+          data = reinterpret_cast<const char *>(&channel.m_OutgoingSize) + channel.m_Sent;
+          size = headerSize - channel.m_Sent;
+        }
+        else
+        {
+          data = outgoing[peer].data() + (channel.m_Sent - headerSize);
+          size = headerSize + channel.m_OutgoingSize - channel.m_Sent;
+        }
+        const ssize_t written = ::send(socket, data, size, SendFlags);
+        if (written > 0)
+        {
+          channel.m_Sent += static_cast<size_t>(written);
+        }
+        else if (written < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+        {
+          itkExceptionMacro(<< "Cannot send to rank " << peer << ": " << std::strerror(errno));
+        }
+      }
+
+      if (events & (POLLIN | POLLHUP | POLLERR))
+      {
+        char * data = nullptr;
+        size_t size = 0;
+        if (channel.m_Received < headerSize)
+        {
+          data = reinterpret_cast<char *>(&channel.m_IncomingSize) + channel.m_Received;
+          size = headerSize - channel.m_Received;
+        }
+        else
+        {
+          data = incoming[peer].data() + (channel.m_Received - headerSize);
+          size = headerSize + channel.m_IncomingSize - channel.m_Received;
+        }
+        if (size == 0)
+        {
+          continue;
+        }
+        const ssize_t read = ::recv(socket, data, size, 0);
+        if (read > 0)
+        {
+          channel.m_Received += static_cast<size_t>(read);
+          if (channel.m_Received == headerSize)
+          {
+            incoming[peer].resize(channel.m_IncomingSize);
+          }
+        }
+        else if (read == 0)
+        {
+          itkExceptionMacro(<< "Rank " << peer << " closed its connection");
+        }
+        else if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+        {
+          itkExceptionMacro(<< "Cannot receive from rank " << peer << ": " << std::strerror(errno));
+        }
+      }
+    }
+  }
+}
+
+void
+UnixSocketTransport ::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "Open: " << (this->IsOpen() ? "true" : "false") << std::endl;
+  os << indent << "Timeout: " << m_Timeout << std::endl;
+}
+} // end namespace bio
+} // end namespace itk
@@ -116,6 +116,16 @@ public:
     egg->GetParentIdentifier();
     egg->GetColor();
 
+    // The color follows the level of chemo attractant read by the cell.
+    const itk::bio::CellBase::Parameters & parameters = CellType::GetParameters();
+    Self                                   reader;
+    reader.SetChemoAttractantLevel(chemoAttractantLowThreshold - 1.0);
+    ITK_TEST_EXPECT_EQUAL(reader.GetColor(), parameters.m_StarvingColor);
+    reader.SetChemoAttractantLevel((chemoAttractantLowThreshold + chemoAttractantHighThreshold) / 2.0);
+    ITK_TEST_EXPECT_EQUAL(reader.GetColor(), parameters.m_HopefullColor);
+    reader.SetChemoAttractantLevel(chemoAttractantHighThreshold + 1.0);
+    ITK_TEST_EXPECT_EQUAL(reader.GetColor(), parameters.m_WellNourishedColor);
+
     // Create a cellular aggregate base
     itk::bio::CellularAggregateBase::Pointer cell = itk::bio::CellularAggregateBase::New();
     cell->Clone();
@@ -0,0 +1,645 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// Benchmark of the CellularAggregate simulation loop.
+//
+// Synthetic colonies of packed cells are placed on a substrate phantom and
+// the main phases of the simulation are timed. The results are written as a
+// list of flat records, in JSON or CSV depending on the extension of the
+// output file, so that runs of different commits can be compared.
+//
+// Usage:
+//   itkBioCellularAggregateBenchmark [--sizes 1000,10000,100000,1000000]
+//                                    [--dimensions 2,3] [--threads 1,8]
+//                                    [--phantoms disc,uniform]
+//                                    [--iterations 5] [--time-limit 120]
+//                                    [--reordering-interval 0] [--in-place-mitosis 0]
+//                                    [--tiles n] [--single-precision 0] [--static-cells 0]
+//                                    [--label name] [--output results.json]
+//
+// A non-zero reordering interval rebuilds the storage of the cells along a
+// Morton curve before the phases are timed, and then at that interval.
+// --in-place-mitosis 1 makes the dividing cells reuse their slot in the
+// aggregate, see CellularAggregateBase::SetUseInPlaceMitosis().
+// --tiles n partitions the colony in n tiles processed by the threads, see
+// CellularAggregate::SetNumberOfTiles(). The tiles are the only part of the
+// simulation that uses several threads, so without --tiles each number of
+// threads runs with as many tiles. --tiles 1 is serial and is refused with
+// more than one thread.
+// --single-precision 1 simulates the colonies with float coordinates.
+// --static-cells 1 seeds the colonies with a species of itk::bio::SpeciesCell
+// that keeps the behavior of Cell, to compare its time step, free of virtual
+// calls, with the virtual one.
+//
+// Once the benchmark of one colony size takes longer than the time limit (in
+// seconds), the larger sizes of the same dimension are skipped.
+
+#include "itkBioCellularAggregate.h"
+#include "itkBioSpeciesCell.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMultiThreaderBase.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+using ClockType = std::chrono::steady_clock;
+
+struct BenchmarkOptions
+{
+  std::vector<unsigned long> m_Sizes{ 1000, 10000, 100000, 1000000 };
+  std::vector<unsigned long> m_Dimensions{ 2, 3 };
+  std::vector<unsigned long> m_Threads;
+  std::vector<std::string>   m_Phantoms{ "disc" };
+  unsigned int               m_Iterations{ 5 };
+  double                     m_TimeLimit{ 120.0 };
+  unsigned long              m_ReorderingInterval{ 0 };
+  bool                       m_InPlaceMitosis{ false };
+  unsigned int               m_Tiles{ 0 }; // 0 for one tile per thread
+  bool                       m_SinglePrecision{ false };
+  bool                       m_StaticCells{ false };
+  std::string                m_Label;
+  std::string                m_OutputFileName;
+};
+
+struct BenchmarkRecord
+{
+  unsigned int  m_Dimension;
+  unsigned long m_Cells;
+  unsigned int  m_Threads;
+  unsigned int  m_Tiles;
+  std::string   m_Phantom;
+  std::string   m_Phase;
+  unsigned int  m_Iterations;
+  double        m_MinimumTime;
+  double        m_MeanTime;
+  unsigned long m_FinalCells;
+};
+
+// Gives the benchmark access to the individual phases of AdvanceTimeStep().
+template <unsigned int VDimension, typename TCoordinate>
+class BenchmarkAggregate : public itk::bio::CellularAggregate<VDimension, TCoordinate>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(BenchmarkAggregate);
+
+  using Self = BenchmarkAggregate;
+  using Superclass = itk::bio::CellularAggregate<VDimension, TCoordinate>;
+  using Pointer = itk::SmartPointer<Self>;
+
+  itkNewMacro(Self);
+
+  using Superclass::AdvanceCellCycles;
+  using Superclass::ComputeClosestPoints;
+  using Superclass::ComputeForces;
+
+protected:
+  BenchmarkAggregate() = default;
+  ~BenchmarkAggregate() override = default;
+};
+
+// Cell with its own genome that can be created anywhere in the colony.
+template <unsigned int VDimension, typename TCoordinate>
+class SeedCell : public itk::bio::Cell<VDimension, TCoordinate>
+{
+public:
+  static itk::bio::Cell<VDimension, TCoordinate> *
+  Create()
+  {
+    auto * cell = new SeedCell;
+    cell->DrawLatencyTimes();
+    cell->m_Genome = new typename SeedCell::GenomeType;
+    cell->ComputeGeneNetwork();
+    cell->SecreteProducts();
+    return cell;
+  }
+};
+
+// Cell with the behavior of SeedCell whose hooks are bound at compile time.
+template <unsigned int VDimension, typename TCoordinate>
+class StaticSeedCell final
+  : public itk::bio::SpeciesCell<StaticSeedCell<VDimension, TCoordinate>, VDimension, TCoordinate>
+{
+  friend class itk::bio::SpeciesCell<StaticSeedCell, VDimension, TCoordinate>;
+
+protected:
+  StaticSeedCell() = default;
+};
+
+std::vector<unsigned long>
+ParseList(const std::string & text)
+{
+  std::vector<unsigned long> values;
+  std::stringstream          stream(text);
+  std::string                item;
+  while (std::getline(stream, item, ','))
+  {
+    values.push_back(std::stoul(item));
+  }
+  return values;
+}
+
+std::vector<std::string>
+ParseNames(const std::string & text)
+{
+  std::vector<std::string> names;
+  std::stringstream        stream(text);
+  std::string              item;
+  while (std::getline(stream, item, ','))
+  {
+    names.push_back(item);
+  }
+  return names;
+}
+
+// Positions of the n points of a jittered square or cubic lattice closest to the origin.
+template <unsigned int VDimension>
+std::vector<itk::Point<double, VDimension>>
+PackedLattice(unsigned long numberOfCells, double spacing, std::mt19937 & generator)
+{
+  using PointType = itk::Point<double, VDimension>;
+
+  // Side of a cube that contains the ball of the colony with some margin.
+  const auto side = static_cast<long>(std::ceil(std::pow(2.0 * numberOfCells, 1.0 / VDimension))) + 2;
+
+  std::vector<PointType> lattice;
+  long                   index[VDimension] = {};
+  for (unsigned int d = 0; d < VDimension; ++d)
+  {
+    index[d] = -side / 2;
+  }
+  while (index[VDimension - 1] < side / 2)
+  {
+    PointType point;
+    for (unsigned int d = 0; d < VDimension; ++d)
+    {
+      point[d] = index[d] * spacing;
+    }
+    lattice.push_back(point);
+
+    unsigned int d = 0;
+    while (++index[d] >= side / 2 && d + 1 < VDimension)
+    {
+      index[d] = -side / 2;
+      ++d;
+    }
+  }
+
+  const auto closer = [](const PointType & a, const PointType & b) {
+    return a.GetVectorFromOrigin().GetSquaredNorm() < b.GetVectorFromOrigin().GetSquaredNorm();
+  };
+  numberOfCells = std::min<unsigned long>(numberOfCells, lattice.size());
+  std::nth_element(lattice.begin(), lattice.begin() + numberOfCells, lattice.end(), closer);
+  lattice.resize(numberOfCells);
+
+  std::uniform_real_distribution<double> jitter(-0.1 * spacing, 0.1 * spacing);
+  for (auto & point : lattice)
+  {
+    for (unsigned int d = 0; d < VDimension; ++d)
+    {
+      point[d] += jitter(generator);
+    }
+  }
+  return lattice;
+}
+
+// Substrate covering the colony. The "uniform" phantom lets the cells grow
+// everywhere, the "disc" phantom only inside a ball slightly larger than the
+// initial colony.
+template <unsigned int VDimension>
+typename itk::bio::CellularAggregate<VDimension>::SubstrateType::Pointer
+CreatePhantom(const std::string & phantom, double colonyRadius, double spacing)
+{
+  using SubstrateType = typename itk::bio::CellularAggregate<VDimension>::SubstrateType;
+
+  const double extent = 1.5 * colonyRadius + 4.0 * spacing;
+  const auto   halfSize = static_cast<itk::SizeValueType>(std::ceil(extent / spacing));
+
+  typename SubstrateType::SizeType    size;
+  typename SubstrateType::SpacingType imageSpacing;
+  typename SubstrateType::PointType   origin;
+  size.Fill(2 * halfSize + 1);
+  imageSpacing.Fill(spacing);
+  origin.Fill(-static_cast<double>(halfSize) * spacing);
+
+  auto substrate = SubstrateType::New();
+  substrate->SetRegions(size);
+  substrate->SetSpacing(imageSpacing);
+  substrate->SetOrigin(origin);
+  substrate->Allocate();
+  substrate->FillBuffer(220.0);
+
+  if (phantom == "disc")
+  {
+    const double                                     limit = 1.25 * colonyRadius;
+    itk::ImageRegionIteratorWithIndex<SubstrateType> it(substrate, substrate->GetBufferedRegion());
+    for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+    {
+      typename SubstrateType::PointType point;
+      substrate->TransformIndexToPhysicalPoint(it.GetIndex(), point);
+      if (point.GetVectorFromOrigin().GetNorm() > limit)
+      {
+        it.Set(0.0);
+      }
+    }
+  }
+  return substrate;
+}
+
+template <typename TFunction>
+void
+TimePhase(const std::string & phase, unsigned int iterations, TFunction && function, BenchmarkRecord record,
+          std::vector<BenchmarkRecord> & records)
+{
+  double minimum = 0.0;
+  double total = 0.0;
+  for (unsigned int i = 0; i < iterations; ++i)
+  {
+    const auto start = ClockType::now();
+    function();
+    const double elapsed = std::chrono::duration<double>(ClockType::now() - start).count();
+    minimum = (i == 0) ? elapsed : std::min(minimum, elapsed);
+    total += elapsed;
+  }
+  record.m_Phase = phase;
+  record.m_Iterations = iterations;
+  record.m_MinimumTime = minimum;
+  record.m_MeanTime = total / iterations;
+  records.push_back(record);
+}
+
+template <unsigned int VDimension, typename TCoordinate>
+double
+RunColonyBenchmark(unsigned long numberOfCells, unsigned int threads, const std::string & phantom,
+                   const BenchmarkOptions & options, std::vector<BenchmarkRecord> & records)
+{
+  using AggregateType = BenchmarkAggregate<VDimension, TCoordinate>;
+  using CellType = typename AggregateType::BioCellType;
+
+  const auto start = ClockType::now();
+
+  itk::MultiThreaderBase::SetGlobalDefaultNumberOfThreads(threads);
+  const unsigned int tiles = options.m_Tiles ? options.m_Tiles : threads;
+
+  constexpr double cellRadius = 1.0;
+
+  CellType::Initialize();
+  CellType::SetDefaultRadius(cellRadius);
+  CellType::SetChemoAttractantLowThreshold(200.0);
+  CellType::SetChemoAttractantHighThreshold(255.0);
+
+  // Neighboring cells slightly overlap and push each other.
+  const double spacing = 1.8 * cellRadius;
+
+  std::mt19937 generator(1234);
+  const auto   positions = PackedLattice<VDimension>(numberOfCells, spacing, generator);
+
+  double colonyRadius = 0.0;
+  for (const auto & position : positions)
+  {
+    colonyRadius = std::max(colonyRadius, position.GetVectorFromOrigin().GetNorm());
+  }
+
+  auto substrate = CreatePhantom<VDimension>(phantom, colonyRadius, spacing);
+
+  auto aggregate = AggregateType::New();
+  aggregate->SetRandomSeed(1234);
+  aggregate->AddSubstrate(substrate);
+
+  for (const auto & position : positions)
+  {
+    typename AggregateType::PointType point;
+    for (unsigned int d = 0; d < VDimension; ++d)
+    {
+      point[d] = position[d];
+    }
+    CellType * cell = options.m_StaticCells ? StaticSeedCell<VDimension, TCoordinate>::CreateSeed()
+                                            : SeedCell<VDimension, TCoordinate>::Create();
+    aggregate->SetEgg(cell, point);
+  }
+
+  const size_t firstRecord = records.size();
+
+  BenchmarkRecord record{};
+  record.m_Dimension = VDimension;
+  record.m_Cells = aggregate->GetNumberOfCells();
+  record.m_Threads = threads;
+  record.m_Tiles = tiles;
+  record.m_Phantom = phantom;
+  record.m_Phase = "Setup";
+  record.m_Iterations = 1;
+  record.m_MinimumTime = std::chrono::duration<double>(ClockType::now() - start).count();
+  record.m_MeanTime = record.m_MinimumTime;
+  records.push_back(record);
+
+  aggregate->SetUseInPlaceMitosis(options.m_InPlaceMitosis);
+  aggregate->SetNumberOfTiles(tiles);
+
+  const unsigned int iterations = options.m_Iterations;
+  if (options.m_ReorderingInterval > 0)
+  {
+    aggregate->SetSpatialReorderingInterval(options.m_ReorderingInterval);
+    TimePhase(
+      "ReorderCellStorage", 1, [&aggregate] { aggregate->ReorderCellStorage(); }, record, records);
+  }
+  TimePhase(
+    "ComputeClosestPoints", iterations, [&aggregate] { aggregate->ComputeClosestPoints(); }, record, records);
+  TimePhase(
+    "ComputeForces", iterations, [&aggregate] { aggregate->ComputeForces(); }, record, records);
+  TimePhase(
+    "AdvanceCellCycles", iterations, [&aggregate] { aggregate->AdvanceCellCycles(); }, record, records);
+  TimePhase(
+    "AdvanceTimeStep", iterations, [&aggregate] { aggregate->AdvanceTimeStep(); }, record, records);
+
+  const unsigned long finalCells = aggregate->GetNumberOfCells();
+  for (size_t i = firstRecord; i < records.size(); ++i)
+  {
+    records[i].m_FinalCells = finalCells;
+  }
+
+  return std::chrono::duration<double>(ClockType::now() - start).count();
+}
+
+template <unsigned int VDimension>
+double
+RunBenchmark(unsigned long numberOfCells, unsigned int threads, const std::string & phantom,
+             const BenchmarkOptions & options, std::vector<BenchmarkRecord> & records)
+{
+  if (options.m_SinglePrecision)
+  {
+    return RunColonyBenchmark<VDimension, float>(numberOfCells, threads, phantom, options, records);
+  }
+  return RunColonyBenchmark<VDimension, double>(numberOfCells, threads, phantom, options, records);
+}
+
+// Quote a string for JSON.
+std::string
+JsonString(const std::string & value)
+{
+  std::ostringstream os;
+  os << '"';
+  for (const char c : value)
+  {
+    if (c == '"' || c == '\\')
+    {
+      os << '\\' << c;
+    }
+    else if (static_cast<unsigned char>(c) < 0x20)
+    {
+      os << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec;
+    }
+    else
+    {
+      os << c;
+    }
+  }
+  os << '"';
+  return os.str();
+}
+
+void
+WriteResults(std::ostream & os, const std::vector<BenchmarkRecord> & records, const BenchmarkOptions & options,
+             bool json)
+{
+  if (json)
+  {
+    os << "{\n  \"benchmark\": \"itkBioCellularAggregateBenchmark\",\n";
+    os << "  \"label\": " << JsonString(options.m_Label) << ",\n";
+#if defined(BioCell_USE_INSTRUMENTATION)
+    os << "  \"instrumentation\": true,\n";
+#else
+    os << "  \"instrumentation\": false,\n";
+#endif
+    os << "  \"results\": [";
+    for (size_t i = 0; i < records.size(); ++i)
+    {
+      const BenchmarkRecord & r = records[i];
+      os << (i ? ",\n" : "\n") << "    { \"dimension\": " << r.m_Dimension << ", \"cells\": " << r.m_Cells
+         << ", \"threads\": " << r.m_Threads << ", \"tiles\": " << r.m_Tiles
+         << ", \"phantom\": " << JsonString(r.m_Phantom) << ", \"phase\": " << JsonString(r.m_Phase)
+         << ", \"iterations\": " << r.m_Iterations << ", \"min_seconds\": " << r.m_MinimumTime
+         << ", \"mean_seconds\": " << r.m_MeanTime << ", \"final_cells\": " << r.m_FinalCells << " }";
+    }
+    os << "\n  ]\n}\n";
+  }
+  else
+  {
+    os << "label,dimension,cells,threads,tiles,phantom,phase,iterations,min_seconds,mean_seconds,final_cells\n";
+    for (const BenchmarkRecord & r : records)
+    {
+      os << options.m_Label << ',' << r.m_Dimension << ',' << r.m_Cells << ',' << r.m_Threads << ',' << r.m_Tiles << ','
+         << r.m_Phantom << ',' << r.m_Phase << ',' << r.m_Iterations << ',' << r.m_MinimumTime << ','
+         << r.m_MeanTime << ',' << r.m_FinalCells << '\n';
+    }
+  }
+}
+
+bool
+ParseOptions(int argc, char * argv[], BenchmarkOptions & options)
+{
+  for (int i = 1; i < argc; ++i)
+  {
+    const std::string option = argv[i];
+    if (i + 1 >= argc)
+    {
+      std::cerr << "Missing value for " << option << std::endl;
+      return false;
+    }
+    const std::string value = argv[++i];
+    if (option == "--sizes")
+    {
+      options.m_Sizes = ParseList(value);
+    }
+    else if (option == "--dimensions")
+    {
+      options.m_Dimensions = ParseList(value);
+    }
+    else if (option == "--threads")
+    {
+      options.m_Threads = ParseList(value);
+    }
+    else if (option == "--phantoms")
+    {
+      options.m_Phantoms = ParseNames(value);
+    }
+    else if (option == "--iterations")
+    {
+      options.m_Iterations = std::max(1, std::atoi(value.c_str()));
+    }
+    else if (option == "--time-limit")
+    {
+      options.m_TimeLimit = std::atof(value.c_str());
+    }
+    else if (option == "--reordering-interval")
+    {
+      options.m_ReorderingInterval = std::stoul(value);
+    }
+    else if (option == "--in-place-mitosis")
+    {
+      options.m_InPlaceMitosis = std::atoi(value.c_str()) != 0;
+    }
+    else if (option == "--tiles")
+    {
+      options.m_Tiles = static_cast<unsigned int>(std::stoul(value));
+    }
+    else if (option == "--single-precision")
+    {
+      options.m_SinglePrecision = std::atoi(value.c_str()) != 0;
+    }
+    else if (option == "--static-cells")
+    {
+      options.m_StaticCells = std::atoi(value.c_str()) != 0;
+    }
+    else if (option == "--label")
+    {
+      options.m_Label = value;
+    }
+    else if (option == "--output")
+    {
+      options.m_OutputFileName = value;
+    }
+    else
+    {
+      std::cerr << "Unknown option " << option << std::endl;
+      return false;
+    }
+  }
+
+  for (const auto dimension : options.m_Dimensions)
+  {
+    if (dimension != 2 && dimension != 3)
+    {
+      std::cerr << "Only 2D and 3D colonies are supported" << std::endl;
+      return false;
+    }
+  }
+  for (const auto & phantom : options.m_Phantoms)
+  {
+    if (phantom != "disc" && phantom != "uniform")
+    {
+      std::cerr << "Unknown phantom " << phantom << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
+
+int
+main(int argc, char * argv[])
+{
+  BenchmarkOptions options;
+  if (!ParseOptions(argc, argv, options))
+  {
+    std::cerr << "Usage: " << argv[0] << " [--sizes n1,n2,...] [--dimensions 2,3] [--threads t1,t2,...]"
+              << " [--phantoms disc,uniform] [--iterations n] [--time-limit seconds] [--reordering-interval n]"
+              << " [--in-place-mitosis 0|1] [--tiles n] [--single-precision 0|1] [--static-cells 0|1]"
+              << " [--label name] [--output results.json|results.csv]" << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (options.m_Threads.empty())
+  {
+    options.m_Threads.push_back(1);
+    const unsigned int maximumThreads = itk::MultiThreaderBase::GetGlobalDefaultNumberOfThreads();
+    if (maximumThreads > 1)
+    {
+      options.m_Threads.push_back(maximumThreads);
+    }
+  }
+  for (const auto threads : options.m_Threads)
+  {
+    if (threads == 0)
+    {
+      std::cerr << "The numbers of threads must be positive" << std::endl;
+      return EXIT_FAILURE;
+    }
+    if (options.m_Tiles == 1 && threads > 1)
+    {
+      std::cerr << "A single tile runs serially, " << threads
+                << " threads need several tiles: omit --tiles to use one tile per thread" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  std::sort(options.m_Sizes.begin(), options.m_Sizes.end());
+
+  std::vector<BenchmarkRecord> records;
+  try
+  {
+    for (const auto dimension : options.m_Dimensions)
+    {
+      for (const auto & phantom : options.m_Phantoms)
+      {
+        for (const auto threads : options.m_Threads)
+        {
+          for (const auto size : options.m_Sizes)
+          {
+            std::cout << dimension << "D, " << size << " cells, "
+                      << threads << " threads, " << phantom
+                      << " phantom" << std::endl;
+
+            const double elapsed =
+              (dimension == 2)
+                ? RunBenchmark<2>(size, static_cast<unsigned int>(threads), phantom, options, records)
+                : RunBenchmark<3>(size, static_cast<unsigned int>(threads), phantom, options, records);
+            if (elapsed > options.m_TimeLimit)
+            {
+              std::cout << "  took " << elapsed << " s, skipping the larger colonies" << std::endl;
+              break;
+            }
+          }
+        }
+      }
+    }
+  }
+  catch (const itk::ExceptionObject & excep)
+  {
+    std::cerr << "Exception caught !" << std::endl;
+    std::cerr << excep << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  WriteResults(std::cout, records, options, false);
+
+  if (!options.m_OutputFileName.empty())
+  {
+    const std::string & fileName = options.m_OutputFileName;
+    const bool          json = fileName.size() >= 5 && fileName.compare(fileName.size() - 5, 5, ".json") == 0;
+
+    std::ofstream output(fileName);
+    if (!output)
+    {
+      std::cerr << "Cannot write " << fileName << std::endl;
+      return EXIT_FAILURE;
+    }
+    WriteResults(output, records, options, json);
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,134 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#include "itkBioCellularAggregateSnapshotWriter.h"
+#include "itkTestingMacros.h"
+
+
+int
+itkBioCellularAggregateSnapshotWriterTest(int argc, char * argv[])
+{
+  if (argc < 3)
+  {
+    std::cerr << "Usage: " << argv[0] << " outputTrajectory outputVTKPattern" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  constexpr unsigned int Dimension = 2;
+  using CellularAggregateType = itk::bio::CellularAggregate<Dimension>;
+  using CellType = CellularAggregateType::BioCellType;
+  using SubstrateType = CellularAggregateType::SubstrateType;
+  using WriterType = itk::bio::CellularAggregateSnapshotWriter<Dimension>;
+
+  CellType::Initialize();
+  CellType::SetChemoAttractantLowThreshold(200.0);
+  CellType::SetChemoAttractantHighThreshold(255.0);
+  CellType::SetGrowthMaximumLatencyTime(5);
+  CellType::SetDivisionMaximumLatencyTime(5);
+  CellType::SetGrowthRadiusIncrement(0.2);
+
+  SubstrateType::IndexType start;
+  start.Fill(-32);
+  SubstrateType::SizeType size;
+  size.Fill(64);
+
+  auto substrate = SubstrateType::New();
+  substrate->SetRegions(SubstrateType::RegionType(start, size));
+  substrate->Allocate();
+  substrate->FillBuffer(220.0);
+
+  auto aggregate = CellularAggregateType::New();
+  aggregate->AddSubstrate(substrate);
+
+  CellularAggregateType::PointType origin;
+  origin.Fill(0.0);
+  aggregate->SetEgg(CellType::CreateEgg(), origin);
+
+  auto trajectoryWriter = WriterType::New();
+  trajectoryWriter->SetFileName(argv[1]);
+  trajectoryWriter->SetSnapshotInterval(10);
+  trajectoryWriter->SetCellularAggregate(aggregate);
+  std::cout << trajectoryWriter << std::endl;
+
+  auto vtkWriter = WriterType::New();
+  vtkWriter->SetFileName(argv[2]);
+  vtkWriter->SetFormat(WriterType::SnapshotFormat::VTKSeries);
+  vtkWriter->SetSnapshotInterval(25);
+  vtkWriter->SetCellularAggregate(aggregate);
+
+  constexpr unsigned int numberOfIterations = 100;
+  for (unsigned int i = 0; i < numberOfIterations; ++i)
+  {
+    aggregate->AdvanceTimeStep();
+  }
+
+  trajectoryWriter->Flush();
+  vtkWriter->Flush();
+
+  if (trajectoryWriter->GetNumberOfSnapshots() != numberOfIterations / 10 ||
+      vtkWriter->GetNumberOfSnapshots() != numberOfIterations / 25)
+  {
+    std::cerr << "Unexpected number of snapshots " << trajectoryWriter->GetNumberOfSnapshots() << " and "
+              << vtkWriter->GetNumberOfSnapshots() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Detaching the writer stops the snapshots.
+  trajectoryWriter->SetCellularAggregate(nullptr);
+  aggregate->AdvanceTimeStep();
+  trajectoryWriter->Flush();
+  if (trajectoryWriter->GetNumberOfSnapshots() != numberOfIterations / 10)
+  {
+    std::cerr << "A detached writer should not take snapshots" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The pattern of a VTK series must hold exactly one integer conversion.
+  auto invalidWriter = WriterType::New();
+  invalidWriter->SetFormat(WriterType::SnapshotFormat::VTKSeries);
+  invalidWriter->SetSnapshotInterval(0);
+  invalidWriter->SetCellularAggregate(aggregate);
+  for (const char * pattern : { "colony.vtk", "colony_%s.vtk", "colony_%d_%d.vtk", "colony_%5.vtk", "colony_%" })
+  {
+    invalidWriter->SetFileName(pattern);
+    ITK_TRY_EXPECT_EXCEPTION(invalidWriter->WriteSnapshot());
+  }
+
+  // The frames that cannot be written are not counted.
+  invalidWriter->SetFileName("/nonexistent/itkBioCellularAggregateSnapshotWriterTest_100%%_%03d.vtk");
+  invalidWriter->WriteSnapshot();
+  ITK_TRY_EXPECT_EXCEPTION(invalidWriter->Flush());
+  ITK_TEST_EXPECT_EQUAL(invalidWriter->GetNumberOfSnapshots(), 0);
+  invalidWriter->SetCellularAggregate(nullptr);
+
+  std::ifstream trajectory(argv[1], std::ios::binary);
+  char          signature[8];
+  trajectory.read(signature, 8);
+  if (!trajectory || std::strncmp(signature, "BIOCTRAJ", 8) != 0)
+  {
+    std::cerr << "Invalid trajectory file " << argv[1] << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test Passed !" << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,169 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include <iostream>
+#include <sstream>
+
+#include "itkBioCellularAggregateSweep.h"
+#include "itkTestingMacros.h"
+#include "vnl/vnl_sample.h"
+
+
+int
+itkBioCellularAggregateSweepTest(int, char *[])
+{
+  constexpr unsigned int Dimension = 2;
+  using SweepType = itk::bio::CellularAggregateSweep<Dimension>;
+  using CellularAggregateType = SweepType::CellularAggregateType;
+  using CellType = SweepType::BioCellType;
+  using SubstrateType = SweepType::SubstrateType;
+
+  CellType::Initialize();
+  CellType::SetGrowthMaximumLatencyTime(5);
+  CellType::SetDivisionMaximumLatencyTime(5);
+  CellType::SetGrowthRadiusIncrement(0.2);
+
+  SubstrateType::IndexType start;
+  start.Fill(-32);
+  SubstrateType::SizeType size;
+  size.Fill(64);
+
+  auto substrate = SubstrateType::New();
+  substrate->SetRegions(SubstrateType::RegionType(start, size));
+  substrate->Allocate();
+  substrate->FillBuffer(220.0);
+
+  auto sweep = SweepType::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(sweep, CellularAggregateSweep, Object);
+
+  sweep->AddSubstrate(substrate);
+  sweep->SetNumberOfWorkUnits(3);
+
+  // Runs differing by their thresholds, radius limit and seed. The last
+  // run repeats the first one.
+  const double lowThresholds[] = { 200.0, 230.0, 200.0, 200.0, 200.0 };
+  const double radiusLimits[] = { 2.0, 2.0, 3.0, 2.0, 2.0 };
+  const unsigned int seeds[] = { 1, 1, 1, 2, 1 };
+  for (unsigned int i = 0; i < 5; ++i)
+  {
+    SweepType::RunParameters run;
+    run.m_Name = "run" + std::to_string(i);
+    run.m_CellParameters = CellType::GetParameters();
+    run.m_CellParameters.m_ChemoAttractantLowThreshold = lowThresholds[i];
+    run.m_CellParameters.m_GrowthRadiusLimit = radiusLimits[i];
+    run.m_RandomSeed = seeds[i];
+    run.m_StoppingCriteria.m_MaximumNumberOfIterations = 60;
+    sweep->AddRun(run);
+  }
+  ITK_TEST_EXPECT_EQUAL(sweep->GetNumberOfRuns(), 5);
+
+  // The parameters of this thread are not those of the runs.
+  CellType::SetChemoAttractantLowThreshold(250.0);
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(sweep->Run());
+
+  ITK_TEST_EXPECT_EQUAL(CellType::GetParameters().m_ChemoAttractantLowThreshold, 250.0);
+
+  const std::vector<SweepType::RunResult> results = sweep->GetResults();
+  ITK_TEST_EXPECT_EQUAL(results.size(), 5);
+  for (const SweepType::RunResult & result : results)
+  {
+    std::cout << result.m_NumberOfCells << " cells, " << result.m_NumberOfMaskPixels << " pixels in "
+              << result.m_ElapsedTime << " s" << std::endl;
+    ITK_TEST_EXPECT_TRUE(result.m_Error.empty());
+    ITK_TEST_EXPECT_EQUAL(result.m_Iteration, 60);
+    ITK_TEST_EXPECT_TRUE(result.m_NumberOfCells > 0);
+    ITK_TEST_EXPECT_TRUE(result.m_CellMask.IsNotNull());
+    ITK_TEST_EXPECT_TRUE(result.m_NumberOfMaskPixels > 0);
+  }
+
+  // The chemo attractant is below the low threshold of the second run, so
+  // that the egg never divides.
+  ITK_TEST_EXPECT_EQUAL(results[1].m_NumberOfCells, 1);
+  ITK_TEST_EXPECT_TRUE(results[0].m_NumberOfCells > 1);
+
+  // Identical settings give identical results, whatever the thread.
+  ITK_TEST_EXPECT_EQUAL(results[4].m_NumberOfCells, results[0].m_NumberOfCells);
+  ITK_TEST_EXPECT_EQUAL(results[4].m_NumberOfMaskPixels, results[0].m_NumberOfMaskPixels);
+
+  // Running the first run in this thread reproduces its result.
+  {
+    CellType::SetParameters(sweep->GetRun(0).m_CellParameters);
+    CellType::ResetCounter();
+    vnl_sample_reseed(static_cast<int>(sweep->GetRun(0).m_RandomSeed));
+
+    auto aggregate = CellularAggregateType::New();
+    aggregate->SetRandomSeed(sweep->GetRun(0).m_RandomSeed);
+    aggregate->AddSubstrate(substrate);
+    CellularAggregateType::PointType origin;
+    origin.Fill(0.0);
+    aggregate->SetEgg(CellType::CreateEgg(), origin);
+    aggregate->Run(sweep->GetRun(0).m_StoppingCriteria);
+    ITK_TEST_EXPECT_EQUAL(aggregate->GetNumberOfCells(), results[0].m_NumberOfCells);
+
+    auto mask = SweepType::MaskImageType::New();
+    mask->SetRegions(substrate->GetLargestPossibleRegion());
+    mask->Allocate(true);
+    aggregate->RasterizeCells(mask.GetPointer(), 1);
+    const SweepType::MaskImageType * sweepMask = results[0].m_CellMask;
+    for (itk::SizeValueType i = 0; i < mask->GetBufferedRegion().GetNumberOfPixels(); ++i)
+    {
+      if (mask->GetBufferPointer()[i] != sweepMask->GetBufferPointer()[i])
+      {
+        std::cerr << "The mask of the sweep differs at pixel " << i << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  // A single worker gives the same results.
+  sweep->SetNumberOfWorkUnits(1);
+  sweep->Run();
+  for (unsigned int i = 0; i < 5; ++i)
+  {
+    ITK_TEST_EXPECT_EQUAL(sweep->GetResults()[i].m_NumberOfCells, results[i].m_NumberOfCells);
+    ITK_TEST_EXPECT_EQUAL(sweep->GetResults()[i].m_NumberOfMaskPixels, results[i].m_NumberOfMaskPixels);
+  }
+
+  std::ostringstream table;
+  sweep->WriteResults(table);
+  std::cout << table.str();
+  std::istringstream lines(table.str());
+  unsigned int       numberOfLines = 0;
+  for (std::string line; std::getline(lines, line);)
+  {
+    ++numberOfLines;
+  }
+  ITK_TEST_EXPECT_EQUAL(numberOfLines, 6);
+
+  // A run without stopping criteria fails, without preventing the others
+  // from completing.
+  SweepType::RunParameters endless;
+  endless.m_Name = "endless";
+  sweep->AddRun(endless);
+  sweep->SetNumberOfWorkUnits(0);
+  ITK_TRY_EXPECT_EXCEPTION(sweep->Run());
+  ITK_TEST_EXPECT_TRUE(!sweep->GetResults()[5].m_Error.empty());
+  ITK_TEST_EXPECT_EQUAL(sweep->GetResults()[0].m_NumberOfCells, results[0].m_NumberOfCells);
+
+  sweep->ClearRuns();
+  ITK_TEST_EXPECT_EQUAL(sweep->GetNumberOfRuns(), 0);
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -16,9 +16,714 @@
  *
  *=========================================================================*/
 
+#include <algorithm>
+#include <cstring>
 #include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
 
 #include "itkBioCellularAggregate.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMath.h"
+#include "vnl/vnl_sample.h"
+
+
+namespace
+{
+using CellularAggregate2DType = itk::bio::CellularAggregate<2>;
+
+// Substrate that allows the cells to grow and divide everywhere.
+CellularAggregate2DType::SubstrateType::Pointer
+CreateSubstrate(float value = 220.0)
+{
+  using SubstrateType = CellularAggregate2DType::SubstrateType;
+
+  SubstrateType::SizeType size;
+  size.Fill(64);
+
+  SubstrateType::IndexType start;
+  start.Fill(-32);
+
+  auto substrate = SubstrateType::New();
+  substrate->SetRegions(SubstrateType::RegionType(start, size));
+  substrate->Allocate();
+  substrate->FillBuffer(value);
+
+  return substrate;
+}
+
+template <typename TAggregate = CellularAggregate2DType>
+typename TAggregate::Pointer
+CreateAggregate(typename TAggregate::SubstrateType * substrate)
+{
+  auto aggregate = TAggregate::New();
+  aggregate->AddSubstrate(substrate);
+  aggregate->SetRandomSeed(1234);
+  return aggregate;
+}
+
+bool
+SameCells(const CellularAggregate2DType * aggregateA, const CellularAggregate2DType * aggregateB)
+{
+  const auto * pointsA = aggregateA->GetMesh()->GetPoints();
+  const auto * pointsB = aggregateB->GetMesh()->GetPoints();
+
+  if (pointsA->Size() != pointsB->Size())
+  {
+    std::cerr << "Different number of cells " << pointsA->Size() << " != " << pointsB->Size() << std::endl;
+    return false;
+  }
+
+  auto pointA = pointsA->Begin();
+  auto pointB = pointsB->Begin();
+  while (pointA != pointsA->End())
+  {
+    if (pointA.Index() != pointB.Index() || pointA.Value() != pointB.Value())
+    {
+      std::cerr << "Cell " << pointA.Index() << " differs from cell " << pointB.Index() << std::endl;
+      return false;
+    }
+    ++pointA;
+    ++pointB;
+  }
+  return true;
+}
+
+// Counts the notifications sent by the cells to the aggregate.
+class CountingAggregate : public CellularAggregate2DType
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(CountingAggregate);
+
+  using Self = CountingAggregate;
+  using Superclass = CellularAggregate2DType;
+  using Pointer = itk::SmartPointer<Self>;
+
+  itkNewMacro(Self);
+
+  using Superclass::Add;
+
+  void
+  Add(itk::bio::CellBase * cellA, itk::bio::CellBase * cellB, double perturbationLength) override
+  {
+    ++m_Adds;
+    Superclass::Add(cellA, cellB, perturbationLength);
+  }
+
+  void
+  Remove(itk::bio::CellBase * cell) override
+  {
+    ++m_Removals;
+    Superclass::Remove(cell);
+  }
+
+  void
+  Divide(itk::bio::CellBase * mother,
+         itk::bio::CellBase * daughterA,
+         itk::bio::CellBase * daughterB,
+         double               perturbationLength) override
+  {
+    ++m_Divisions;
+    Superclass::Divide(mother, daughterA, daughterB, perturbationLength);
+  }
+
+  unsigned int m_Adds{ 0 };
+  unsigned int m_Removals{ 0 };
+  unsigned int m_Divisions{ 0 };
+
+protected:
+  CountingAggregate() = default;
+  ~CountingAggregate() override = default;
+};
+
+// Checks the stopping criteria of CellularAggregate::Run()
+bool
+TestRun()
+{
+  using StoppingCriteria = CellularAggregate2DType::StoppingCriteria;
+  using StopConditionEnum = CellularAggregate2DType::StopConditionEnum;
+
+  CellularAggregate2DType::PointType origin;
+  origin.Fill(0.0);
+
+  auto substrate = CreateSubstrate();
+  auto aggregate = CreateAggregate(substrate);
+  aggregate->SetEgg(CellularAggregate2DType::BioCellType::CreateEgg(), origin);
+
+  unsigned int progressEvents = 0;
+  aggregate->AddObserver(itk::ProgressEvent(), [&progressEvents](const itk::EventObject &) { ++progressEvents; });
+
+  StoppingCriteria criteria;
+  criteria.m_MaximumNumberOfIterations = 25;
+  criteria.m_ProgressStride = 5;
+  if (aggregate->Run(criteria) != StopConditionEnum::MaximumNumberOfIterations || aggregate->GetIteration() != 25 ||
+      progressEvents != 4)
+  {
+    std::cerr << "Run() should stop after 25 iterations with 4 progress events, stopped after "
+              << aggregate->GetIteration() << " with " << progressEvents << std::endl;
+    return false;
+  }
+  std::cout << aggregate->GetStopConditionDescription() << std::endl;
+
+  // Cells do not divide on a substrate below the chemo attractant threshold
+  auto poorSubstrate = CreateSubstrate(100.0);
+  auto starving = CreateAggregate(poorSubstrate);
+  starving->SetEgg(CellularAggregate2DType::BioCellType::CreateEgg(), origin);
+
+  // The number of cells of the starving colony never changes, so it is not
+  // counted as stable
+  criteria = StoppingCriteria();
+  criteria.m_MaximumNumberOfIterations = 50;
+  criteria.m_CellCountStableIterations = 10;
+  if (starving->Run(criteria) != StopConditionEnum::MaximumNumberOfIterations || starving->GetIteration() != 50)
+  {
+    std::cerr << "Run() should not stop before the number of cells changed" << std::endl;
+    return false;
+  }
+
+  // A colony grown from an egg keeps one cell during its first cell cycle,
+  // which is longer than the stable iterations, and only stops once it divided
+  auto growing = CreateAggregate(substrate);
+  growing->SetEgg(CellularAggregate2DType::BioCellType::CreateEgg(), origin);
+
+  criteria = StoppingCriteria();
+  criteria.m_MaximumNumberOfIterations = 2000;
+  criteria.m_CellCountStableIterations = 10;
+  const StopConditionEnum growingStop = growing->Run(criteria);
+  if (growingStop != StopConditionEnum::StableCellCount || growing->GetNumberOfCells() < 2)
+  {
+    std::cerr << "Run() should stop on a stable number of cells after the first division, stopped after "
+              << growing->GetIteration() << " iterations with " << growing->GetNumberOfCells() << " cells"
+              << std::endl;
+    return false;
+  }
+  std::cout << growing->GetStopConditionDescription() << " after " << growing->GetIteration() << " iterations with "
+            << growing->GetNumberOfCells() << " cells" << std::endl;
+
+  criteria = StoppingCriteria();
+  criteria.m_BoundingVolumeStableIterations = 10;
+  if (starving->Run(criteria) != StopConditionEnum::StableBoundingVolume)
+  {
+    std::cerr << "Run() should stop when the bounding volume is stable" << std::endl;
+    return false;
+  }
+
+  criteria = StoppingCriteria();
+  try
+  {
+    starving->Run(criteria);
+    std::cerr << "Run() without stopping criteria should throw" << std::endl;
+    return false;
+  }
+  catch (const itk::ExceptionObject & excep)
+  {
+    std::cout << "Expected exception: " << excep.GetDescription() << std::endl;
+  }
+  return true;
+}
+
+// Grows a colony, starves it by raising the chemo attractant threshold, and
+// lets it grow again, with or without the active set. Returns checkpoints
+// of the starving and of the final colonies.
+template <typename TAggregate = CellularAggregate2DType>
+std::string
+GrowColony(bool useActiveSet, itk::SizeValueType & maximumSleeping, unsigned int numberOfTiles = 1)
+{
+  using CellType = typename TAggregate::BioCellType;
+
+  CellType::ResetCounter();
+  vnl_sample_reseed(5678);
+
+  auto substrate = CreateSubstrate();
+  auto aggregate = CreateAggregate<TAggregate>(substrate);
+  aggregate->SetUseActiveSet(useActiveSet);
+  aggregate->SetNumberOfTiles(numberOfTiles);
+  aggregate->SetTileRebalancingInterval(25);
+
+  typename TAggregate::PointType origin;
+  origin.Fill(0.0);
+  aggregate->SetEgg(CellType::CreateEgg(), origin);
+
+  std::ostringstream checkpoint;
+
+  maximumSleeping = 0;
+  for (unsigned int i = 0; i < 150; ++i)
+  {
+    if (i == 100)
+    {
+      aggregate->WriteCheckpoint(checkpoint);
+    }
+    if (i == 60)
+    {
+      CellType::SetChemoAttractantLowThreshold(230.0);
+    }
+    if (i == 120)
+    {
+      CellType::SetChemoAttractantLowThreshold(200.0);
+      aggregate->WakeUpAllCells();
+    }
+    aggregate->AdvanceTimeStep();
+    maximumSleeping = std::max(maximumSleeping, aggregate->GetNumberOfSleepingCells());
+  }
+
+  aggregate->WriteCheckpoint(checkpoint);
+  return checkpoint.str();
+}
+
+// The active set must not change the result of the simulation.
+bool
+TestActiveSet()
+{
+  itk::SizeValueType sleepingReference = 0;
+  itk::SizeValueType sleeping = 0;
+
+  // Long growth latencies put the starving daughters to sleep until their
+  // timer expires.
+  const itk::SizeValueType growthMaximumLatencyTime =
+    CellularAggregate2DType::BioCellType::GetGrowthMaximumLatencyTime();
+  CellularAggregate2DType::BioCellType::SetGrowthMaximumLatencyTime(10);
+
+  const std::string reference = GrowColony(false, sleepingReference);
+  const std::string active = GrowColony(true, sleeping);
+
+  CellularAggregate2DType::BioCellType::SetGrowthMaximumLatencyTime(growthMaximumLatencyTime);
+
+  std::cout << "At most " << sleeping << " cells asleep" << std::endl;
+
+  if (sleepingReference != 0 || sleeping == 0)
+  {
+    std::cerr << "Cells should only sleep with the active set" << std::endl;
+    return false;
+  }
+  if (reference != active)
+  {
+    std::cerr << "The active set changed the simulation" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+// Rebuilding the storage along the Morton curve must not change the simulation.
+bool
+TestSpatialReordering()
+{
+  using CellType = CellularAggregate2DType::BioCellType;
+
+  std::string checkpoints[2];
+  for (unsigned int reorder = 0; reorder < 2; ++reorder)
+  {
+    CellType::ResetCounter();
+    vnl_sample_reseed(5678);
+
+    auto substrate = CreateSubstrate();
+    auto aggregate = CreateAggregate(substrate);
+    aggregate->SetSpatialReorderingInterval(reorder ? 7 : 0);
+
+    CellularAggregate2DType::PointType origin;
+    origin.Fill(0.0);
+    aggregate->SetEgg(CellType::CreateEgg(), origin);
+
+    for (unsigned int i = 0; i < 100; ++i)
+    {
+      aggregate->AdvanceTimeStep();
+    }
+
+    const auto * mesh = aggregate->GetMesh();
+    if (mesh->GetPoints()->Size() != mesh->GetPointData()->Size() ||
+        mesh->GetPoints()->Size() != mesh->GetCells()->Size())
+    {
+      std::cerr << "The containers of the mesh are inconsistent" << std::endl;
+      return false;
+    }
+
+    std::ostringstream checkpoint;
+    aggregate->WriteCheckpoint(checkpoint);
+    checkpoints[reorder] = checkpoint.str();
+  }
+
+  if (checkpoints[0] != checkpoints[1])
+  {
+    std::cerr << "The spatial reordering changed the simulation" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+// The domain decomposition must not change the result of the simulation.
+bool
+TestTiles()
+{
+  itk::SizeValueType sleepingReference = 0;
+  itk::SizeValueType sleeping = 0;
+
+  const itk::SizeValueType growthMaximumLatencyTime =
+    CellularAggregate2DType::BioCellType::GetGrowthMaximumLatencyTime();
+  CellularAggregate2DType::BioCellType::SetGrowthMaximumLatencyTime(10);
+
+  const std::string reference = GrowColony(true, sleepingReference);
+  const std::string tiled = GrowColony(true, sleeping, 4);
+
+  CellularAggregate2DType::BioCellType::SetGrowthMaximumLatencyTime(growthMaximumLatencyTime);
+
+  if (reference != tiled)
+  {
+    std::cerr << "The tiles changed the simulation" << std::endl;
+    return false;
+  }
+
+  auto aggregate = CellularAggregate2DType::New();
+  aggregate->SetNumberOfTiles(0);
+  if (aggregate->GetNumberOfTiles() != 1)
+  {
+    std::cerr << "There is at least one tile" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+// A colony dividing in place keeps consistent containers, and can be
+// restarted from a checkpoint like with the default division.
+bool
+TestInPlaceMitosis()
+{
+  using CellType = CellularAggregate2DType::BioCellType;
+
+  CellType::ResetCounter();
+  vnl_sample_reseed(2468);
+
+  auto substrate = CreateSubstrate();
+  auto original = CreateAggregate<CountingAggregate>(substrate);
+  original->UseInPlaceMitosisOn();
+
+  CellularAggregate2DType::PointType origin;
+  origin.Fill(0.0);
+  original->SetEgg(CellType::CreateEgg(), origin);
+
+  std::stringstream checkpoint;
+  for (unsigned int i = 0; i < 100; ++i)
+  {
+    if (i == 60)
+    {
+      original->WriteCheckpoint(checkpoint);
+    }
+    original->AdvanceTimeStep();
+  }
+
+  const auto * pointData = original->GetPointData();
+  for (auto cell = pointData->Begin(); cell != pointData->End(); ++cell)
+  {
+    if (cell.Value()->GetSelfIdentifier() != cell.Index() || cell.Value()->MarkedForRemoval())
+    {
+      std::cerr << "Cell " << cell.Index() << " is stored in the wrong slot" << std::endl;
+      return false;
+    }
+  }
+
+  if (original->GetNumberOfCells() < 2 || original->GetPoints()->Size() != pointData->Size() ||
+      original->GetNeighborGraph().GetNumberOfRows() != pointData->Size())
+  {
+    std::cerr << "The containers of the aggregate are inconsistent after in-place divisions" << std::endl;
+    return false;
+  }
+
+  // Each division notifies the aggregate once, with Divide().
+  std::cout << original->m_Divisions << " in-place divisions, " << original->m_Removals << " removals" << std::endl;
+  if (original->m_Divisions == 0 || original->m_Adds != 0 ||
+      original->GetNumberOfCells() != 1 + original->m_Divisions - original->m_Removals)
+  {
+    std::cerr << "The divisions should only call Divide(), once each" << std::endl;
+    return false;
+  }
+
+  auto restored = CreateAggregate(substrate);
+  restored->UseInPlaceMitosisOn();
+  restored->ReadCheckpoint(checkpoint);
+  for (unsigned int i = 60; i < 100; ++i)
+  {
+    restored->AdvanceTimeStep();
+  }
+
+  if (!SameCells(original, restored))
+  {
+    std::cerr << "The restarted in-place simulation diverged from the original one" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+// Gives the tests access to the neighbor search.
+class SearchableAggregate : public CellularAggregate2DType
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(SearchableAggregate);
+
+  using Self = SearchableAggregate;
+  using Superclass = CellularAggregate2DType;
+  using Pointer = itk::SmartPointer<Self>;
+
+  itkNewMacro(Self);
+
+  using Superclass::ComputeClosestPoints;
+
+protected:
+  SearchableAggregate() = default;
+  ~SearchableAggregate() override = default;
+};
+
+// Seeding a disc of a label image builds the same neighbor graph as the
+// neighbor search, and the seeded colony can then be simulated.
+bool
+TestSeeds()
+{
+  using CellType = CellularAggregate2DType::BioCellType;
+  using LabelImageType = itk::Image<unsigned char, 2>;
+
+  CellType::ResetCounter();
+
+  auto                      labels = LabelImageType::New();
+  LabelImageType::IndexType start;
+  start.Fill(-20);
+  LabelImageType::SizeType size;
+  size.Fill(41);
+  labels->SetRegions(LabelImageType::RegionType(start, size));
+  labels->Allocate();
+  labels->FillBuffer(0);
+
+  itk::ImageRegionIteratorWithIndex<LabelImageType> it(labels, labels->GetBufferedRegion());
+  for (; !it.IsAtEnd(); ++it)
+  {
+    const LabelImageType::IndexType index = it.GetIndex();
+    if (index[0] * index[0] + index[1] * index[1] <= 100)
+    {
+      it.Set(3);
+    }
+  }
+
+  auto aggregate = SearchableAggregate::New();
+  aggregate->AddSubstrate(CreateSubstrate());
+  aggregate->SetRandomSeed(1234);
+  aggregate->SetSeeds(labels.GetPointer(), 3);
+
+  // A hexagonal lattice of touching unit cells covers a disc of radius 10
+  // with about 2 * pi * 100 / (4 * sqrt(3)) cells.
+  const itk::SizeValueType numberOfSeeds = aggregate->GetNumberOfCells();
+  if (numberOfSeeds < 80 || numberOfSeeds > 100)
+  {
+    std::cerr << "Wrong number of seeds: " << numberOfSeeds << std::endl;
+    return false;
+  }
+
+  const auto * points = aggregate->GetPoints();
+  for (auto point = points->Begin(); point != points->End(); ++point)
+  {
+    const auto & position = point.Value();
+    if (position[0] * position[0] + position[1] * position[1] > 110.25)
+    {
+      std::cerr << "Seed " << point.Index() << " is out of the label" << std::endl;
+      return false;
+    }
+  }
+
+  std::vector<std::vector<itk::IdentifierType>> seededRows;
+  for (const auto cellId : aggregate->GetNeighborGraph().GetRowIdentifiers())
+  {
+    seededRows.emplace_back(aggregate->GetNeighborGraph().Begin(cellId), aggregate->GetNeighborGraph().End(cellId));
+  }
+
+  aggregate->ComputeClosestPoints();
+
+  std::vector<std::vector<itk::IdentifierType>> searchedRows;
+  for (const auto cellId : aggregate->GetNeighborGraph().GetRowIdentifiers())
+  {
+    searchedRows.emplace_back(aggregate->GetNeighborGraph().Begin(cellId), aggregate->GetNeighborGraph().End(cellId));
+  }
+
+  if (seededRows.size() != numberOfSeeds || seededRows != searchedRows)
+  {
+    std::cerr << "The neighbors of the seeds differ from the neighbor search" << std::endl;
+    return false;
+  }
+
+  for (unsigned int i = 0; i < 10; ++i)
+  {
+    aggregate->AdvanceTimeStep();
+  }
+  if (aggregate->GetNumberOfCells() < numberOfSeeds)
+  {
+    std::cerr << "The seeded colony did not survive" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+// A reset aggregate runs the same simulation as a new one.
+bool
+TestReset()
+{
+  using CellType = CellularAggregate2DType::BioCellType;
+
+  auto aggregate = CellularAggregate2DType::New();
+  aggregate->UseActiveSetOn();
+
+  std::string checkpoints[2];
+  for (unsigned int run = 0; run < 2; ++run)
+  {
+    if (run > 0)
+    {
+      aggregate->Reinitialize({ CreateSubstrate() });
+    }
+    else
+    {
+      aggregate->AddSubstrate(CreateSubstrate());
+    }
+    aggregate->SetRandomSeed(1234);
+
+    CellType::ResetCounter();
+    vnl_sample_reseed(8642);
+
+    CellularAggregate2DType::PointType origin;
+    origin.Fill(0.0);
+    aggregate->SetEgg(CellType::CreateEgg(), origin);
+
+    for (unsigned int i = 0; i < 80; ++i)
+    {
+      aggregate->AdvanceTimeStep();
+    }
+
+    std::ostringstream checkpoint;
+    aggregate->WriteCheckpoint(checkpoint);
+    checkpoints[run] = checkpoint.str();
+  }
+
+  if (checkpoints[0] != checkpoints[1] || aggregate->GetSubstrates().size() != 1)
+  {
+    std::cerr << "The reset aggregate diverged from the first run" << std::endl;
+    return false;
+  }
+
+  aggregate->Reset();
+  if (aggregate->GetNumberOfCells() != 0 || aggregate->GetIteration() != 0 ||
+      aggregate->GetNeighborGraph().GetNumberOfRows() != 0 || aggregate->GetNumberOfSleepingCells() != 0)
+  {
+    std::cerr << "Reset() left some state in the aggregate" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+// Single precision coordinates follow the same rules, and their
+// checkpoints can be read by a double precision aggregate.
+bool
+TestSinglePrecision()
+{
+  using SinglePrecisionAggregateType = itk::bio::CellularAggregate<2, float>;
+
+  itk::SizeValueType sleeping = 0;
+
+  const std::string reference = GrowColony(true, sleeping);
+  const std::string single = GrowColony<SinglePrecisionAggregateType>(true, sleeping);
+  const std::string tiled = GrowColony<SinglePrecisionAggregateType>(true, sleeping, 4);
+
+  if (single != tiled)
+  {
+    std::cerr << "The tiles changed the single precision simulation" << std::endl;
+    return false;
+  }
+
+  auto referenceAggregate = CellularAggregate2DType::New();
+  auto singleAggregate = SinglePrecisionAggregateType::New();
+  auto restored = CellularAggregate2DType::New();
+  std::istringstream referenceStream(reference);
+  std::istringstream singleStream(single);
+  std::istringstream restoredStream(single);
+  referenceAggregate->ReadCheckpoint(referenceStream);
+  singleAggregate->ReadCheckpoint(singleStream);
+  restored->ReadCheckpoint(restoredStream);
+
+  std::cout << referenceAggregate->GetNumberOfCells() << " cells in double precision, "
+            << singleAggregate->GetNumberOfCells() << " in single precision" << std::endl;
+  if (singleAggregate->GetNumberOfCells() != referenceAggregate->GetNumberOfCells() ||
+      restored->GetNumberOfCells() != singleAggregate->GetNumberOfCells())
+  {
+    std::cerr << "The single precision colony has a different number of cells" << std::endl;
+    return false;
+  }
+
+  auto singlePoint = singleAggregate->GetPoints()->Begin();
+  for (auto point = restored->GetPoints()->Begin(); point != restored->GetPoints()->End(); ++point, ++singlePoint)
+  {
+    for (unsigned int d = 0; d < 2; ++d)
+    {
+      if (point.Value()[d] != static_cast<double>(singlePoint.Value()[d]))
+      {
+        std::cerr << "The checkpoint moved cell " << point.Index() << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// The cell arrays are contiguous copies of the state of the cells.
+bool
+TestCellArrays()
+{
+  using CellType = CellularAggregate2DType::BioCellType;
+
+  CellType::ResetCounter();
+  vnl_sample_reseed(1357);
+
+  auto aggregate = CreateAggregate(CreateSubstrate());
+  aggregate->UseActiveSetOn();
+
+  CellularAggregate2DType::PointType origin;
+  origin.Fill(0.0);
+  aggregate->SetEgg(CellType::CreateEgg(), origin);
+
+  aggregate->AdvanceTimeSteps(60);
+  if (aggregate->GetIteration() != 60)
+  {
+    std::cerr << "AdvanceTimeSteps(60) executed " << aggregate->GetIteration() << " steps" << std::endl;
+    return false;
+  }
+
+  aggregate->UpdateCellArrays();
+  const double * positions = aggregate->GetCellPositionArray();
+  if (aggregate->GetCellArraysLength() != aggregate->GetNumberOfCells() || aggregate->GetNumberOfCells() < 2)
+  {
+    std::cerr << "The cell arrays have " << aggregate->GetCellArraysLength() << " cells instead of "
+              << aggregate->GetNumberOfCells() << std::endl;
+    return false;
+  }
+
+  itk::SizeValueType index = 0;
+  const auto *       pointData = aggregate->GetPointData();
+  auto               cell = pointData->Begin();
+  for (auto point = aggregate->GetPoints()->Begin(); point != aggregate->GetPoints()->End(); ++point, ++cell, ++index)
+  {
+    const CellType::ColorType color = cell.Value()->GetColor();
+    if (aggregate->GetCellIdentifierArray()[index] != point.Index() || positions[2 * index] != point.Value()[0] ||
+        positions[2 * index + 1] != point.Value()[1] ||
+        aggregate->GetCellRadiusArray()[index] != cell.Value()->GetRadius() ||
+        aggregate->GetCellColorArray()[3 * index + 1] != color[1] ||
+        aggregate->GetCellCycleStateArray()[index] != cell.Value()->GetCycleState())
+    {
+      std::cerr << "The cell arrays differ from cell " << point.Index() << std::endl;
+      return false;
+    }
+  }
+
+  // The arrays keep their address while the number of cells does not grow.
+  aggregate->UpdateCellArrays();
+  if (aggregate->GetCellPositionArray() != positions)
+  {
+    std::cerr << "The cell arrays moved" << std::endl;
+    return false;
+  }
+  return true;
+}
+} // namespace
 
 
 int
@@ -29,6 +734,133 @@ itkBioCellularAggregateTest(int, char *[])
   CellularAggregateType::Pointer aggregate = CellularAggregateType::New();
   std::cout << aggregate << std::endl;
 
+  // Checkpoint and restart of a 2D colony
+  using CellType = CellularAggregate2DType::BioCellType;
+
+  CellType::Initialize();
+  CellType::SetChemoAttractantLowThreshold(200.0);
+  CellType::SetChemoAttractantHighThreshold(255.0);
+  CellType::SetGrowthMaximumLatencyTime(5);
+  CellType::SetDivisionMaximumLatencyTime(5);
+  CellType::SetGrowthRadiusIncrement(0.2);
+
+  auto substrate = CreateSubstrate();
+
+  auto original = CreateAggregate(substrate);
+
+  CellularAggregate2DType::PointType origin;
+  origin.Fill(0.0);
+  original->SetEgg(CellType::CreateEgg(), origin);
+
+  for (unsigned int i = 0; i < 60; ++i)
+  {
+    original->AdvanceTimeStep();
+  }
+
+  std::stringstream checkpoint;
+  original->WriteCheckpoint(checkpoint);
+
+  for (unsigned int i = 0; i < 40; ++i)
+  {
+    original->AdvanceTimeStep();
+  }
+  std::cout << "Cells in the original aggregate: " << original->GetNumberOfCells() << std::endl;
+
+  const itk::bio::CellularAggregateStatistics & statistics = original->GetAccumulatedStatistics();
+  statistics.Print(std::cout);
+
+  if (statistics.m_NumberOfIterations != 100 || statistics.m_NumberOfCells != original->GetNumberOfCells())
+  {
+    std::cerr << "Wrong number of iterations or cells in the statistics" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+#if defined(BioCell_USE_INSTRUMENTATION)
+  if (statistics.m_Births == 0 || statistics.m_SubstrateSamples == 0 || statistics.m_NeighborListsRebuilt == 0 ||
+      1 + statistics.m_Births - statistics.m_Deaths != original->GetNumberOfCells())
+  {
+    std::cerr << "Inconsistent births and deaths counters" << std::endl;
+    return EXIT_FAILURE;
+  }
+#endif
+
+  auto restored = CreateAggregate(substrate);
+  restored->SetRandomSeed(4321);
+  restored->ReadCheckpoint(checkpoint);
+
+  for (unsigned int i = 0; i < 40; ++i)
+  {
+    restored->AdvanceTimeStep();
+  }
+
+  if (original->GetNumberOfCells() < 2 || !SameCells(original, restored))
+  {
+    std::cerr << "The restarted simulation diverged from the original one" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::stringstream notACheckpoint("garbage");
+  try
+  {
+    restored->ReadCheckpoint(notACheckpoint);
+    std::cerr << "Reading an invalid checkpoint should throw" << std::endl;
+    return EXIT_FAILURE;
+  }
+  catch (const itk::ExceptionObject & excep)
+  {
+    std::cout << "Expected exception: " << excep.GetDescription() << std::endl;
+  }
+
+  // Corrupted checkpoints are refused and leave the aggregate unchanged.
+  // The header takes 80 bytes, with the numbers of cells and of neighbors
+  // at bytes 24 and 32. It is followed by the records, the neighbor
+  // offsets, the neighbors and the state of the random generator.
+  const std::string valid = checkpoint.str();
+  std::uint64_t     numberOfCells = 0;
+  std::uint64_t     numberOfNeighbors = 0;
+  std::memcpy(&numberOfCells, valid.data() + 24, sizeof(numberOfCells));
+  std::memcpy(&numberOfNeighbors, valid.data() + 32, sizeof(numberOfNeighbors));
+
+  const std::size_t recordSize = sizeof(CellularAggregate2DType::CheckpointCellRecord);
+  const std::size_t offsetsPosition = 80 + numberOfCells * recordSize;
+  const std::size_t randomStatePosition = offsetsPosition + (numberOfCells + 1 + numberOfNeighbors) * 8;
+
+  std::vector<std::string> corrupted(4, valid);
+  const std::uint64_t      hugeCount = std::uint64_t{ 1 } << 60;
+  std::memcpy(&corrupted[0][24], &hugeCount, sizeof(hugeCount));
+  std::memcpy(&corrupted[1][32], &hugeCount, sizeof(hugeCount));
+  const std::uint64_t beyondNeighbors = numberOfNeighbors + 1;
+  std::memcpy(&corrupted[2][offsetsPosition + 8], &beyondNeighbors, sizeof(beyondNeighbors));
+  corrupted[3][randomStatePosition] = 'x';
+
+  const CellularAggregate2DType::RandomGeneratorType randomGenerator = restored->GetRandomGenerator();
+  const unsigned int                                 restoredCells = restored->GetNumberOfCells();
+  for (const std::string & content : corrupted)
+  {
+    std::stringstream stream(content);
+    try
+    {
+      restored->ReadCheckpoint(stream);
+      std::cerr << "Reading a corrupted checkpoint should throw" << std::endl;
+      return EXIT_FAILURE;
+    }
+    catch (const itk::ExceptionObject & excep)
+    {
+      std::cout << "Expected exception: " << excep.GetDescription() << std::endl;
+    }
+  }
+  if (restored->GetNumberOfCells() != restoredCells || restored->GetRandomGenerator() != randomGenerator)
+  {
+    std::cerr << "A corrupted checkpoint modified the aggregate" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if (!TestRun() || !TestActiveSet() || !TestSpatialReordering() || !TestTiles() || !TestInPlaceMitosis() ||
+      !TestSeeds() || !TestReset() || !TestCellArrays() ||
+      !TestSinglePrecision())
+  {
+    return EXIT_FAILURE;
+  }
 
   std::cout << "Test Passed !" << std::endl;
   return EXIT_SUCCESS;
@@ -0,0 +1,298 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include <algorithm>
+#include <iostream>
+
+#include "itkBioCellularAggregate.h"
+#include "itkBioCompactCellularAggregate.h"
+#include "itkTestingMacros.h"
+#include "vnl/vnl_sample.h"
+
+
+namespace
+{
+constexpr unsigned int Dimension = 2;
+using CompactAggregateType = itk::bio::CompactCellularAggregate<Dimension>;
+using ReferenceAggregateType = itk::bio::CellularAggregate<Dimension>;
+using CellType = CompactAggregateType::BioCellType;
+using SubstrateType = CompactAggregateType::SubstrateType;
+
+// Grows a colony from an egg at the origin, with the same draws whatever
+// the type of the aggregate.
+template <typename TAggregate>
+typename TAggregate::Pointer
+GrowColony(SubstrateType * substrate, bool useInPlaceMitosis, unsigned int numberOfSteps)
+{
+  CellType::ResetCounter();
+  vnl_sample_reseed(5678);
+
+  auto aggregate = TAggregate::New();
+  aggregate->AddSubstrate(substrate);
+  aggregate->SetRandomSeed(1234);
+  aggregate->SetUseInPlaceMitosis(useInPlaceMitosis);
+
+  typename TAggregate::PointType origin;
+  origin.Fill(0.0);
+  aggregate->SetEgg(CellType::CreateEgg(), origin);
+
+  for (unsigned int i = 0; i < numberOfSteps; ++i)
+  {
+    aggregate->AdvanceTimeStep();
+  }
+  return aggregate;
+}
+
+// Compares the cells and the neighbor lists of both aggregates.
+bool
+SameCells(const CompactAggregateType * compact, const ReferenceAggregateType * reference)
+{
+  const auto * points = reference->GetPoints();
+  if (compact->GetNumberOfCells() != points->Size())
+  {
+    std::cerr << "Different number of cells " << compact->GetNumberOfCells() << " != " << points->Size() << std::endl;
+    return false;
+  }
+
+  itk::SizeValueType index = 0;
+  for (auto point = points->Begin(); point != points->End(); ++point, ++index)
+  {
+    const CompactAggregateType::MechanicsRecord & record = compact->GetCellMechanics()[index];
+    if (compact->GetCellIdentifiers()[index] != point.Index() || record.m_Position != point.Value() ||
+        compact->GetCells()[index]->GetSelfIdentifier() != point.Index())
+    {
+      std::cerr << "Cell " << compact->GetCellIdentifiers()[index] << " differs from cell " << point.Index()
+                << std::endl;
+      return false;
+    }
+
+    // The records are up to date with the cells after their cycle.
+    const CellType * cell = compact->GetCells()[index];
+    if (record.m_Radius != cell->GetRadius() || record.m_IgnoresForces != cell->IgnoresForces())
+    {
+      std::cerr << "The mechanics of cell " << point.Index() << " are not those of the cell" << std::endl;
+      return false;
+    }
+
+    const itk::bio::NeighborGraph & graphA = compact->GetNeighborGraph();
+    const itk::bio::NeighborGraph & graphB = reference->GetNeighborGraph();
+    if (!std::equal(graphA.Begin(point.Index()),
+                    graphA.End(point.Index()),
+                    graphB.Begin(point.Index()),
+                    graphB.End(point.Index())))
+    {
+      std::cerr << "The neighbors of cell " << point.Index() << " differ" << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
+
+int
+itkBioCompactCellularAggregateTest(int, char *[])
+{
+  CellType::Initialize();
+  CellType::SetChemoAttractantLowThreshold(200.0);
+  CellType::SetChemoAttractantHighThreshold(255.0);
+  CellType::SetGrowthMaximumLatencyTime(5);
+  CellType::SetDivisionMaximumLatencyTime(5);
+  CellType::SetGrowthRadiusIncrement(0.2);
+
+  SubstrateType::IndexType start;
+  start.Fill(-32);
+  SubstrateType::SizeType size;
+  size.Fill(64);
+
+  auto substrate = SubstrateType::New();
+  substrate->SetRegions(SubstrateType::RegionType(start, size));
+  substrate->Allocate();
+  substrate->FillBuffer(220.0);
+
+  {
+    auto aggregate = CompactAggregateType::New();
+    ITK_EXERCISE_BASIC_OBJECT_METHODS(aggregate, CompactCellularAggregate, CellularAggregateBase);
+
+    ITK_TEST_EXPECT_EQUAL(aggregate->GetFrictionForce(), 1.0);
+    aggregate->SetFrictionForce(2.0);
+    ITK_TEST_SET_GET_VALUE(2.0, aggregate->GetFrictionForce());
+    aggregate->SetFrictionForce(1.0);
+
+    ITK_TEST_EXPECT_EQUAL(aggregate->GetClosestPointComputationInterval(), 5);
+    aggregate->SetClosestPointComputationInterval(0);
+    ITK_TEST_SET_GET_VALUE(1, aggregate->GetClosestPointComputationInterval());
+    aggregate->SetClosestPointComputationInterval(5);
+
+    // A second egg with the identifier of a cell of the aggregate is refused.
+    CompactAggregateType::PointType origin;
+    origin.Fill(0.0);
+    aggregate->SetEgg(CellType::CreateEgg(), origin);
+    CellType * egg = CellType::CreateEgg();
+    ITK_TRY_EXPECT_EXCEPTION(aggregate->SetEgg(egg, origin));
+    delete egg;
+    ITK_TEST_EXPECT_EQUAL(aggregate->GetNumberOfCells(), 1);
+  }
+
+  // The compact aggregate reproduces CellularAggregate, with both kinds of
+  // division.
+  for (const bool useInPlaceMitosis : { false, true })
+  {
+    auto reference = GrowColony<ReferenceAggregateType>(substrate, useInPlaceMitosis, 100);
+    auto compact = GrowColony<CompactAggregateType>(substrate, useInPlaceMitosis, 100);
+    std::cout << compact->GetNumberOfCells() << " cells with in-place mitosis "
+              << (useInPlaceMitosis ? "On" : "Off") << std::endl;
+
+    ITK_TEST_EXPECT_TRUE(compact->GetNumberOfCells() > 1);
+    ITK_TEST_EXPECT_EQUAL(compact->GetIteration(), 100);
+    ITK_TEST_EXPECT_EQUAL(compact->GetMaximumDisplacement(), reference->GetMaximumDisplacement());
+    if (!SameCells(compact, reference))
+    {
+      std::cerr << "The compact aggregate diverged from CellularAggregate" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // The mesh built on request matches the mesh of CellularAggregate.
+    const CompactAggregateType::MeshType *   mesh = compact->GetMesh();
+    const ReferenceAggregateType::MeshType * referenceMesh = reference->GetMesh();
+    ITK_TEST_EXPECT_EQUAL(mesh->GetNumberOfPoints(), referenceMesh->GetNumberOfPoints());
+    ITK_TEST_EXPECT_EQUAL(mesh->GetNumberOfCells(), referenceMesh->GetNumberOfCells());
+    for (auto region = referenceMesh->GetCells()->Begin(); region != referenceMesh->GetCells()->End(); ++region)
+    {
+      const auto * compactRegion = mesh->GetCells()->ElementAt(region.Index());
+      ITK_TEST_EXPECT_TRUE(std::equal(compactRegion->PointIdsBegin(),
+                                      compactRegion->PointIdsEnd(),
+                                      region.Value()->PointIdsBegin(),
+                                      region.Value()->PointIdsEnd()));
+    }
+  }
+
+  // After most cells died, the identifiers are too sparse to tabulate the
+  // indices of the cells, and the neighbors are searched in the arrays.
+  {
+    // The aggregates are grown one after the other, since they draw the
+    // identifiers of their cells from the same counter.
+    auto                             reference = GrowColony<ReferenceAggregateType>(substrate, false, 100);
+    std::vector<itk::IdentifierType> removedIdentifiers;
+    itk::SizeValueType               index = 0;
+    for (auto point = reference->GetPoints()->Begin(); point != reference->GetPoints()->End(); ++point, ++index)
+    {
+      if (index % 4 != 0)
+      {
+        removedIdentifiers.push_back(point.Index());
+      }
+    }
+    for (const itk::IdentifierType cellId : removedIdentifiers)
+    {
+      CellType * cell = nullptr;
+      reference->GetMesh()->GetPointData(cellId, &cell);
+      reference->Remove(cell);
+    }
+    reference->AdvanceTimeSteps(20);
+
+    auto compact = GrowColony<CompactAggregateType>(substrate, false, 100);
+    for (const itk::IdentifierType cellId : removedIdentifiers)
+    {
+      const std::vector<itk::IdentifierType> & identifiers = compact->GetCellIdentifiers();
+      const auto found = std::lower_bound(identifiers.begin(), identifiers.end(), cellId);
+      compact->Remove(compact->GetCells()[found - identifiers.begin()]);
+    }
+    const std::vector<itk::IdentifierType> & identifiers = compact->GetCellIdentifiers();
+    ITK_TEST_EXPECT_TRUE(identifiers.back() - identifiers.front() + 1 > 2 * compact->GetNumberOfCells());
+    compact->AdvanceTimeSteps(20);
+
+    std::cout << compact->GetNumberOfCells() << " cells with sparse identifiers" << std::endl;
+    ITK_TEST_EXPECT_EQUAL(compact->GetMaximumDisplacement(), reference->GetMaximumDisplacement());
+    if (!SameCells(compact, reference))
+    {
+      std::cerr << "The compact aggregate diverged from CellularAggregate with sparse identifiers" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  auto aggregate = GrowColony<CompactAggregateType>(substrate, false, 80);
+  const unsigned int numberOfCells = aggregate->GetNumberOfCells();
+
+  // Export on demand.
+  CompactAggregateType::PointSetPointer pointSet = aggregate->ExportPointSet();
+  ITK_TEST_EXPECT_EQUAL(pointSet->GetNumberOfPoints(), numberOfCells);
+  ITK_TEST_EXPECT_EQUAL(pointSet->GetPointData()->Size(), numberOfCells);
+
+  CompactAggregateType::MeshPointer mesh = aggregate->ExportMesh();
+  ITK_TEST_EXPECT_EQUAL(mesh->GetNumberOfPoints(), numberOfCells);
+  ITK_TEST_EXPECT_EQUAL(mesh->GetNumberOfCells(), numberOfCells);
+
+  const itk::IdentifierType firstId = aggregate->GetCellIdentifiers().front();
+  CompactAggregateType::PointType position;
+  ITK_TEST_EXPECT_TRUE(aggregate->GetCellPosition(firstId, position));
+  ITK_TEST_EXPECT_EQUAL(pointSet->GetPoint(firstId), position);
+  CellType * cell = nullptr;
+  ITK_TEST_EXPECT_TRUE(mesh->GetPointData(firstId, &cell));
+  ITK_TEST_EXPECT_EQUAL(cell, aggregate->GetCells().front());
+
+  const CompactAggregateType::MeshType::CellType * region = mesh->GetCells()->ElementAt(firstId);
+  ITK_TEST_EXPECT_EQUAL(region->GetNumberOfPoints(), aggregate->GetNeighborGraph().GetNumberOfNeighbors(firstId));
+
+  ITK_TEST_EXPECT_EQUAL(aggregate->GetSubstrateValue(firstId, 0), 220.0);
+
+  // The forces are only held by the records.
+  for (const CellType * colonyCell : aggregate->GetCells())
+  {
+    ITK_TEST_EXPECT_EQUAL(colonyCell->GetForce().GetNorm(), 0.0);
+  }
+
+  // Removing a cell outside of the time step drops it from the arrays and
+  // from the neighbor lists.
+  aggregate->Remove(aggregate->GetCells().front());
+  ITK_TEST_EXPECT_EQUAL(aggregate->GetNumberOfCells(), numberOfCells - 1);
+  ITK_TEST_EXPECT_EQUAL(aggregate->GetCells().size(), numberOfCells - 1);
+  ITK_TEST_EXPECT_TRUE(!aggregate->GetCellPosition(firstId, position));
+  ITK_TEST_EXPECT_TRUE(!aggregate->GetNeighborGraph().HasRow(firstId));
+  for (const itk::IdentifierType cellId : aggregate->GetCellIdentifiers())
+  {
+    const itk::bio::NeighborGraph & graph = aggregate->GetNeighborGraph();
+    ITK_TEST_EXPECT_TRUE(std::find(graph.Begin(cellId), graph.End(cellId), firstId) == graph.End(cellId));
+  }
+
+  // The mesh is only rebuilt when the aggregate has been modified.
+  const CompactAggregateType::MeshType * lazyMesh = aggregate->GetMesh();
+  const itk::ModifiedTimeType            pointsTime = lazyMesh->GetPoints()->GetMTime();
+  const itk::ModifiedTimeType            regionsTime = lazyMesh->GetCells()->GetMTime();
+  ITK_TEST_EXPECT_EQUAL(lazyMesh->GetNumberOfPoints(), numberOfCells - 1);
+  ITK_TEST_EXPECT_EQUAL(aggregate->GetMesh(), lazyMesh);
+  ITK_TEST_EXPECT_EQUAL(lazyMesh->GetPoints()->GetMTime(), pointsTime);
+  ITK_TEST_EXPECT_EQUAL(lazyMesh->GetCells()->GetMTime(), regionsTime);
+
+  aggregate->AdvanceTimeSteps(5);
+  ITK_TEST_EXPECT_EQUAL(aggregate->GetIteration(), 85);
+  ITK_TEST_EXPECT_EQUAL(lazyMesh->GetPoints()->GetMTime(), pointsTime);
+
+  ITK_TEST_EXPECT_EQUAL(aggregate->GetMesh(), lazyMesh);
+  ITK_TEST_EXPECT_EQUAL(lazyMesh->GetNumberOfPoints(), aggregate->GetNumberOfCells());
+  for (itk::SizeValueType i = 0; i < aggregate->GetCells().size(); ++i)
+  {
+    ITK_TEST_EXPECT_EQUAL(lazyMesh->GetPoint(aggregate->GetCellIdentifiers()[i]),
+                          aggregate->GetCellMechanics()[i].m_Position);
+  }
+
+  aggregate->KillAll();
+  ITK_TEST_EXPECT_EQUAL(aggregate->GetNumberOfCells(), 0);
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
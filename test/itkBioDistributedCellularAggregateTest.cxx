@@ -0,0 +1,220 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include <cstdlib>
+#include <cstdio>
+#include <iostream>
+#include <string>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "itkBioDistributedCellularAggregate.h"
+#include "itkBioUnixSocketTransport.h"
+#include "itkTestingMacros.h"
+#include "vnl/vnl_sample.h"
+
+
+namespace
+{
+constexpr unsigned int Dimension = 2;
+using AggregateType = itk::bio::DistributedCellularAggregate<Dimension>;
+using CellType = AggregateType::BioCellType;
+using SubstrateType = AggregateType::SubstrateType;
+
+SubstrateType::Pointer
+CreateSubstrate()
+{
+  SubstrateType::IndexType start;
+  start.Fill(-32);
+  SubstrateType::SizeType size;
+  size.Fill(64);
+
+  auto substrate = SubstrateType::New();
+  substrate->SetRegions(SubstrateType::RegionType(start, size));
+  substrate->Allocate();
+  substrate->FillBuffer(220.0);
+  return substrate;
+}
+
+// Simulates one rank of a colony growing across the boundary between the
+// two slabs.
+int
+RunRank(const std::string & directory, unsigned int rank)
+{
+  constexpr unsigned int numberOfRanks = 2;
+
+  CellType::Initialize();
+  CellType::SetGrowthMaximumLatencyTime(5);
+  CellType::SetDivisionMaximumLatencyTime(5);
+  CellType::SetGrowthRadiusIncrement(0.2);
+  vnl_sample_reseed(1234);
+
+  auto substrate = CreateSubstrate();
+
+  auto transport = itk::bio::UnixSocketTransport::New();
+  transport->Open(directory, rank, numberOfRanks);
+
+  auto aggregate = AggregateType::New();
+  aggregate->SetTransport(transport);
+  aggregate->AddSubstrate(substrate);
+  aggregate->SetRandomSeed(1234 + rank);
+
+  if (rank == 0)
+  {
+    AggregateType::PointType position;
+    position.Fill(0.0);
+    position[0] = -3.0;
+    aggregate->SetEgg(CellType::CreateEgg(), position);
+  }
+
+  itk::SizeValueType maximumNumberOfHaloCells = 0;
+  for (unsigned int i = 0; i < 80; ++i)
+  {
+    aggregate->AdvanceTimeStep();
+    maximumNumberOfHaloCells = std::max(maximumNumberOfHaloCells, aggregate->GetNumberOfHaloCells());
+  }
+
+  // The extent of the substrate is split in its middle.
+  if (aggregate->GetSlabBoundaries().size() != 1 || aggregate->GetSlabBoundaries()[0] != -0.5)
+  {
+    std::cerr << "Rank " << rank << ": wrong slab boundaries" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The cells moved during the last step at most.
+  const double tolerance = CellType::GetGrowthRadiusLimit();
+  for (auto point = aggregate->GetPoints()->Begin(); point != aggregate->GetPoints()->End(); ++point)
+  {
+    const double coordinate = point.Value()[0];
+    if ((rank == 0 && coordinate > -0.5 + tolerance) || (rank == 1 && coordinate < -0.5 - tolerance))
+    {
+      std::cerr << "Rank " << rank << ": cell " << point.Index() << " is out of the slab" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  const itk::SizeValueType numberOfCells = aggregate->GetGlobalNumberOfCells();
+  const itk::SizeValueType emigrated = transport->AllReduceSum(aggregate->GetNumberOfEmigratedCells());
+  const itk::SizeValueType immigrated = transport->AllReduceSum(aggregate->GetNumberOfImmigratedCells());
+  std::cout << "Rank " << rank << ": " << aggregate->GetNumberOfCells() << " of " << numberOfCells << " cells, "
+            << aggregate->GetNumberOfImmigratedCells() << " immigrated, at most " << maximumNumberOfHaloCells
+            << " halo cells" << std::endl;
+
+  if (numberOfCells < 10 || aggregate->GetNumberOfCells() == 0 || emigrated == 0 || emigrated != immigrated ||
+      maximumNumberOfHaloCells == 0)
+  {
+    std::cerr << "Rank " << rank << ": the colony did not grow across the slabs" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Each rank writes a checkpoint of its cells, which a CellularAggregate
+  // can read.
+  const std::string fileName = directory + "/rank" + std::to_string(rank) + ".checkpoint";
+  aggregate->WriteCheckpoint(fileName);
+
+  auto restored = itk::bio::CellularAggregate<Dimension>::New();
+  restored->ReadCheckpoint(fileName);
+  std::remove(fileName.c_str());
+  if (restored->GetNumberOfCells() != aggregate->GetNumberOfCells())
+  {
+    std::cerr << "Rank " << rank << ": wrong checkpoint" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  transport->Barrier();
+  return EXIT_SUCCESS;
+}
+} // namespace
+
+
+int
+itkBioDistributedCellularAggregateTest(int argc, char * argv[])
+{
+  // The second rank runs this test again in a new process of the test
+  // driver.
+  if (argc > 2)
+  {
+    try
+    {
+      return RunRank(argv[1], static_cast<unsigned int>(std::atoi(argv[2])));
+    }
+    catch (const itk::ExceptionObject & exception)
+    {
+      std::cerr << "Rank " << argv[2] << ": " << exception << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  if (argc < 2)
+  {
+    std::cerr << "Usage: " << argv[0] << " TestDriver" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  char directory[] = "/tmp/itkBioDistributedCellularAggregateTestXXXXXX";
+  if (!mkdtemp(directory))
+  {
+    std::cerr << "Cannot create a temporary directory" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  const pid_t child = fork();
+  if (child == 0)
+  {
+    execl(argv[1], argv[1], argv[0], directory, "1", static_cast<char *>(nullptr));
+    _exit(EXIT_FAILURE);
+  }
+
+  int status = EXIT_FAILURE;
+  try
+  {
+    status = RunRank(directory, 0);
+  }
+  catch (const itk::ExceptionObject & exception)
+  {
+    std::cerr << "Rank 0: " << exception << std::endl;
+  }
+
+  int childStatus = 0;
+  if (waitpid(child, &childStatus, 0) != child || !WIFEXITED(childStatus) || WEXITSTATUS(childStatus) != 0)
+  {
+    status = EXIT_FAILURE;
+  }
+  rmdir(directory);
+
+  // A single rank behaves as a CellularAggregate.
+  auto aggregate = AggregateType::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(aggregate, DistributedCellularAggregate, CellularAggregate);
+  ITK_TEST_EXPECT_EQUAL(aggregate->GetRank(), 0);
+  ITK_TEST_EXPECT_EQUAL(aggregate->GetNumberOfRanks(), 1);
+
+  CellType::Initialize();
+  auto substrate = CreateSubstrate();
+  aggregate->AddSubstrate(substrate);
+  AggregateType::PointType origin;
+  origin.Fill(0.0);
+  aggregate->SetEgg(CellType::CreateEgg(), origin);
+  aggregate->AdvanceTimeStep();
+  ITK_TEST_EXPECT_EQUAL(aggregate->GetGlobalNumberOfCells(), aggregate->GetNumberOfCells());
+
+  const std::vector<double> unsorted = { 1.0, 0.0 };
+  ITK_TRY_EXPECT_EXCEPTION(aggregate->SetSlabBoundaries(unsorted));
+
+  std::cout << "Test finished." << std::endl;
+  return status;
+}
@@ -21,6 +21,8 @@
 #include "itkBioGenome.h"
 #include "itkMath.h"
 
+#include <sstream>
+
 
 int
 itkBioGenomeTest(int, char *[])
@@ -93,6 +95,19 @@ itkBioGenomeTest(int, char *[])
     return EXIT_FAILURE;
   }
 
+  std::stringstream buffer;
+  genome.WriteBinary(buffer);
+
+  itk::bio::Genome genome3;
+  genome3.ReadBinary(buffer);
+
+  if (itk::Math::NotExactlyEquals(genome.GetExpressionLevel("Tubulin"), genome3.GetExpressionLevel("Tubulin")) ||
+      itk::Math::NotExactlyEquals(genome.GetExpressionLevel("Cyclin"), genome3.GetExpressionLevel("Cyclin")))
+  {
+    std::cerr << "Error in WriteBinary()/ReadBinary()" << std::endl;
+    return EXIT_FAILURE;
+  }
+
   std::cout << "Test Passed !" << std::endl;
   return EXIT_SUCCESS;
 }
@@ -0,0 +1,96 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include <iostream>
+#include <utility>
+#include <vector>
+
+#include "itkBioInlineNeighborList.h"
+
+
+int
+itkBioInlineNeighborListTest(int, char *[])
+{
+  using ListType = itk::bio::InlineNeighborList<4>;
+  using VectorType = std::vector<itk::IdentifierType>;
+
+  ListType list;
+  for (itk::IdentifierType id = 1; id <= 4; ++id)
+  {
+    list.PushBack(id);
+  }
+
+  if (!list.IsInline() || list.Size() != 4 || list.Capacity() != 4 || list[2] != 3)
+  {
+    std::cerr << "A full list should stay in the inline storage" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Overflowing moves all the identifiers to the heap, in order
+  list.PushBack(5);
+  list.PushBack(6);
+  if (list.IsInline() || VectorType(list.begin(), list.end()) != VectorType{ 1, 2, 3, 4, 5, 6 })
+  {
+    std::cerr << "Overflow failed" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if (!list.Erase(3) || list.Erase(9) || list.Contains(3) || !list.Contains(6) ||
+      VectorType(list.begin(), list.end()) != VectorType{ 1, 2, 4, 5, 6 })
+  {
+    std::cerr << "Erase() failed on the heap" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Copies of a short list are inline, whatever the storage of the source
+  list.Erase(1);
+  list.Erase(2);
+  const ListType copy(list);
+  if (!copy.IsInline() || VectorType(copy.begin(), copy.end()) != VectorType{ 4, 5, 6 })
+  {
+    std::cerr << "Copy failed" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  ListType moved(std::move(list));
+  if (moved.IsInline() || moved.Size() != 3 || !list.Empty() || !list.IsInline())
+  {
+    std::cerr << "Move failed" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  const VectorType row = { 7, 8, 9 };
+  ListType         assigned(row.begin(), row.end());
+  assigned.Erase(7);
+  if (!assigned.IsInline() || VectorType(assigned.begin(), assigned.end()) != VectorType{ 8, 9 })
+  {
+    std::cerr << "Erase() failed inline" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  assigned = moved;
+  assigned.Clear();
+  if (!assigned.Empty() || moved.Size() != 3)
+  {
+    std::cerr << "Clear() failed" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test Passed !" << std::endl;
+  return EXIT_SUCCESS;
+}
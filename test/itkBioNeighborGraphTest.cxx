@@ -0,0 +1,124 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include <iostream>
+#include <vector>
+
+#include "itkBioNeighborGraph.h"
+
+namespace
+{
+std::vector<itk::IdentifierType>
+GetRow(const itk::bio::NeighborGraph & graph, itk::IdentifierType cellId)
+{
+  return std::vector<itk::IdentifierType>(graph.Begin(cellId), graph.End(cellId));
+}
+} // namespace
+
+
+int
+itkBioNeighborGraphTest(int, char *[])
+{
+  using RowType = std::vector<itk::IdentifierType>;
+
+  itk::bio::NeighborGraph graph;
+
+  // Bulk construction
+  graph.Reserve(3, 6);
+  graph.BeginRow(0);
+  graph.PushBack(1);
+  graph.PushBack(2);
+  graph.BeginRow(1);
+  graph.PushBack(0);
+  graph.BeginRow(2);
+  graph.PushBack(0);
+  graph.PushBack(1);
+
+  if (graph.GetNumberOfRows() != 3 || graph.GetNumberOfEntries() != 5 || GetRow(graph, 0) != RowType{ 1, 2 } ||
+      GetRow(graph, 2) != RowType{ 0, 1 })
+  {
+    std::cerr << "Wrong rows after the bulk construction" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if (graph.HasRow(7) || graph.Begin(7) != graph.End(7) || graph.GetNumberOfNeighbors(7) != 0)
+  {
+    std::cerr << "A missing row should be empty" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Incremental modifications keep the order of the neighbors
+  const itk::SizeValueType timeStamp = graph.GetTimeStamp();
+  graph.AddNeighbor(1, 2);
+  graph.AddNeighbor(1, 5);
+  graph.AddNeighbor(1, 4);
+  if (GetRow(graph, 1) != RowType{ 0, 2, 5, 4 } || graph.GetTimeStamp() == timeStamp)
+  {
+    std::cerr << "AddNeighbor() failed" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if (graph.AddNeighbor(9, 1))
+  {
+    std::cerr << "AddNeighbor() should fail on a missing row" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  graph.RemoveNeighbor(1, 2);
+  graph.RemoveNeighbor(1, 8);
+  if (GetRow(graph, 1) != RowType{ 0, 5, 4 })
+  {
+    std::cerr << "RemoveNeighbor() failed" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  graph.CopyRow(5, 1);
+  graph.AddNeighbor(5, 1);
+  if (GetRow(graph, 5) != RowType{ 0, 5, 4, 1 } || GetRow(graph, 1) != RowType{ 0, 5, 4 })
+  {
+    std::cerr << "CopyRow() failed" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  graph.RemoveRow(0);
+  if (graph.HasRow(0) || graph.GetNumberOfRows() != 3 || graph.GetRowIdentifiers() != RowType{ 1, 2, 5 })
+  {
+    std::cerr << "RemoveRow() failed" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Compaction in a given order removes the holes without changing the rows
+  graph.Compact({ 5, 2 });
+  if (graph.GetStorageSize() != graph.GetNumberOfEntries() || graph.GetNumberOfEntries() != 9 ||
+      graph.Begin(5) != graph.Begin(2) - 4 || graph.Begin(1) != graph.End(2) || GetRow(graph, 1) != RowType{ 0, 5, 4 } ||
+      GetRow(graph, 2) != RowType{ 0, 1 } || GetRow(graph, 5) != RowType{ 0, 5, 4, 1 })
+  {
+    std::cerr << "Compact() failed" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  graph.Clear();
+  if (graph.GetNumberOfRows() != 0 || graph.GetNumberOfEntries() != 0 || graph.HasRow(1))
+  {
+    std::cerr << "Clear() should remove all the rows" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test Passed !" << std::endl;
+  return EXIT_SUCCESS;
+}
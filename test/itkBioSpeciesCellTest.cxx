@@ -0,0 +1,197 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include <iostream>
+#include <string>
+
+#include "itkBioCellularAggregate.h"
+#include "itkBioSpeciesCell.h"
+#include "itkTestingMacros.h"
+#include "vnl/vnl_sample.h"
+
+
+namespace
+{
+constexpr unsigned int Dimension = 2;
+using CellularAggregateType = itk::bio::CellularAggregate<Dimension>;
+using CellType = CellularAggregateType::BioCellType;
+
+// Species keeping all the hooks of Cell.
+class PlainCell final : public itk::bio::SpeciesCell<PlainCell, Dimension>
+{
+  friend class itk::bio::SpeciesCell<PlainCell, Dimension>;
+
+protected:
+  PlainCell() = default;
+};
+
+// Species growing twice as fast as Cell.
+class FastGrowingCell final : public itk::bio::SpeciesCell<FastGrowingCell, Dimension>
+{
+public:
+  using Superclass = itk::bio::SpeciesCell<FastGrowingCell, Dimension>;
+
+  static const char *
+  GetSpeciesName()
+  {
+    return "Fast Growing Cell";
+  }
+
+protected:
+  friend Superclass;
+
+  FastGrowingCell() = default;
+
+  void
+  Grow() override
+  {
+    Superclass::Grow();
+    Superclass::Grow();
+  }
+};
+
+// Grows a colony from an egg at the origin.
+CellularAggregateType::Pointer
+GrowColony(CellType * egg, bool useInPlaceMitosis, unsigned int numberOfSteps)
+{
+  CellularAggregateType::SubstrateType::IndexType start;
+  start.Fill(-32);
+  CellularAggregateType::SubstrateType::SizeType size;
+  size.Fill(64);
+
+  auto substrate = CellularAggregateType::SubstrateType::New();
+  substrate->SetRegions(CellularAggregateType::SubstrateType::RegionType(start, size));
+  substrate->Allocate();
+  substrate->FillBuffer(220.0);
+
+  auto aggregate = CellularAggregateType::New();
+  aggregate->AddSubstrate(substrate);
+  aggregate->SetRandomSeed(1234);
+  aggregate->SetUseInPlaceMitosis(useInPlaceMitosis);
+
+  CellularAggregateType::PointType origin;
+  origin.Fill(0.0);
+  aggregate->SetEgg(egg, origin);
+
+  for (unsigned int i = 0; i < numberOfSteps; ++i)
+  {
+    aggregate->AdvanceTimeStep();
+  }
+  return aggregate;
+}
+
+// Checks that both aggregates hold the same cells at the same positions.
+bool
+SameCells(const CellularAggregateType * aggregateA, const CellularAggregateType * aggregateB)
+{
+  const auto * pointsA = aggregateA->GetPoints();
+  const auto * pointsB = aggregateB->GetPoints();
+  if (pointsA->Size() != pointsB->Size())
+  {
+    std::cerr << "Different number of cells " << pointsA->Size() << " != " << pointsB->Size() << std::endl;
+    return false;
+  }
+
+  auto pointB = pointsB->Begin();
+  for (auto pointA = pointsA->Begin(); pointA != pointsA->End(); ++pointA, ++pointB)
+  {
+    if (pointA.Index() != pointB.Index() || pointA.Value() != pointB.Value())
+    {
+      std::cerr << "Cell " << pointA.Index() << " differs from cell " << pointB.Index() << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+// Checks that all the cells of the aggregate are of the given species.
+template <typename TSpecies>
+bool
+AllCellsOfSpecies(const CellularAggregateType * aggregate)
+{
+  const auto * cells = aggregate->GetPointData();
+  for (auto cell = cells->Begin(); cell != cells->End(); ++cell)
+  {
+    if (dynamic_cast<const TSpecies *>(cell.Value()) == nullptr)
+    {
+      std::cerr << "Cell " << cell.Index() << " is not a " << TSpecies::GetSpeciesName() << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
+
+int
+itkBioSpeciesCellTest(int, char *[])
+{
+  CellType::Initialize();
+  CellType::SetChemoAttractantLowThreshold(200.0);
+  CellType::SetChemoAttractantHighThreshold(255.0);
+  CellType::SetGrowthMaximumLatencyTime(5);
+  CellType::SetDivisionMaximumLatencyTime(5);
+  CellType::SetGrowthRadiusIncrement(0.2);
+
+  ITK_TEST_EXPECT_EQUAL(std::string(PlainCell::GetSpeciesName()), std::string(CellType::GetSpeciesName()));
+
+  // A species keeping the hooks of Cell simulates the same colony, with
+  // both kinds of division, and its daughters belong to the species.
+  for (const bool useInPlaceMitosis : { false, true })
+  {
+    CellType::ResetCounter();
+    vnl_sample_reseed(5678);
+    auto reference = GrowColony(CellType::CreateEgg(), useInPlaceMitosis, 100);
+
+    CellType::ResetCounter();
+    vnl_sample_reseed(5678);
+    auto species = GrowColony(PlainCell::CreateEgg(), useInPlaceMitosis, 100);
+
+    std::cout << species->GetNumberOfCells() << " cells with in-place mitosis "
+              << (useInPlaceMitosis ? "On" : "Off") << std::endl;
+    ITK_TEST_EXPECT_TRUE(species->GetNumberOfCells() > 1);
+    if (!SameCells(reference, species) || !AllCellsOfSpecies<PlainCell>(species))
+    {
+      std::cerr << "The species diverged from Cell" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // The hooks of the species are called by the time step.
+  CellType::ResetCounter();
+  vnl_sample_reseed(5678);
+  auto reference = GrowColony(CellType::CreateEgg(), false, 60);
+
+  CellType::ResetCounter();
+  vnl_sample_reseed(5678);
+  auto fast = GrowColony(FastGrowingCell::CreateEgg(), false, 60);
+
+  std::cout << fast->GetNumberOfCells() << " fast growing cells, " << reference->GetNumberOfCells() << " cells"
+            << std::endl;
+  ITK_TEST_EXPECT_TRUE(AllCellsOfSpecies<FastGrowingCell>(fast));
+  ITK_TEST_EXPECT_TRUE(fast->GetNumberOfCells() > reference->GetNumberOfCells());
+
+  // The seeds belong to the species as well.
+  FastGrowingCell * seed = FastGrowingCell::CreateSeed();
+  ITK_TEST_EXPECT_EQUAL(seed->GetParentIdentifier(), 0);
+  ITK_TEST_EXPECT_EQUAL(seed->GetCycleState(), CellType::Gap1);
+  delete seed;
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
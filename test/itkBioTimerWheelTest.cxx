@@ -0,0 +1,106 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+#include "itkBioTimerWheel.h"
+
+
+int
+itkBioTimerWheelTest(int, char *[])
+{
+  itk::bio::TimerWheel wheel(8);
+
+  // Timers beyond one turn of the wheel share the slots of closer ones
+  wheel.Schedule(1, 3);
+  wheel.Schedule(2, 11);
+  wheel.Schedule(3, 3);
+  wheel.Schedule(4, 27);
+  wheel.Schedule(5, 0);
+
+  if (wheel.GetNumberOfTimers() != 5 || wheel.GetNumberOfSlots() != 8)
+  {
+    std::cerr << "Wrong number of timers or slots" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::vector<std::vector<itk::IdentifierType>> expiredAt(30);
+  for (itk::SizeValueType iteration = 0; iteration < 30; ++iteration)
+  {
+    wheel.Expire(iteration, expiredAt[iteration]);
+  }
+
+  const std::vector<itk::IdentifierType> expected3 = { 1, 3 };
+  if (expiredAt[0] != std::vector<itk::IdentifierType>{ 5 } || expiredAt[3] != expected3 ||
+      expiredAt[11] != std::vector<itk::IdentifierType>{ 2 } || expiredAt[27] != std::vector<itk::IdentifierType>{ 4 })
+  {
+    std::cerr << "Timers expired at the wrong iteration" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  itk::SizeValueType numberOfExpired = 0;
+  for (const auto & expired : expiredAt)
+  {
+    numberOfExpired += expired.size();
+  }
+  if (numberOfExpired != 5 || wheel.GetNumberOfTimers() != 0)
+  {
+    std::cerr << "Each timer should expire exactly once" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // A timer scheduled in the past, in the slot 4, expires at the next call,
+  // in the slot 6.
+  std::vector<itk::IdentifierType> expired;
+  wheel.Schedule(6, 20);
+  wheel.Expire(30, expired);
+  if (expired != std::vector<itk::IdentifierType>{ 6 })
+  {
+    std::cerr << "Late timer not expired" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // A timer two turns of the wheel ahead only expires at its iteration,
+  // not when the wheel passes its slot before.
+  wheel.Schedule(7, 49);
+  for (itk::SizeValueType iteration = 31; iteration <= 49; ++iteration)
+  {
+    expired.clear();
+    wheel.Expire(iteration, expired);
+    if ((iteration == 49) != (expired == std::vector<itk::IdentifierType>{ 7 }))
+    {
+      std::cerr << "Timer of iteration 49 expired at iteration " << iteration << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  wheel.Schedule(8, 60);
+  wheel.Clear();
+  expired.clear();
+  wheel.Expire(60, expired);
+  if (!expired.empty() || wheel.GetNumberOfTimers() != 0)
+  {
+    std::cerr << "Clear() should remove all the timers" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test Passed !" << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,173 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include <atomic>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+#include "itkBioTraceRecorder.h"
+#include "itkBioCellularAggregate.h"
+
+
+int
+itkBioTraceRecorderTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing Parameters " << std::endl;
+    std::cerr << "Usage: " << argv[0] << " outputTrace.json" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  using TraceRecorder = itk::bio::TraceRecorder;
+
+  // A disabled recorder does not record anything
+  {
+    const TraceRecorder::Span span("Disabled", "Test");
+  }
+  if (TraceRecorder::GetNumberOfEvents() != 0)
+  {
+    std::cerr << "Spans recorded while the recorder is disabled" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Only the most recent events are kept
+  TraceRecorder::SetBufferSize(8);
+  TraceRecorder::SetEnabled(true);
+  TraceRecorder::SetThreadName("Main");
+  for (unsigned int i = 0; i < 20; ++i)
+  {
+    const TraceRecorder::Span span("Wrapped", "Test");
+  }
+  if (TraceRecorder::GetNumberOfEvents() != 8)
+  {
+    std::cerr << "Expected 8 events, got " << TraceRecorder::GetNumberOfEvents() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  TraceRecorder::SetBufferSize(1024);
+  TraceRecorder::Clear();
+
+  // Spans of the simulation loop and of another thread
+  using CellularAggregateType = itk::bio::CellularAggregate<2>;
+  using CellType = CellularAggregateType::BioCellType;
+
+  using SubstrateType = CellularAggregateType::SubstrateType;
+
+  SubstrateType::SizeType size;
+  size.Fill(32);
+  SubstrateType::IndexType start;
+  start.Fill(-16);
+
+  auto substrate = SubstrateType::New();
+  substrate->SetRegions(SubstrateType::RegionType(start, size));
+  substrate->Allocate();
+  substrate->FillBuffer(220.0);
+
+  // The tiles are processed by the workers of the aggregate.
+  constexpr unsigned int numberOfTiles = 2;
+  constexpr unsigned int numberOfSteps = 10;
+
+  auto aggregate = CellularAggregateType::New();
+  aggregate->AddSubstrate(substrate);
+  aggregate->SetRandomSeed(1234);
+  aggregate->SetNumberOfTiles(numberOfTiles);
+
+  CellularAggregateType::PointType origin;
+  origin.Fill(0.0);
+  aggregate->SetEgg(CellType::CreateEgg(), origin);
+  for (unsigned int i = 0; i < numberOfSteps; ++i)
+  {
+    aggregate->AdvanceTimeStep();
+  }
+
+  std::thread worker([] {
+    TraceRecorder::SetThreadName("Worker \"1\"");
+    const TraceRecorder::Span span("WorkerChunk", "Test");
+  });
+  worker.join();
+
+  // The trace can be written while another thread keeps overwriting the
+  // oldest events of its buffer.
+  {
+    std::atomic<bool> recording{ true };
+    std::thread       writer([&recording] {
+      while (recording)
+      {
+        TraceRecorder::Record("Overwritten", "Test", TraceRecorder::Now(), 0);
+      }
+    });
+    for (unsigned int i = 0; i < 20; ++i)
+    {
+      std::ostringstream concurrentTrace;
+      TraceRecorder::WriteChromeTrace(concurrentTrace);
+      if (concurrentTrace.str().find("\n]}\n") == std::string::npos)
+      {
+        std::cerr << "Incomplete trace written while recording" << std::endl;
+        recording = false;
+        writer.join();
+        return EXIT_FAILURE;
+      }
+    }
+    recording = false;
+    writer.join();
+  }
+
+  TraceRecorder::SetEnabled(false);
+  TraceRecorder::WriteChromeTrace(std::string(argv[1]));
+
+  std::ifstream     input(argv[1]);
+  std::stringstream trace;
+  trace << input.rdbuf();
+  const std::string content = trace.str();
+  std::cout << content.substr(0, 400) << std::endl;
+
+  if (content.find("\"traceEvents\"") == std::string::npos || content.find("\"WorkerChunk\"") == std::string::npos ||
+      content.find("Worker \\\"1\\\"") == std::string::npos || content.find("\"Wrapped\"") != std::string::npos)
+  {
+    std::cerr << "Unexpected content of the trace" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+#if defined(BioCell_USE_TRACING)
+  if (content.find("\"AdvanceTimeStep\"") == std::string::npos || content.find("\"Forces\"") == std::string::npos)
+  {
+    std::cerr << "Missing spans of the simulation loop" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Every worker records the span of the tile it processes.
+  unsigned int tileSpans = 0;
+  for (auto position = content.find("\"ForcesTile\""); position != std::string::npos;
+       position = content.find("\"ForcesTile\"", position + 1))
+  {
+    ++tileSpans;
+  }
+  if (tileSpans != numberOfTiles * numberOfSteps)
+  {
+    std::cerr << "Expected " << numberOfTiles * numberOfSteps << " spans of the tiles, got " << tileSpans
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+#endif
+
+  std::cout << "Test Passed !" << std::endl;
+  return EXIT_SUCCESS;
+}
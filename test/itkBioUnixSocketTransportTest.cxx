@@ -0,0 +1,175 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "itkBioUnixSocketTransport.h"
+#include "itkTestingMacros.h"
+
+
+namespace
+{
+using TransportType = itk::bio::UnixSocketTransport;
+
+// Size of the message sent by a rank to another. Most are larger than the
+// buffers of the sockets, and one is empty.
+size_t
+GetMessageSize(unsigned int source, unsigned int destination)
+{
+  return (source == 0 && destination == 1) ? 0 : 300000 * (source + 1) + destination;
+}
+
+char
+GetMessageByte(unsigned int source, unsigned int destination, size_t i)
+{
+  return static_cast<char>((source * 7 + destination * 13 + i) % 251);
+}
+
+int
+RunRank(const std::string & directory, unsigned int rank, unsigned int numberOfRanks)
+{
+  auto transport = TransportType::New();
+  transport->SetTimeout(30.0);
+  transport->Open(directory, rank, numberOfRanks);
+
+  if (!transport->IsOpen() || transport->GetRank() != rank || transport->GetNumberOfRanks() != numberOfRanks)
+  {
+    std::cerr << "Rank " << rank << ": wrong group" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  TransportType::BufferVector outgoing(numberOfRanks);
+  for (unsigned int destination = 0; destination < numberOfRanks; ++destination)
+  {
+    outgoing[destination].resize(GetMessageSize(rank, destination));
+    for (size_t i = 0; i < outgoing[destination].size(); ++i)
+    {
+      outgoing[destination][i] = GetMessageByte(rank, destination, i);
+    }
+  }
+
+  TransportType::BufferVector incoming;
+  transport->Exchange(outgoing, incoming);
+
+  for (unsigned int source = 0; source < numberOfRanks; ++source)
+  {
+    if (incoming[source].size() != GetMessageSize(source, rank))
+    {
+      std::cerr << "Rank " << rank << ": wrong size of the message of rank " << source << std::endl;
+      return EXIT_FAILURE;
+    }
+    for (size_t i = 0; i < incoming[source].size(); ++i)
+    {
+      if (incoming[source][i] != GetMessageByte(source, rank, i))
+      {
+        std::cerr << "Rank " << rank << ": wrong byte " << i << " in the message of rank " << source << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  if (transport->AllReduceSum(rank + 1) != numberOfRanks * (numberOfRanks + 1) / 2 ||
+      transport->AllReduceMaximum(1.5 * rank) != 1.5 * (numberOfRanks - 1))
+  {
+    std::cerr << "Rank " << rank << ": wrong reduction" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  transport->Barrier();
+  transport->Close();
+  return transport->IsOpen() ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+} // namespace
+
+
+int
+itkBioUnixSocketTransportTest(int, char *[])
+{
+  char directory[] = "/tmp/itkBioUnixSocketTransportTestXXXXXX";
+  if (!mkdtemp(directory))
+  {
+    std::cerr << "Cannot create a temporary directory" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The ranks above zero are child processes.
+  constexpr unsigned int numberOfRanks = 3;
+  std::vector<pid_t>     children;
+  for (unsigned int rank = 1; rank < numberOfRanks; ++rank)
+  {
+    const pid_t child = fork();
+    if (child == 0)
+    {
+      int status = EXIT_FAILURE;
+      try
+      {
+        status = RunRank(directory, rank, numberOfRanks);
+      }
+      catch (const itk::ExceptionObject & exception)
+      {
+        std::cerr << "Rank " << rank << ": " << exception << std::endl;
+      }
+      _exit(status);
+    }
+    children.push_back(child);
+  }
+
+  int status = EXIT_FAILURE;
+  try
+  {
+    status = RunRank(directory, 0, numberOfRanks);
+  }
+  catch (const itk::ExceptionObject & exception)
+  {
+    std::cerr << "Rank 0: " << exception << std::endl;
+  }
+
+  for (const pid_t child : children)
+  {
+    int childStatus = 0;
+    if (waitpid(child, &childStatus, 0) != child || !WIFEXITED(childStatus) || WEXITSTATUS(childStatus) != 0)
+    {
+      status = EXIT_FAILURE;
+    }
+  }
+
+  auto transport = TransportType::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(transport, UnixSocketTransport, Transport);
+
+  ITK_TEST_EXPECT_TRUE(!transport->IsOpen());
+  ITK_TEST_EXPECT_EQUAL(transport->GetNumberOfRanks(), 1);
+
+  TransportType::BufferVector messages(1);
+  ITK_TRY_EXPECT_EXCEPTION(transport->Exchange(messages, messages));
+  ITK_TRY_EXPECT_EXCEPTION(transport->Open(directory, 2, 2));
+
+  // Rank 0 never joins.
+  transport->SetTimeout(0.2);
+  ITK_TRY_EXPECT_EXCEPTION(transport->Open(directory, 1, 2));
+
+  rmdir(directory);
+
+  std::cout << "Test finished." << std::endl;
+  return status;
+}